@@ -33,11 +33,14 @@
 #include <algorithms/bfs.hpp>
 #include <algorithms/cluster.hpp>
 #include <algorithms/cluster_louvain.hpp>
+#include <algorithms/connected_components.hpp>
 #include <algorithms/k_truss.hpp>
+#include <algorithms/kcore.hpp>
 #include <algorithms/maxflow.hpp>
 #include <algorithms/metrics.hpp>
 #include <algorithms/mis.hpp>
 #include <algorithms/mst.hpp>
+#include <algorithms/ordering.hpp>
 #include <algorithms/page_rank.hpp>
 #include <algorithms/sssp.hpp>
 #include <algorithms/triangle_count.hpp>
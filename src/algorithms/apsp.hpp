@@ -27,72 +27,399 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <limits>
+#include <queue>
 #include <tuple>
+#include <type_traits>
+#include <vector>
 
 #include <graphblas/graphblas.hpp>
 
+//****************************************************************************
+namespace
+{
+    //************************************************************************
+    /// Value used for "no path" in the dense distance matrices.
+    template <typename T>
+    constexpr T apsp_infinity()
+    {
+        return std::numeric_limits<T>::has_infinity ?
+            std::numeric_limits<T>::infinity() :
+            std::numeric_limits<T>::max();
+    }
+
+    //************************************************************************
+    /**
+     * dik + dkj for two reachable (non-INF) distances.  Integer sums are
+     * saturated to [lowest, INF] so that long finite paths can neither wrap
+     * around nor be mistaken for a shorter path.
+     */
+    template <typename T>
+    inline T apsp_path_sum(T dik, T dkj)
+    {
+        if constexpr (std::is_integral_v<T>)
+        {
+            T const INF(apsp_infinity<T>());
+            if ((dkj > static_cast<T>(0)) && (dik > INF - dkj)) return INF;
+            if constexpr (std::is_signed_v<T>)
+            {
+                T const LOW(std::numeric_limits<T>::lowest());
+                if ((dkj < static_cast<T>(0)) && (dik < LOW - dkj)) return LOW;
+            }
+        }
+        return dik + dkj;
+    }
+
+    //************************************************************************
+    /**
+     * Default tile edge for the blocked Floyd-Warshall: the largest multiple
+     * of 16 such that three tiles fit in a 256 KiB L2 cache.
+     */
+    template <typename T>
+    grb::IndexType apsp_default_tile_size()
+    {
+        grb::IndexType const L2_BYTES(256*1024);
+        grb::IndexType tile = static_cast<grb::IndexType>(
+            std::sqrt(static_cast<double>(L2_BYTES/(3*sizeof(T)))));
+        return std::max<grb::IndexType>(16, (tile/16)*16);
+    }
+
+    //************************************************************************
+    /**
+     * D(i,j) = min(D(i,j), D(i,k) + D(k,j)) over the tile rows [i0,i1),
+     * cols [j0,j1), with k in [k0,k1) outermost.  Required when the tile
+     * depends on itself (diagonal tile and the tiles in its row/column).
+     */
+    template <typename T>
+    void fw_tile_k_outer(T *D, grb::IndexType n,
+                         grb::IndexType i0, grb::IndexType i1,
+                         grb::IndexType j0, grb::IndexType j1,
+                         grb::IndexType k0, grb::IndexType k1)
+    {
+        T const INF(apsp_infinity<T>());
+        for (grb::IndexType k = k0; k < k1; ++k)
+        {
+            T const *Dk = D + k*n;
+            for (grb::IndexType i = i0; i < i1; ++i)
+            {
+                T *Di = D + i*n;
+                T const dik(Di[k]);
+                if (dik == INF) continue;
+
+                for (grb::IndexType j = j0; j < j1; ++j)
+                {
+                    // INF operands never reach the (saturating) sum
+                    T const cand =
+                        (Dk[j] == INF) ? INF : apsp_path_sum(dik, Dk[j]);
+                    Di[j] = std::min(Di[j], cand);
+                }
+            }
+        }
+    }
+
+    //************************************************************************
+    /**
+     * Same update as fw_tile_k_outer for a tile that does not overlap the
+     * k rows or columns, which allows i-k-j order so the output row of the
+     * tile stays in cache across all k.
+     */
+    template <typename T>
+    void fw_tile_i_outer(T *D, grb::IndexType n,
+                         grb::IndexType i0, grb::IndexType i1,
+                         grb::IndexType j0, grb::IndexType j1,
+                         grb::IndexType k0, grb::IndexType k1)
+    {
+        T const INF(apsp_infinity<T>());
+        for (grb::IndexType i = i0; i < i1; ++i)
+        {
+            T *__restrict Di = D + i*n;
+            for (grb::IndexType k = k0; k < k1; ++k)
+            {
+                T const dik(Di[k]);
+                if (dik == INF) continue;
+
+                T const *__restrict Dk = D + k*n;
+                for (grb::IndexType j = j0; j < j1; ++j)
+                {
+                    T const cand =
+                        (Dk[j] == INF) ? INF : apsp_path_sum(dik, Dk[j]);
+                    Di[j] = std::min(Di[j], cand);
+                }
+            }
+        }
+    }
+}
+
 namespace algorithms
 {
+    //************************************************************************
+    /**
+     * @brief Blocked (tiled) Floyd-Warshall on a dense copy of the graph.
+     *
+     * Given a graph, G = (V,E), with edge weights w and no negative weight
+     * cycles, computes the shortest path distances for all vertex pairs.
+     * For each diagonal tile kk the diagonal tile is closed first, then the
+     * tiles in row kk and column kk, then all remaining tiles, so each
+     * phase touches at most three tiles at a time.
+     *
+     * @param[in]  graph      The adjacency matrix of the graph for which APSP
+     *                        will be computed.  Entries are edge weights.
+     * @param[in]  tile_size  Tile edge length; zero selects a default sized
+     *                        for a 256 KiB L2.
+     * @return                A matrix where entry u,v contains the distance
+     *                        of the shortest path from vertex u to vertex v.
+     *                        Unreachable pairs have no stored value.
+     */
+    template<typename MatrixT>
+    grb::Matrix<typename MatrixT::ScalarType> apsp_floyd_warshall(
+        MatrixT const  &graph,
+        grb::IndexType  tile_size = 0)
+    {
+        using T = typename MatrixT::ScalarType;
+
+        grb::IndexType n(graph.nrows());
+        if (n != graph.ncols())
+        {
+            throw grb::DimensionException();
+        }
+        if (tile_size == 0)
+        {
+            tile_size = apsp_default_tile_size<T>();
+        }
+
+        T const INF(apsp_infinity<T>());
+        std::vector<T> D(n*n, INF);
+        for (grb::IndexType v = 0; v < n; ++v)
+        {
+            D[v*n + v] = static_cast<T>(0);
+        }
+
+        grb::IndexType nvals(graph.nvals());
+        grb::IndexArrayType rows(nvals), cols(nvals);
+        std::vector<T>      vals(nvals);
+        graph.extractTuples(rows, cols, vals);
+        for (grb::IndexType idx = 0; idx < nvals; ++idx)
+        {
+            T &d = D[rows[idx]*n + cols[idx]];
+            d = std::min(d, vals[idx]);
+        }
+
+        T *Dp = D.data();
+        for (grb::IndexType k0 = 0; k0 < n; k0 += tile_size)
+        {
+            grb::IndexType k1 = std::min(n, k0 + tile_size);
+
+            // phase 1: diagonal tile
+            fw_tile_k_outer(Dp, n, k0, k1, k0, k1, k0, k1);
+
+            // phase 2: tiles in row k and column k
+            for (grb::IndexType t0 = 0; t0 < n; t0 += tile_size)
+            {
+                if (t0 == k0) continue;
+                grb::IndexType t1 = std::min(n, t0 + tile_size);
+                fw_tile_k_outer(Dp, n, k0, k1, t0, t1, k0, k1);
+                fw_tile_k_outer(Dp, n, t0, t1, k0, k1, k0, k1);
+            }
+
+            // phase 3: everything else
+            for (grb::IndexType i0 = 0; i0 < n; i0 += tile_size)
+            {
+                if (i0 == k0) continue;
+                grb::IndexType i1 = std::min(n, i0 + tile_size);
+                for (grb::IndexType j0 = 0; j0 < n; j0 += tile_size)
+                {
+                    if (j0 == k0) continue;
+                    grb::IndexType j1 = std::min(n, j0 + tile_size);
+                    fw_tile_i_outer(Dp, n, i0, i1, j0, j1, k0, k1);
+                }
+            }
+        }
+
+        rows.clear(); cols.clear(); vals.clear();
+        for (grb::IndexType i = 0; i < n; ++i)
+        {
+            for (grb::IndexType j = 0; j < n; ++j)
+            {
+                if (D[i*n + j] != INF)
+                {
+                    rows.push_back(i);
+                    cols.push_back(j);
+                    vals.push_back(D[i*n + j]);
+                }
+            }
+        }
+
+        grb::Matrix<T> Distances(n, n);
+        Distances.build(rows, cols, vals);
+        return Distances;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Johnson's algorithm: one Bellman-Ford pass to reweight the
+     *        edges to non-negative values followed by Dijkstra from every
+     *        vertex.  O(N*M*log(N)), which beats Floyd-Warshall on sparse
+     *        graphs.
+     *
+     * @param[in]  graph  The adjacency matrix of the graph for which APSP
+     *                    will be computed.  Entries are edge weights.
+     * @return            A matrix where entry u,v contains the distance
+     *                    of the shortest path from vertex u to vertex v.
+     *                    Unreachable pairs have no stored value.
+     *
+     * @throw PanicException if a negative weight cycle is detected.
+     */
+    template<typename MatrixT>
+    grb::Matrix<typename MatrixT::ScalarType> apsp_johnson(
+        MatrixT const &graph)
+    {
+        using T = typename MatrixT::ScalarType;
+
+        grb::IndexType n(graph.nrows());
+        if (n != graph.ncols())
+        {
+            throw grb::DimensionException();
+        }
+
+        grb::IndexType nvals(graph.nvals());
+        grb::IndexArrayType rows(nvals), cols(nvals);
+        std::vector<T>      vals(nvals);
+        graph.extractTuples(rows, cols, vals);
+
+        // CSR copy of the graph
+        std::vector<grb::IndexType> row_ptr(n + 1, 0);
+        for (auto r : rows) ++row_ptr[r + 1];
+        for (grb::IndexType v = 0; v < n; ++v) row_ptr[v + 1] += row_ptr[v];
+        std::vector<grb::IndexType> adj(nvals);
+        std::vector<T>              wgt(nvals);
+        {
+            std::vector<grb::IndexType> pos(row_ptr.begin(), row_ptr.end() - 1);
+            for (grb::IndexType idx = 0; idx < nvals; ++idx)
+            {
+                grb::IndexType p = pos[rows[idx]]++;
+                adj[p] = cols[idx];
+                wgt[p] = vals[idx];
+            }
+        }
+
+        // Potentials h from a virtual source connected to every vertex with
+        // weight zero; all zero (and skipped) if there are no negative edges.
+        std::vector<T> h(n, static_cast<T>(0));
+        if (std::any_of(wgt.begin(), wgt.end(),
+                        [](T w) { return w < static_cast<T>(0); }))
+        {
+            bool changed(true);
+            for (grb::IndexType iter = 0; changed && (iter <= n); ++iter)
+            {
+                if (iter == n)
+                {
+                    throw grb::PanicException(
+                        "apsp_johnson: negative weight cycle");
+                }
+                changed = false;
+                for (grb::IndexType u = 0; u < n; ++u)
+                {
+                    for (grb::IndexType p = row_ptr[u]; p < row_ptr[u+1]; ++p)
+                    {
+                        if (h[u] + wgt[p] < h[adj[p]])
+                        {
+                            h[adj[p]] = h[u] + wgt[p];
+                            changed = true;
+                        }
+                    }
+                }
+            }
+
+            for (grb::IndexType u = 0; u < n; ++u)
+            {
+                for (grb::IndexType p = row_ptr[u]; p < row_ptr[u+1]; ++p)
+                {
+                    wgt[p] = wgt[p] + h[u] - h[adj[p]];
+                }
+            }
+        }
+
+        // Dijkstra from every vertex on the reweighted graph
+        using QueueEntry = std::tuple<T, grb::IndexType>;
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                            std::greater<QueueEntry>> queue;
+        std::vector<T>              dist(n);
+        std::vector<grb::IndexType> visited(n, 0);   // stamp = src + 1
+        std::vector<grb::IndexType> reached(n, 0);   // stamp = src + 1
+
+        rows.clear(); cols.clear(); vals.clear();
+        for (grb::IndexType src = 0; src < n; ++src)
+        {
+            grb::IndexType const stamp(src + 1);
+            dist[src] = static_cast<T>(0);
+            reached[src] = stamp;
+            queue.emplace(dist[src], src);
+
+            while (!queue.empty())
+            {
+                auto [d, u] = queue.top();
+                queue.pop();
+                if ((visited[u] == stamp) || (d > dist[u])) continue;
+                visited[u] = stamp;
+
+                rows.push_back(src);
+                cols.push_back(u);
+                vals.push_back(d - h[src] + h[u]);
+
+                for (grb::IndexType p = row_ptr[u]; p < row_ptr[u+1]; ++p)
+                {
+                    grb::IndexType v(adj[p]);
+                    T nd = d + wgt[p];
+                    if ((reached[v] != stamp) || (nd < dist[v]))
+                    {
+                        reached[v] = stamp;
+                        dist[v] = nd;
+                        queue.emplace(nd, v);
+                    }
+                }
+            }
+        }
+
+        grb::Matrix<T> Distances(n, n);
+        Distances.build(rows, cols, vals);
+        return Distances;
+    }
+
+    //************************************************************************
     /**
      * @brief Given a graph, G = (V,E), with edge weights w and no negative
      *        weight cycles, this algorithm returns the shortest path
-     *        distances for all vertex pairs (in a dense NxN matrix).
-     *        This implements Floyd-Warshall.
+     *        distances for all vertex pairs.
+     *
+     * Sparse graphs (M*log2(N) < N^2/8) use Johnson's algorithm, denser
+     * graphs the blocked Floyd-Warshall.
      *
      * @param[in]  graph     The adjacency matrix of the graph for which APSP
      *                       will be computed.  Entries are edge weights.
-     * @return               A dense matrix where entry u,v contains
+     * @return               A matrix where entry u,v contains
      *                       the distance (edge weight sum) of shortest path
-     *                       from vertex u to vertex v.
+     *                       from vertex u to vertex v.  Unreachable pairs
+     *                       have no stored value.
      */
     template<typename MatrixT>
     grb::Matrix<typename MatrixT::ScalarType> apsp(MatrixT const &graph)
     {
-        using T = typename MatrixT::ScalarType;
-
-        grb::IndexType num_vertices(graph.nrows());
-        if (num_vertices != graph.ncols())
+        grb::IndexType n(graph.nrows());
+        if (n != graph.ncols())
         {
             throw grb::DimensionException();
         }
 
-        auto Distances(grb::scaled_identity<grb::Matrix<T>>(num_vertices, 0));
-        grb::eWiseAdd(Distances,
-                      grb::NoMask(), grb::NoAccumulate(),
-                      grb::Plus<T>(),
-                      Distances,
-                      graph);
-        grb::Matrix<T> col_k(num_vertices, 1);
-        grb::IndexArrayType row_indices(1);
-        grb::Matrix<T> row_k(1, num_vertices);
-
-        for (grb::IndexType k = 0; k < num_vertices; ++k)
+        double log_n =
+            std::log2(static_cast<double>(std::max<grb::IndexType>(n, 2)));
+        if (static_cast<double>(graph.nvals())*log_n <
+            static_cast<double>(n)*static_cast<double>(n)/8.0)
         {
-            row_indices[0] = k;
-            grb::extract(row_k,
-                         grb::NoMask(),
-                         grb::NoAccumulate(),
-                         Distances,
-                         row_indices, grb::AllIndices());
-
-            grb::extract(col_k,
-                         grb::NoMask(),
-                         grb::NoAccumulate(),
-                         Distances,
-                         grb::AllIndices(), row_indices);
-
-            grb::mxm(Distances,
-                     grb::NoMask(),
-                     grb::Min<T>(),
-                     grb::MinPlusSemiring<T>(),
-                     col_k, row_k);
-
-            //std::cout << "============== Distances for Iteration " << k
-            //          << std::endl;
-            //grb::print_matrix(std::cout, Distances, "Distances");
+            return apsp_johnson(graph);
         }
-        return Distances;
+        return apsp_floyd_warshall(graph);
     }
 } // algorithms
@@ -27,9 +27,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <functional>
 #include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
 
 #include <graphblas/graphblas.hpp>
 
@@ -53,7 +57,6 @@ namespace algorithms
      * @todo This version extracts source neighbors for the first frontier
      *       It precomputes 1 ./ Nsp
      *       It DOES NOT use transpose(A) in the BFS phase
-     *       *It LIMITS the number of BFS traversals to 10 iterations
      *
      * The betweenness centrality of a vertex measures the number of
      * times a vertex acts as a bridge along the shortest path between two
@@ -124,9 +127,7 @@ namespace algorithms
         std::vector<std::unique_ptr<grb::Matrix<bool>>> Sigmas;
         int32_t d = 0;
 
-        // For testing purpose we only allow 10 iterations so it doesn't
-        // get into an infinite loop
-        while (Frontier.nvals() > 0 && d < 10)
+        while (Frontier.nvals() > 0)
         {
             GRB_BC_LOG("------- BFS iteration " << d << " --------");
 
@@ -1296,4 +1297,335 @@ namespace algorithms
         return score;
     }
 
+    //************************************************************************
+    /**
+     * @brief Number of sources per batch of vertex_betweenness_centrality_levels
+     *        that fits in the given memory budget.
+     *
+     * Each source costs at most one stored element per vertex in each of
+     * the n x batch work matrices (path counts, their inverses, levels,
+     * dependencies, frontier/workspace and the level mask) plus its entry
+     * in the level index, about 128 bytes per vertex.
+     */
+    inline grb::IndexType bc_batch_size_for_budget(grb::IndexType num_nodes,
+                                                   std::size_t    memory_budget)
+    {
+        std::size_t const BYTES_PER_ENTRY(128);
+        std::size_t per_source =
+            std::max<std::size_t>(1, num_nodes)*BYTES_PER_ENTRY;
+        return std::max<grb::IndexType>(1, memory_budget/per_source);
+    }
+
+    //************************************************************************
+    /**
+     * @brief Compute the vertex betweenness centrality contributions of a
+     *        batch of source vertices, for graphs of any diameter.
+     *
+     * The BFS phase works on n x |s| matrices (one column per source) and
+     * records the depth of every (vertex, source) pair in a single integer
+     * Levels matrix instead of one boolean matrix per depth.  Each BFS step
+     * chooses between pushing from the frontier (A' +.* F) and pulling into
+     * the vertices that are still unvisited by some source (AT +.* F),
+     * based on which touches fewer edges.  The backprop phase rebuilds the
+     * mask of one level at a time from a level-ordered index of Levels.
+     *
+     * @param[in]  A     The graph to compute the betweenness centrality of.
+     *                   Only the structure is used.
+     * @param[in]  s     The set of source vertex indices from which to compute
+     *                   BC contributions
+     *
+     * @return The betweenness centrality of all vertices in the graph relative
+     *         to the specified source vertices.
+     */
+    template<typename MatrixT>
+    std::vector<float> vertex_betweenness_centrality_levels(
+        MatrixT const             &A,
+        grb::IndexArrayType const &s)
+    {
+        GRB_BC_LOG("vertex_betweenness_centrality_levels Graph " << A);
+
+        grb::IndexType nsver(s.size());
+        if (nsver == 0)
+        {
+            throw grb::DimensionException();
+        }
+
+        grb::IndexType n = A.nrows();
+        if (n != A.ncols())
+        {
+            throw grb::DimensionException();
+        }
+
+        // Pattern of the graph and its transpose, and the vertex degrees
+        grb::IndexType m(A.nvals());
+        grb::IndexArrayType rows(m), cols(m);
+        std::vector<typename MatrixT::ScalarType> weights(m);
+        A.extractTuples(rows, cols, weights);
+
+        grb::IndexArrayType const &out_degree(A.degreeStats().row_degrees);
+        grb::IndexArrayType const &in_degree(A.degreeStats().col_degrees);
+
+        grb::Matrix<double> G(n, n), GT(n, n);
+        G.build(rows, cols, std::vector<double>(m, 1.0));
+        GT.build(cols, rows, std::vector<double>(m, 1.0));
+
+        // ==================== BFS phase ====================
+        // NumSP(v,k): number of shortest paths from s[k] to v
+        // Levels(v,k): BFS depth of v from s[k]
+        grb::IndexArrayType src_cols(nsver);
+        std::iota(src_cols.begin(), src_cols.end(), 0);
+
+        grb::Matrix<double>  Frontier(n, nsver);
+        grb::Matrix<double>  NumSP(n, nsver);
+        grb::Matrix<int32_t> Levels(n, nsver);
+        Frontier.build(s, src_cols, std::vector<double>(nsver, 1.0));
+        NumSP.build(s, src_cols, std::vector<double>(nsver, 1.0));
+        Levels.build(s, src_cols, std::vector<int32_t>(nsver, 0));
+
+        // Edges a push step would traverse (out of the frontier) and a pull
+        // step would traverse (into vertices some source has not reached).
+        std::vector<grb::IndexType> num_visited(n, 0);
+        grb::IndexType push_edges(0);
+        grb::IndexType pull_edges(m);
+        auto visit = [&](grb::IndexArrayType const &vertices)
+        {
+            push_edges = 0;
+            for (auto v : vertices)
+            {
+                push_edges += out_degree[v];
+                if (++num_visited[v] == nsver)
+                {
+                    pull_edges -= in_degree[v];
+                }
+            }
+        };
+        visit(s);
+
+        std::vector<double> frontier_vals;
+        int32_t depth = 0;
+        while (true)
+        {
+            ++depth;
+            GRB_BC_LOG("------- BFS iteration " << depth << " --------");
+
+            // F<!struct(P),z> = A' +.* F
+            if (pull_edges < push_edges)
+            {
+                grb::mxm(Frontier,
+                         grb::complement(grb::structure(NumSP)),
+                         grb::NoAccumulate(),
+                         grb::ArithmeticSemiring<double>(),
+                         GT, Frontier, grb::REPLACE);
+            }
+            else
+            {
+                grb::mxm(Frontier,
+                         grb::complement(grb::structure(NumSP)),
+                         grb::NoAccumulate(),
+                         grb::ArithmeticSemiring<double>(),
+                         grb::transpose(G), Frontier, grb::REPLACE);
+            }
+
+            if (Frontier.nvals() == 0)
+            {
+                break;
+            }
+
+            // P += F
+            grb::eWiseAdd(NumSP,
+                          grb::NoMask(), grb::NoAccumulate(),
+                          grb::Plus<double>(),
+                          NumSP, Frontier);
+
+            // Levels<struct(F)> = depth
+            grb::apply(Levels,
+                       grb::NoMask(), grb::Second<int32_t>(),
+                       [depth](double) { return depth; },
+                       Frontier);
+
+            grb::IndexType nvals(Frontier.nvals());
+            rows.resize(nvals); cols.resize(nvals); frontier_vals.resize(nvals);
+            Frontier.extractTuples(rows, cols, frontier_vals);
+            visit(rows);
+        }
+        int32_t max_depth = depth - 1;
+        GRB_BC_LOG("max depth: " << max_depth);
+
+        // Index the (vertex, source) pairs of Levels by depth
+        std::vector<grb::IndexType> level_ptr(max_depth + 2, 0);
+        grb::IndexArrayType level_rows, level_cols;
+        {
+            grb::IndexType nvals(Levels.nvals());
+            std::vector<int32_t> level_vals(nvals);
+            rows.resize(nvals); cols.resize(nvals);
+            Levels.extractTuples(rows, cols, level_vals);
+
+            for (auto d : level_vals) ++level_ptr[d + 1];
+            for (int32_t d = 0; d <= max_depth; ++d)
+                level_ptr[d + 1] += level_ptr[d];
+
+            level_rows.resize(nvals);
+            level_cols.resize(nvals);
+            std::vector<grb::IndexType> pos(level_ptr.begin(), level_ptr.end() - 1);
+            for (grb::IndexType idx = 0; idx < nvals; ++idx)
+            {
+                grb::IndexType p = pos[level_vals[idx]]++;
+                level_rows[p] = rows[idx];
+                level_cols[p] = cols[idx];
+            }
+        }
+
+        grb::Matrix<bool> LevelMask(n, nsver);
+        auto build_level_mask = [&](int32_t d)
+        {
+            LevelMask.clear();
+            LevelMask.build(level_rows.begin() + level_ptr[d],
+                            level_cols.begin() + level_ptr[d],
+                            std::vector<bool>(level_ptr[d + 1] - level_ptr[d],
+                                              true).begin(),
+                            level_ptr[d + 1] - level_ptr[d]);
+        };
+
+        // ================== backprop phase ==================
+        grb::Matrix<double> NspInv(n, nsver);
+        grb::apply(NspInv,
+                   grb::NoMask(), grb::NoAccumulate(),
+                   grb::MultiplicativeInverse<double>(),
+                   NumSP);
+
+        grb::Matrix<double> Delta(n, nsver);
+        grb::Matrix<double> W(n, nsver);
+
+        for (int32_t d = max_depth; d > 1; --d)
+        {
+            GRB_BC_LOG("------- BACKPROP iteration " << d << " --------");
+
+            // W<Levels == d> = (1 + Delta) ./ P
+            build_level_mask(d);
+            grb::apply(W, LevelMask, grb::NoAccumulate(),
+                       grb::Identity<double>(), NspInv, grb::REPLACE);
+            grb::eWiseMult(W, LevelMask, grb::Plus<double>(),
+                           grb::Times<double>(), NspInv, Delta);
+
+            // W<Levels == d-1> = A +.* W
+            build_level_mask(d - 1);
+            grb::mxm(W, LevelMask, grb::NoAccumulate(),
+                     grb::ArithmeticSemiring<double>(),
+                     G, W, grb::REPLACE);
+
+            // Delta += W .* P
+            grb::eWiseMult(Delta, grb::NoMask(), grb::Plus<double>(),
+                           grb::Times<double>(), W, NumSP);
+        }
+
+        GRB_BC_LOG("Delta " << Delta);
+
+        // BC(v) = sum over the sources of Delta(v,:)
+        grb::Vector<double> result(n);
+        grb::reduce(result,
+                    grb::NoMask(), grb::NoAccumulate(),
+                    grb::Plus<double>(),
+                    Delta);
+
+        grb::IndexArrayType result_idx(result.nvals());
+        std::vector<double> result_vals(result.nvals());
+        result.extractTuples(result_idx, result_vals);
+
+        std::vector<float> betweenness_centrality(n, 0.f);
+        for (grb::IndexType idx = 0; idx < result_idx.size(); ++idx)
+        {
+            betweenness_centrality[result_idx[idx]] =
+                static_cast<float>(result_vals[idx]);
+        }
+
+        return betweenness_centrality;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Compute the vertex betweenness centrality contributions of the
+     *        given sources in batches sized to fit a memory budget.
+     *
+     * @param[in]  A              The graph to compute the betweenness
+     *                            centrality of.
+     * @param[in]  s              The source vertex indices.
+     * @param[in]  memory_budget  Approximate bytes available to the work
+     *                            matrices of one batch.
+     */
+    template<typename MatrixT>
+    std::vector<float> vertex_betweenness_centrality_budgeted(
+        MatrixT const             &A,
+        grb::IndexArrayType const &s,
+        std::size_t                memory_budget = (1UL << 30))
+    {
+        grb::IndexType batch_size(
+            bc_batch_size_for_budget(A.nrows(), memory_budget));
+        GRB_BC_LOG("batch size from budget: " << batch_size);
+
+        std::vector<float> betweenness_centrality(A.nrows(), 0.f);
+        for (grb::IndexType start = 0; start < s.size(); start += batch_size)
+        {
+            grb::IndexArrayType batch(
+                s.begin() + start,
+                s.begin() + std::min<grb::IndexType>(s.size(),
+                                                     start + batch_size));
+            auto partial = vertex_betweenness_centrality_levels(A, batch);
+            for (grb::IndexType v = 0; v < partial.size(); ++v)
+            {
+                betweenness_centrality[v] += partial[v];
+            }
+        }
+
+        return betweenness_centrality;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Approximate vertex betweenness centrality from a uniform sample
+     *        of source vertices.
+     *
+     * The contributions of num_samples distinct sources (all vertices if
+     * num_samples >= N) are summed and scaled by N/num_samples.
+     *
+     * @param[in]  A              The graph to compute the betweenness
+     *                            centrality of.
+     * @param[in]  num_samples    The number of sources to sample.
+     * @param[in]  memory_budget  Approximate bytes available to the work
+     *                            matrices of one batch.
+     * @param[in]  seed           Seed for the source sampling.
+     */
+    template<typename MatrixT>
+    std::vector<float> vertex_betweenness_centrality_sampled(
+        MatrixT const  &A,
+        grb::IndexType  num_samples,
+        std::size_t     memory_budget = (1UL << 30),
+        unsigned int    seed = 0)
+    {
+        grb::IndexType n(A.nrows());
+        if (n == 0)
+        {
+            return std::vector<float>();
+        }
+
+        grb::IndexArrayType sources(n);
+        std::iota(sources.begin(), sources.end(), 0);
+        if (num_samples < n)
+        {
+            std::default_random_engine generator(seed);
+            std::shuffle(sources.begin(), sources.end(), generator);
+            sources.resize(std::max<grb::IndexType>(1, num_samples));
+        }
+
+        auto betweenness_centrality =
+            vertex_betweenness_centrality_budgeted(A, sources, memory_budget);
+
+        float scale = static_cast<float>(n)/static_cast<float>(sources.size());
+        for (auto &val : betweenness_centrality)
+        {
+            val *= scale;
+        }
+        return betweenness_centrality;
+    }
+
+
 } // algorithms
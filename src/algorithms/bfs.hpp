@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <tuple>
 
@@ -481,6 +483,167 @@ namespace algorithms
     }
 
 
+    //************************************************************************
+    /**
+     * @brief Perform multiple breadth first searches (BFS) on the given graph
+     *        with the traversals packed 64 to a word (multi-source BFS).
+     *
+     * The traversals are processed in groups of 64.  Each vertex holds one
+     * 64-bit word per group for its frontier and visited sets (bit r is
+     * traversal r), so one bitwise-OR vxm advances all 64 traversals by a
+     * level.  When the edges leaving the frontier outnumber the edges into
+     * vertices not yet reached by every traversal (scaled by 1/14), the
+     * level is pulled instead with a masked mxv against the transpose.
+     *
+     * @param[in]  graph      NxN adjacency matrix of the graph on which to
+     *                        perform a BFS (not the transpose).  A value of
+     *                        1 indicates an edge (structural zero = 0).
+     * @param[in]  wavefronts RxN initial wavefronts to use in the calculation
+     *                        of R simultaneous traversals.  A stored value in
+     *                        a given row indicates a root for the
+     *                        corresponding traversal.
+     * @param[out] levels     RxN level (distance in unweighted graphs) from
+     *                        the corresponding root of that BFS.  Roots are
+     *                        assigned a value of 1. (no stored value implies
+     *                        not reachable).
+     */
+    template <typename MatrixT,
+              typename WavefrontsMatrixT,
+              typename LevelListMatrixT>
+    void batch_bfs_level_bitwise(MatrixT const           &graph,
+                                 WavefrontsMatrixT const &wavefronts,
+                                 LevelListMatrixT        &levels)
+    {
+        using T = typename MatrixT::ScalarType;
+        using LevelT = typename LevelListMatrixT::ScalarType;
+        using WordT = uint64_t;
+        grb::IndexType const BITS_PER_WORD(64);
+        grb::IndexType const PULL_RATIO(14);
+
+        grb::IndexType N(graph.nrows());
+        grb::IndexType R(wavefronts.nrows());
+        if ((graph.ncols() != N) || (wavefronts.ncols() != N) ||
+            (levels.nrows() != R) || (levels.ncols() != N))
+        {
+            throw grb::DimensionException();
+        }
+
+        // Pattern of the transpose (for pull) and the (cached) vertex degrees
+        grb::Matrix<grb::IndexType> AT(N, N);
+        grb::transpose(AT, grb::NoMask(), grb::NoAccumulate(), graph);
+        grb::apply(AT, grb::NoMask(), grb::NoAccumulate(),
+                   [](grb::IndexType) { return grb::IndexType(1); }, AT);
+
+        grb::IndexArrayType const &in_degree(graph.degreeStats().col_degrees);
+        grb::IndexArrayType const &out_degree(graph.degreeStats().row_degrees);
+
+        grb::IndexArrayType root_rows(wavefronts.nvals());
+        grb::IndexArrayType root_cols(wavefronts.nvals());
+        std::vector<typename WavefrontsMatrixT::ScalarType>
+            root_vals(wavefronts.nvals());
+        wavefronts.extractTuples(root_rows, root_cols, root_vals);
+
+        grb::IndexArrayType level_rows, level_cols;
+        std::vector<LevelT> level_vals;
+
+        grb::Vector<WordT> frontier(N), next(N), seen(N);
+        grb::Vector<bool>  complete(N);
+        grb::IndexArrayType next_idx;
+        std::vector<WordT>  next_words;
+
+        for (grb::IndexType base = 0; base < R; base += BITS_PER_WORD)
+        {
+            grb::IndexType num_bits(std::min(BITS_PER_WORD, R - base));
+            WordT all_bits((num_bits == BITS_PER_WORD) ?
+                           ~WordT(0) : ((WordT(1) << num_bits) - 1));
+
+            frontier.clear();
+            seen.clear();
+            complete.clear();
+            grb::IndexType unreached_edges(graph.nvals());
+            grb::IndexType frontier_edges(0);
+
+            // Add a vertex to the next frontier for the traversals that
+            // have not seen it yet, and record their levels.
+            auto visit =
+                [&](grb::IndexType v, WordT word, grb::IndexType depth)
+                {
+                    WordT seen_word(seen.hasElement(v) ?
+                                    seen.extractElement(v) : WordT(0));
+                    word &= ~seen_word;
+                    if (word == 0)
+                    {
+                        return;
+                    }
+
+                    seen_word |= word;
+                    seen.setElement(v, seen_word);
+                    if (seen_word == all_bits)
+                    {
+                        complete.setElement(v, true);
+                        unreached_edges -= in_degree[v];
+                    }
+                    frontier.setElement(v, word);
+                    frontier_edges += out_degree[v];
+
+                    for (WordT bits = word; bits != 0; bits &= bits - 1)
+                    {
+                        level_rows.push_back(base + __builtin_ctzll(bits));
+                        level_cols.push_back(v);
+                        level_vals.push_back(static_cast<LevelT>(depth));
+                    }
+                };
+
+            for (grb::IndexType ix = 0; ix < root_rows.size(); ++ix)
+            {
+                if ((root_rows[ix] >= base) &&
+                    (root_rows[ix] < base + num_bits))
+                {
+                    visit(root_cols[ix],
+                          WordT(1) << (root_rows[ix] - base), 1);
+                }
+            }
+
+            grb::IndexType depth(1);
+            while (frontier.nvals() > 0)
+            {
+                ++depth;
+
+                if (frontier_edges > unreached_edges/PULL_RATIO)
+                {
+                    // pull: next(v) = OR of frontier(u) over edges u->v
+                    grb::mxv(next, grb::complement(complete),
+                             grb::NoAccumulate(),
+                             grb::BitwiseOrSecondSemiring<
+                                 grb::IndexType, WordT, WordT>(),
+                             AT, frontier, grb::REPLACE);
+                }
+                else
+                {
+                    // push
+                    grb::vxm(next, grb::complement(complete),
+                             grb::NoAccumulate(),
+                             grb::BitwiseOrFirstSemiring<WordT, T, WordT>(),
+                             frontier, graph, grb::REPLACE);
+                }
+
+                next_idx.resize(next.nvals());
+                next_words.resize(next.nvals());
+                next.extractTuples(next_idx.begin(), next_words.begin());
+
+                frontier.clear();
+                frontier_edges = 0;
+                for (grb::IndexType ix = 0; ix < next_idx.size(); ++ix)
+                {
+                    visit(next_idx[ix], next_words[ix], depth);
+                }
+            }
+        }
+
+        levels.clear();
+        levels.build(level_rows, level_cols, level_vals);
+    }
+
     //************************************************************************
     /**
      * @brief Perform a single breadth first searches (BFS) on the given graph.
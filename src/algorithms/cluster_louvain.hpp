@@ -27,6 +27,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
 #include <vector>
 #include <random>
 #include <graphblas/graphblas.hpp>
@@ -73,247 +77,282 @@ namespace algorithms
 
     //************************************************************************
     /**
-     * @brief Compute the clusters in the given graph using louvain clustering.
+     * @brief One level of louvain clustering: repeatedly move each vertex to
+     *        the community with the largest modularity gain until no vertex
+     *        changes community.
      *
-     * @param[in]  graph    The graph to compute the clusters on.  Can be a
-     *                         weighted graph.
-     * @param[in]  random_seed The seed for the RNG for tie breaking
-     * @param[in]  max_iters   The maximum number of iterations to run if
-     *                         convergence doesn't occur first (uncommon)
+     * The rows of A + A' are extracted once, and the community of each
+     * vertex and the total degree of each community are kept in arrays and
+     * updated incrementally, so visiting a vertex costs O(degree) (plus the
+     * number of communities when all of them are considered).  S is
+     * rewritten from the final assignment.
      *
-     * @return A matrix whose columns correspond to the vertices, and vertices
-     *         with the same (max) value in a given row belong to the
-     *         same cluster.
+     * @param[in]     ApAT            A + A' of the graph
+     * @param[in]     k               Weighted out-degree of each vertex
+     * @param[in]     m               Half of the total edge weight
+     * @param[in,out] S               Vertex by community assignment matrix
+     *                                with exactly one entry per row
+     * @param[in]     only_neighbors  Only consider the communities of the
+     *                                neighbors of each vertex
+     * @param[in,out] generator       RNG used for tie breaking
+     * @param[in]     max_iters       The maximum number of passes over the
+     *                                vertices
+     *
+     * @return True if any vertex changed community.
      */
-    template<typename MatrixT, typename RealT=double>
-    grb::Matrix<bool> louvain_cluster(
-        MatrixT const &graph,
-        double         random_seed = 11.0, // arbitrary
-        unsigned int   max_iters = std::numeric_limits<unsigned int>::max())
+    template<typename RealT, typename GeneratorT>
+    bool louvain_local_moving(grb::Matrix<RealT> const &ApAT,
+                              grb::Vector<RealT> const &k,
+                              RealT                     m,
+                              grb::Matrix<bool>        &S,
+                              bool                      only_neighbors,
+                              GeneratorT               &generator,
+                              unsigned int              max_iters)
     {
-        using T = typename MatrixT::ScalarType;
+        grb::IndexType rows(ApAT.nrows());
         unsigned int iters = 0;
 
-        grb::IndexType rows(graph.nrows());
-        grb::IndexType cols(graph.ncols());
-        if (rows != cols)
+        std::uniform_real_distribution<double> distribution;
+
+        // Rows of A + A' as flat arrays: row i is [a_ptr[i], a_ptr[i+1]).
+        // ApAT does not change here, so it is extracted once and each visit
+        // reads its row directly instead of going through vxm.
+        auto const &a_degrees(ApAT.degreeStats().row_degrees);
+        grb::IndexArrayType a_ptr(rows + 1, 0);
+        std::partial_sum(a_degrees.begin(), a_degrees.end(), a_ptr.begin() + 1);
+        grb::IndexArrayType a_rows(ApAT.nvals()), a_cols(ApAT.nvals());
+        std::vector<RealT>  a_vals(ApAT.nvals());
+        ApAT.extractTuples(a_rows, a_cols, a_vals);
+
+        std::vector<RealT> k_vals(rows, static_cast<RealT>(0));
+        std::vector<bool>  has_k(rows, false);
         {
-            throw grb::DimensionException();
+            grb::IndexArrayType k_idx(k.nvals());
+            std::vector<RealT>  k_tmp(k.nvals());
+            k.extractTuples(k_idx, k_tmp);
+            for (grb::IndexType ix = 0; ix < k_idx.size(); ++ix)
+            {
+                k_vals[k_idx[ix]] = k_tmp[ix];
+                has_k[k_idx[ix]] = true;
+            }
         }
 
-        //grb::print_matrix(std::cout, graph, "*** graph ***");
-
-        // precompute A + A'
-        grb::Matrix<T> ApAT(graph);
-        grb::transpose(ApAT, grb::NoMask(),
-                       grb::Plus<T>(), graph);
-
-        //grb::print_matrix(std::cout, ApAT, "*** A+A' ***");
-
-        // k = A * vec(1)  (arithmetric row reduce of adj. matrix)
-        grb::Vector<RealT> k(rows);
-        grb::reduce(k, grb::NoMask(), grb::NoAccumulate(),
-                    grb::Plus<RealT>(), graph);
-
-        // m = 0.5*k'*vec(1) (reduce k to scalar)
-        RealT m(0);
-        grb::reduce(m, grb::NoAccumulate(),
-                    grb::PlusMonoid<RealT>(), k);
-        m = m/2.0;
-
-        // Initialize S to identity?
-        auto S(grb::scaled_identity<grb::Matrix<bool>>(rows));
-
-        grb::Vector<bool> S_row(rows);
+        // community of each vertex (the column of its entry in S)
+        grb::IndexArrayType community(rows);
+        {
+            grb::IndexArrayType s_rows(S.nvals()), s_cols(S.nvals());
+            std::vector<bool> s_vals(S.nvals());
+            S.extractTuples(s_rows, s_cols, s_vals);
+            for (grb::IndexType ix = 0; ix < s_rows.size(); ++ix)
+            {
+                community[s_rows[ix]] = s_cols[ix];
+            }
+        }
 
-        // create a dense mask vector of all trues
-        grb::Vector<bool> mask(rows);
-        grb::assign(mask, grb::NoMask(), grb::NoAccumulate(),
-                    true, grb::AllIndices());
+        // tot' = k' * S, total degree of each community, and the number of
+        // (non-isolated) vertices contributing to it; a community has a
+        // total iff members > 0.
+        std::vector<RealT>  tot(rows, static_cast<RealT>(0));
+        grb::IndexArrayType members(rows, 0);
+        for (grb::IndexType j = 0; j < rows; ++j)
+        {
+            if (has_k[j])
+            {
+                tot[community[j]] += k_vals[j];
+                ++members[community[j]];
+            }
+        }
 
-        //SetRandom<RealT> set_random(random_seed);
-        std::default_random_engine             generator;
-        std::uniform_real_distribution<double> distribution;
-        generator.seed(random_seed);
+        // q, the modularity gain of each candidate community (dense, with
+        // the list of set entries kept sorted for tie breaking)
+        std::vector<RealT>  q(rows);
+        std::vector<bool>   q_set(rows, false);
+        grb::IndexArrayType q_idx;
+        grb::IndexArrayType ties;
 
         bool vertices_changed(true);
+        bool any_changed(false);
 
         // repeat while modularity is increasing
         do
         {
-            //std::cout << "====== Start of new outer iteration1 ======" << std::endl;
-
             vertices_changed = false;
 
             for (grb::IndexType i = 0; i < rows; ++i)
             {
                 // only perform the iteration if the ith vertex is not isolated
-                if (k.hasElement(i))
+                if (!has_k[i])
                 {
-                    //std::cout << "====== Start of vertex " << i << std::endl;
-
-                    // s_i = S[i,:]
-                    grb::extract(S_row, grb::NoMask(),
-                                 grb::NoAccumulate(),
-                                 grb::transpose(S),
-                                 grb::AllIndices(), i);
-
-                    // S := (I - e_i*e_i')S means clear i-th row of S (using a mask)
-                    grb::Matrix<bool> Mask(rows, rows);
-                    grb::assign(Mask, grb::NoMask(),
-                                grb::NoAccumulate(),
-                                mask, i, grb::AllIndices());
-
-                    grb::apply(S, grb::complement(Mask),
-                               grb::NoAccumulate(),
-                               grb::Identity<bool>(),
-                               S, grb::REPLACE);
-
-                    // v' = e_i' * (A + A') == extract row i of (A + A')
-                    grb::Vector<RealT> v(rows);
-                    grb::extract(v, grb::NoMask(),
-                                 grb::NoAccumulate(),
-                                 ApAT,
-                                 grb::AllIndices(), i);
-
-                    // v' += (-k_i/m)*k'
-                    grb::apply(
-                        v, grb::NoMask(),
-                        grb::Plus<RealT>(),
-                        std::bind(grb::Times<RealT>(),
-                                  std::placeholders::_1,
-                                  static_cast<RealT>(-k.extractElement(i)/m)),
-                        k);
-
-
-                    // q' = v' * S = [e_i' * (A + A') + (-k_i/m)*k'] * S
-                    grb::Vector<RealT> q(rows);
-                    grb::vxm(q, grb::NoMask(),
-                             grb::NoAccumulate(),
-                             grb::ArithmeticSemiring<RealT>(),
-                             v, S);
-                    //grb::print_vector(
-                    //    std::cout, q, "q' = [e_i' * (A + A') + (-k_i/m)*k'] * S");
-
-                    // kappa = max(q)
-                    RealT kappa(0);
-                    grb::reduce(kappa, grb::NoAccumulate(),
-                                grb::MaxMonoid<RealT>(), q);
-                    //std::cout << "kappa = " << kappa << std::endl;
-
-                    // t = (q == kappa)
-                    grb::Vector<bool> t(rows);
-                    grb::apply(t, grb::NoMask(),
-                               grb::NoAccumulate(),
-                               std::bind(grb::Equal<RealT>(),
-                                         std::placeholders::_1,
-                                         kappa),
-                               q);
-
-                    // remove all stored falses (TODO: Replace with GxB_select?)
-                    grb::apply(t, t, grb::NoAccumulate(),
-                               grb::Identity<T>(), t, grb::REPLACE);
-                    //grb::print_vector(
-                    //    std::cout, t, "t = (q == kappa), with zeros removed");
-
-                    // break ties if necessary
-                    while (t.nvals() != 1)
+                    continue;
+                }
+
+                RealT          k_i(k_vals[i]);
+                grb::IndexType c_i(community[i]);
+
+                // take vertex i out of its community's totals
+                if (--members[c_i] > 0)
+                {
+                    tot[c_i] -= k_i;
+                }
+
+                // q' = v' * S, v' = row i of (A + A'); i itself is no
+                // longer in any community so its own entry contributes
+                // nothing.
+                q_idx.clear();
+                for (grb::IndexType ix = a_ptr[i]; ix < a_ptr[i + 1]; ++ix)
+                {
+                    grb::IndexType j(a_cols[ix]);
+                    if (j == i) continue;
+
+                    grb::IndexType c(community[j]);
+                    if (q_set[c])
+                    {
+                        q[c] += a_vals[ix];
+                    }
+                    else
+                    {
+                        q_set[c] = true;
+                        q[c] = a_vals[ix];
+                        q_idx.push_back(c);
+                    }
+                }
+
+                // q' += (-k_i/m)*tot'
+                if (only_neighbors)
+                {
+                    // only adjust the communities of the neighbors of i
+                    for (auto c : q_idx)
+                    {
+                        if (members[c] > 0)
+                        {
+                            q[c] -= k_i*tot[c]/m;
+                        }
+                    }
+                }
+                else
+                {
+                    RealT scale(static_cast<RealT>(-k_i/m));
+                    for (grb::IndexType c = 0; c < rows; ++c)
                     {
-                        //std::cout << "breaking ties: t.nvals() = "
-                        //          << t.nvals() << std::endl;
-
-                        // Assign a random number to each possible cluster
-                        grb::Vector<RealT> p(rows);
-                        grb::apply(p, grb::NoMask(),
-                                   grb::NoAccumulate(),
-                                   [&](bool tval)      //set_random,
-                                   {
-                                       return static_cast<RealT>(
-                                           tval*distribution(generator) + 0.0001);
-                                   },
-                                   t);
-                        // max_p = max(p)
-                        RealT max_p(0);
-                        grb::reduce(max_p, grb::NoAccumulate(),
-                                    grb::MaxMonoid<RealT>(), p);
-
-                        // t = (q == kappa)
-                        grb::apply(t, grb::NoMask(),
-                                   grb::NoAccumulate(),
-                                   std::bind(grb::Equal<RealT>(),
-                                             std::placeholders::_1,
-                                             max_p),
-                                   p);
-
-                        // remove all stored falses (TODO: Replace with GxB_select?)
-                        grb::apply(t, t, grb::NoAccumulate(),
-                                   grb::Identity<T>(), t,
-                                   grb::REPLACE);
-
-                        //grb::print_vector(
-                        //    std::cout, t, "new t after breaking ties");
+                        if (members[c] == 0) continue;
+                        if (q_set[c])
+                        {
+                            q[c] += tot[c]*scale;
+                        }
+                        else
+                        {
+                            q_set[c] = true;
+                            q[c] = tot[c]*scale;
+                            q_idx.push_back(c);
+                        }
                     }
+                }
 
-                    // Replace row i of S with t
-                    grb::assign(S, grb::NoMask(),
-                                grb::NoAccumulate(),
-                                t, i, grb::AllIndices());
+                // staying in (or alone as) its own community is a candidate
+                if (!q_set[c_i])
+                {
+                    q_set[c_i] = true;
+                    q[c_i] = (members[c_i] > 0) ?
+                        -k_i*tot[c_i]/m : static_cast<RealT>(0);
+                    q_idx.push_back(c_i);
+                }
+                std::sort(q_idx.begin(), q_idx.end());
 
-                    // Compare new community w/ previous community to
-                    // see if it has changed
-                    if (t != S_row) // vertex changed communities
+                // kappa = max(q)
+                RealT kappa(q[q_idx.front()]);
+                for (auto c : q_idx)
+                {
+                    kappa = std::max(kappa, q[c]);
+                }
+
+                // stay put unless another community is strictly better
+                grb::IndexType c_new(c_i);
+                if (q[c_i] != kappa)
+                {
+                    // ties = (q == kappa)
+                    ties.clear();
+                    for (auto c : q_idx)
                     {
-                        vertices_changed = true;
-                        //grb::print_matrix(
-                        //    std::cout, S, "*** changed cluster assignments, S ***");
+                        if (q[c] == kappa) ties.push_back(c);
                     }
-                    else
+
+                    // break ties if necessary: a random number for each
+                    // tied community, keep the largest
+                    std::vector<RealT> p;
+                    while (ties.size() != 1)
                     {
-                        //std::cout<< "No change. "<< std::endl;
+                        p.resize(ties.size());
+                        for (auto &p_c : p)
+                        {
+                            p_c = static_cast<RealT>(
+                                distribution(generator) + 0.0001);
+                        }
+                        RealT max_p(*std::max_element(p.begin(), p.end()));
+
+                        grb::IndexType num_ties(0);
+                        for (grb::IndexType ix = 0; ix < ties.size(); ++ix)
+                        {
+                            if (p[ix] == max_p) ties[num_ties++] = ties[ix];
+                        }
+                        ties.resize(num_ties);
                     }
+
+                    c_new = ties[0];
                 }
-                //std::cout << "====== End   of vertex " << i << std::endl;
-            }
 
-            //std::cout << "====== End   of     outer iteration ======" << std::endl;
-            //auto cluster_assignments =
-            //    algorithms::get_louvain_cluster_assignments(S);
-            //print_vector(std::cout, cluster_assignments, "cluster assignments");
+                for (auto c : q_idx)
+                {
+                    q_set[c] = false;
+                }
+
+                // Put vertex i in its new community
+                community[i] = c_new;
+                tot[c_new] = (members[c_new] > 0) ? tot[c_new] + k_i : k_i;
+                ++members[c_new];
+
+                // Compare new community w/ previous community to
+                // see if it has changed
+                if (c_new != c_i) // vertex changed communities
+                {
+                    vertices_changed = true;
+                    any_changed = true;
+                }
+            }
 
             ++iters;
         } while (vertices_changed && iters < max_iters);
 
+        // S(i, community[i]) = true, one entry per row
+        grb::IndexArrayType s_rows(rows);
+        std::iota(s_rows.begin(), s_rows.end(), 0);
+        S.clear();
+        S.build(s_rows, community, std::vector<bool>(rows, true));
+
         if (vertices_changed)
             throw iters;
 
-        //grb::print_matrix(
-        //    std::cout, S, "Final cluster assignments, S");
-        return S;
+        return any_changed;
     }
 
     //************************************************************************
     /**
-     * @brief Compute the clusters in the given graph using louvain clustering
-     *        and applying an mask to the clusters considered.
-     *
-     * @param[in]  graph    The graph to compute the clusters on.  Can be a
-     *                         weighted graph.
-     * @param[in]  random_seed The seed for the RNG for tie breaking
-     * @param[in]  max_iters   The maximum number of iterations to run if
-     *                         convergence doesn't occur first (uncommon)
+     * @brief Multi-level louvain clustering shared by louvain_cluster and
+     *        louvain_cluster_masked.
      *
-     * @return A matrix whose columns correspond to the vertices, and vertices
-     *         with the same (max) value in a given row belong to the
-     *         same cluster.
+     * After each level of local moving, the non-empty communities are
+     * relabeled 0..C-1 and the graph is coarsened to C x C with
+     * A := S' * A * S.  Levels repeat on the coarse graph until no vertex
+     * moves.
      */
     template<typename MatrixT, typename RealT=double>
-    grb::Matrix<bool> louvain_cluster_masked(
+    grb::Matrix<bool> louvain_cluster_levels(
         MatrixT const &graph,
-        double         random_seed = 11.0, // arbitrary
-        unsigned int   max_iters = std::numeric_limits<unsigned int>::max())
+        bool           only_neighbors,
+        double         random_seed,
+        unsigned int   max_iters,
+        unsigned int   max_levels)
     {
         using T = typename MatrixT::ScalarType;
-        unsigned int iters = 0;
 
         grb::IndexType rows(graph.nrows());
         grb::IndexType cols(graph.ncols());
@@ -322,212 +361,147 @@ namespace algorithms
             throw grb::DimensionException();
         }
 
-        //grb::print_matrix(std::cout, graph, "*** graph ***");
-
-        // precompute A + A'
-        grb::Matrix<T> ApAT(graph);
-        grb::transpose(ApAT, grb::NoMask(),
-                       grb::Plus<T>(), graph);
-
-        //grb::print_matrix(std::cout, ApAT, "*** A+A' ***");
-
-        // k = A * vec(1)  (arithmetric row reduce of adj. matrix)
-        grb::Vector<RealT> k(rows);
-        grb::reduce(k, grb::NoMask(), grb::NoAccumulate(),
-                    grb::Plus<RealT>(), graph);
-
-        // m = 0.5*k'*vec(1) (reduce k to scalar)
-        RealT m(0);
-        grb::reduce(m, grb::NoAccumulate(),
-                    grb::PlusMonoid<RealT>(), k);
-        m = m/2.0;
-
-        // Initialize S to identity?
-        auto S(grb::scaled_identity<grb::Matrix<bool>>(rows));
-
-        grb::Vector<bool> S_row(rows);
-
-        // create a dense mask vector of all trues
-        grb::Vector<bool> mask(rows);
-        grb::assign(mask, grb::NoMask(), grb::NoAccumulate(),
-                    true, grb::AllIndices());
-
         //SetRandom<RealT> set_random(random_seed);
-        std::default_random_engine             generator;
-        std::uniform_real_distribution<double> distribution;
+        std::default_random_engine generator;
         generator.seed(random_seed);
 
-        bool vertices_changed(true);
+        // Cluster assignments of the original vertices
+        auto S_total(grb::scaled_identity<grb::Matrix<bool>>(rows));
 
-        // allocate once
-        grb::Vector<RealT> v(rows);
-        grb::Vector<bool> q_mask(rows);
-        grb::Vector<RealT> q(rows);
-        grb::Vector<bool> t(rows);
+        grb::Matrix<RealT> A(rows, rows);
+        grb::apply(A, grb::NoMask(), grb::NoAccumulate(),
+                   grb::Identity<T, RealT>(), graph);
 
-        // repeat while modularity is increasing
-        do
+        for (unsigned int level = 0; level < max_levels; ++level)
         {
-            //std::cout << "====== Start of new outer iteration ======" << std::endl;
-
-            vertices_changed = false;
-
-            for (grb::IndexType i = 0; i < rows; ++i)
+            grb::IndexType n(A.nrows());
+
+            // precompute A + A'
+            grb::Matrix<RealT> ApAT(A);
+            grb::transpose(ApAT, grb::NoMask(),
+                           grb::Plus<RealT>(), A);
+
+            // k = A * vec(1)  (arithmetric row reduce of adj. matrix)
+            grb::Vector<RealT> k(n);
+            grb::reduce(k, grb::NoMask(), grb::NoAccumulate(),
+                        grb::Plus<RealT>(), A);
+
+            // m = 0.5*k'*vec(1) (reduce k to scalar)
+            RealT m(0);
+            grb::reduce(m, grb::NoAccumulate(),
+                        grb::PlusMonoid<RealT>(), k);
+            m = m/2.0;
+            if (m == 0)
             {
-                // only perform the iteration if the ith vertex is not isolated
-                if (k.hasElement(i))
-                {
-                    //std::cout << "====== Start of vertex " << i << std::endl;
-
-                    // s_i = S[i,:]
-                    grb::extract(S_row, grb::NoMask(),
-                                 grb::NoAccumulate(),
-                                 grb::transpose(S),
-                                 grb::AllIndices(), i);
-
-                    // S := (I - e_i*e_i')S means clear i-th row of S (using a mask)
-                    grb::Matrix<bool> Mask(rows, rows);
-                    grb::assign(Mask, grb::NoMask(),
-                                grb::NoAccumulate(),
-                                mask, i, grb::AllIndices());
-
-                    grb::apply(S, grb::complement(Mask),
-                               grb::NoAccumulate(),
-                               grb::Identity<bool>(),
-                               S, grb::REPLACE);
-
-                    // v' = e_i' * (A + A') == extract row i of (A + A')
-                    grb::extract(v, grb::NoMask(),
-                                 grb::NoAccumulate(),
-                                 grb::transpose(ApAT),
-                                 grb::AllIndices(), i);
-
-                    // v' += (-k_i/m)*k'
-                    grb::apply(
-                        v, grb::NoMask(),
-                        grb::Plus<RealT>(),
-                        std::bind(grb::Times<RealT>(),
-                                  std::placeholders::_1,
-                                  static_cast<RealT>(-k.extractElement(i)/m)),
-                        k);
-
-                    // ============= MASKING =============
-                    // find mask of communities that are neighbors of vertex i
-
-                    // Extract the neighbors of vertex i as bools
-                    /// @todo figure out if extract can be done once (note different domain)
-                    grb::extract(q_mask, grb::NoMask(),
-                                 grb::NoAccumulate(),
-                                 grb::transpose(ApAT),  // transpose optional
-                                 grb::AllIndices(), i);
-
-                    // Compute q_mask' = (row i of A+A') * S
-                    grb::vxm(q_mask, grb::NoMask(), grb::NoAccumulate(),
-                             grb::LogicalSemiring<bool>(), q_mask, S);
-
-                    //grb::print_matrix(std::cout, Sprime, "filtered community matrix");
-                    grb::vxm(q, q_mask, //grb::NoMask(),
-                             grb::NoAccumulate(),
-                             grb::ArithmeticSemiring<RealT>(),
-                             v, S, grb::REPLACE);
-                    //v, Sprime);
-                    // ============= MASKING =============
-
-                    //grb::print_vector(
-                    //    std::cout, q, "q'<mask> = [e_i' * (A + A') + (-k_i/m)*k'] * S");
-
-                    // kappa = max(q)
-                    RealT kappa(0);
-                    grb::reduce(kappa, grb::NoAccumulate(),
-                                grb::MaxMonoid<RealT>(), q);
-                    //std::cout << "kappa = " << kappa << std::endl;
-
-                    // t = (q == kappa)
-                    grb::apply(t, grb::NoMask(),
-                               grb::NoAccumulate(),
-                               std::bind(grb::Equal<RealT>(),
-                                         std::placeholders::_1,
-                                         kappa),
-                               q);
-
-                    // remove all stored falses (TODO: Replace with GxB_select?)
-                    grb::apply(t, t, grb::NoAccumulate(),
-                               grb::Identity<T>(), t, grb::REPLACE);
-                    //grb::print_vector(
-                    //    std::cout, t, "t = (q == kappa), with zeros removed");
-
-                    // break ties if necessary
-                    while (t.nvals() != 1)
-                    {
-                        //std::cout << "breaking ties: t.nvals() = "
-                        //          << t.nvals() << std::endl;
-
-                        // Assign a random number to each possible cluster
-                        grb::Vector<RealT> p(rows);
-                        grb::apply(p, grb::NoMask(),
-                                   grb::NoAccumulate(),
-                                   [&](bool tval)      //set_random,
-                                   {
-                                       return static_cast<RealT>(
-                                           tval*distribution(generator) + 0.0001);
-                                   },
-                                   t);
-                        // max_p = max(p)
-                        RealT max_p(0);
-                        grb::reduce(max_p, grb::NoAccumulate(),
-                                    grb::MaxMonoid<RealT>(), p);
-
-                        // t = (q == kappa)
-                        grb::apply(t, grb::NoMask(),
-                                   grb::NoAccumulate(),
-                                   std::bind(grb::Equal<RealT>(),
-                                             std::placeholders::_1,
-                                             max_p),
-                                   p);
-                        // remove all stored falses (TODO: Replace with GxB_select?)
-                        grb::apply(t, t, grb::NoAccumulate(),
-                                   grb::Identity<T>(), t,
-                                   grb::REPLACE);
-
-                        //grb::print_vector(
-                        //    std::cout, t, "new t after breaking ties");
-                    }
-
-                    // Replace row i of S with t
-                    grb::assign(S, grb::NoMask(),
-                                grb::NoAccumulate(),
-                                t, i, grb::AllIndices());
+                break;
+            }
 
-                    // Compare new community w/ previous community to
-                    // see if it has changed
-                    if (t != S_row) // vertex changed communities
-                    {
-                        vertices_changed = true;
-                        //grb::print_matrix(
-                        //    std::cout, S, "*** changed cluster assignments, S ***");
-                    }
-                    else
-                    {
-                        //std::cout<< "No change. "<< std::endl;
-                    }
-                }
-                //std::cout << "====== End   of vertex " << i << std::endl;
+            auto S(grb::scaled_identity<grb::Matrix<bool>>(n));
+            if (!louvain_local_moving(ApAT, k, m, S, only_neighbors,
+                                      generator, max_iters))
+            {
+                break;
             }
 
-            //std::cout << "====== End   of     outer iteration ======" << std::endl;
-            //auto cluster_assignments =
-            //    algorithms::get_louvain_cluster_assignments(S);
-            //print_vector(std::cout, cluster_assignments, "cluster assignments");
+            // Relabel the non-empty communities 0..C-1: S := S * P
+            grb::Vector<bool> used(n);
+            grb::reduce(used, grb::NoMask(), grb::NoAccumulate(),
+                        grb::LogicalOr<bool>(), grb::transpose(S));
+            grb::IndexType num_comms(used.nvals());
+            grb::IndexArrayType comm_ids(num_comms), new_ids(num_comms);
+            std::vector<bool> used_vals(num_comms);
+            used.extractTuples(comm_ids, used_vals);
+            for (grb::IndexType ix = 0; ix < num_comms; ++ix)
+            {
+                new_ids[ix] = ix;
+            }
+            grb::Matrix<bool> P(n, num_comms);
+            P.build(comm_ids, new_ids, used_vals);
+
+            grb::Matrix<bool> S_comms(n, num_comms);
+            grb::mxm(S_comms, grb::NoMask(), grb::NoAccumulate(),
+                     grb::LogicalSemiring<bool>(), S, P);
+
+            // Compose with the assignments from the previous levels
+            grb::Matrix<bool> S_next(rows, num_comms);
+            grb::mxm(S_next, grb::NoMask(), grb::NoAccumulate(),
+                     grb::LogicalSemiring<bool>(), S_total, S_comms);
+            S_total.resize(rows, num_comms);
+            S_total = S_next;
+
+            // Coarsen the graph: A := S' * A * S
+            grb::Matrix<RealT> AS(n, num_comms);
+            grb::mxm(AS, grb::NoMask(), grb::NoAccumulate(),
+                     grb::ArithmeticSemiring<RealT>(), A, S_comms);
+            A.resize(num_comms, num_comms);
+            grb::mxm(A, grb::NoMask(), grb::NoAccumulate(),
+                     grb::ArithmeticSemiring<RealT>(),
+                     grb::transpose(S_comms), AS, grb::REPLACE);
+
+            if (num_comms == n)
+            {
+                break;
+            }
+        }
 
-            ++iters;
-        } while (vertices_changed && iters < max_iters);
+        S_total.resize(rows, rows);
+        return S_total;
+    }
 
-        if (vertices_changed)
-            throw iters;
+    //************************************************************************
+    /**
+     * @brief Compute the clusters in the given graph using louvain clustering.
+     *
+     * @param[in]  graph    The graph to compute the clusters on.  Can be a
+     *                         weighted graph.
+     * @param[in]  random_seed The seed for the RNG for tie breaking
+     * @param[in]  max_iters   The maximum number of iterations to run if
+     *                         convergence doesn't occur first (uncommon)
+     * @param[in]  max_levels  The maximum number of aggregation levels
+     *
+     * @return A matrix whose columns correspond to the vertices, and vertices
+     *         with the same (max) value in a given row belong to the
+     *         same cluster.
+     */
+    template<typename MatrixT, typename RealT=double>
+    grb::Matrix<bool> louvain_cluster(
+        MatrixT const &graph,
+        double         random_seed = 11.0, // arbitrary
+        unsigned int   max_iters = std::numeric_limits<unsigned int>::max(),
+        unsigned int   max_levels = std::numeric_limits<unsigned int>::max())
+    {
+        return louvain_cluster_levels<MatrixT, RealT>(
+            graph, false, random_seed, max_iters, max_levels);
+    }
 
-        //grb::print_matrix(
-        //    std::cout, S, "Final cluster assignments, S");
-        return S;
+    //************************************************************************
+    /**
+     * @brief Compute the clusters in the given graph using louvain clustering
+     *        and applying an mask to the clusters considered.
+     *
+     * Only the communities of a vertex's neighbors are considered as
+     * destinations, so each vertex visit costs O(degree).
+     *
+     * @param[in]  graph    The graph to compute the clusters on.  Can be a
+     *                         weighted graph.
+     * @param[in]  random_seed The seed for the RNG for tie breaking
+     * @param[in]  max_iters   The maximum number of iterations to run if
+     *                         convergence doesn't occur first (uncommon)
+     * @param[in]  max_levels  The maximum number of aggregation levels
+     *
+     * @return A matrix whose columns correspond to the vertices, and vertices
+     *         with the same (max) value in a given row belong to the
+     *         same cluster.
+     */
+    template<typename MatrixT, typename RealT=double>
+    grb::Matrix<bool> louvain_cluster_masked(
+        MatrixT const &graph,
+        double         random_seed = 11.0, // arbitrary
+        unsigned int   max_iters = std::numeric_limits<unsigned int>::max(),
+        unsigned int   max_levels = std::numeric_limits<unsigned int>::max())
+    {
+        return louvain_cluster_levels<MatrixT, RealT>(
+            graph, true, random_seed, max_iters, max_levels);
     }
 
 } // algorithms
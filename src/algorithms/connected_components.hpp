@@ -0,0 +1,303 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+//****************************************************************************
+namespace algorithms
+{
+    //************************************************************************
+    /**
+     * @brief Min over vertex IDs, except that the 'preferred' ID is ordered
+     *        before all others (used by Afforest to keep the label of the
+     *        largest component fixed).
+     */
+    struct PreferredMin
+    {
+        grb::IndexType preferred;
+
+        bool less(grb::IndexType a, grb::IndexType b) const
+        {
+            if (a == preferred) return (b != preferred);
+            if (b == preferred) return false;
+            return (a < b);
+        }
+
+        grb::IndexType operator()(grb::IndexType a, grb::IndexType b) const
+        {
+            return less(b, a) ? b : a;
+        }
+    };
+
+    /// (PreferredMin, Second) semiring: the min parent over the neighbors
+    template <typename D1>
+    struct PreferredMinSecondSemiring
+    {
+        using first_argument_type  = D1;
+        using second_argument_type = grb::IndexType;
+        using result_type          = grb::IndexType;
+
+        PreferredMin min_op;
+
+        grb::IndexType add(grb::IndexType a, grb::IndexType b) const
+        { return min_op(a, b); }
+
+        grb::IndexType mult(D1, grb::IndexType b) const { return b; }
+
+        grb::IndexType zero() const
+        { return std::numeric_limits<grb::IndexType>::max(); }
+    };
+
+    //************************************************************************
+    /**
+     * @brief The FastSV iteration: hook and shortcut the parent forest until
+     *        the grandparents stop changing.
+     *
+     * On return every vertex points directly at the root of its tree, which
+     * is the minimum vertex ID of its component (under PreferredMin).
+     *
+     * @param[in]     graph      NxN symmetric adjacency matrix
+     * @param[in,out] parents    Dense N-vector parent forest (initially the
+     *                           identity, or the result of a previous pass)
+     * @param[in]     mask       Only the rows (vertices) in the mask hook
+     *                           across their edges.  Every edge must have at
+     *                           least one endpoint in the mask, or have both
+     *                           endpoints in the same tree already.
+     * @param[in]     preferred  Vertex ID ordered before all others (pass N
+     *                           for the plain minimum).
+     */
+    template <typename MatrixT, typename MaskT>
+    void fastsv(MatrixT const                  &graph,
+                grb::Vector<grb::IndexType>    &parents,
+                MaskT                    const &mask,
+                grb::IndexType                  preferred)
+    {
+        using T = typename MatrixT::ScalarType;
+        grb::IndexType N(graph.nrows());
+
+        PreferredMin min_op{preferred};
+        PreferredMinSecondSemiring<T> min_second{min_op};
+
+        grb::IndexArrayType f_idx(N), f_vals(N);
+        parents.extractTuples(f_idx, f_vals);
+
+        // gp = f[f]
+        grb::Vector<grb::IndexType> gp(N), mngp(N);
+        grb::extract(gp, grb::NoMask(), grb::NoAccumulate(),
+                     parents, f_vals);
+
+        grb::IndexArrayType mngp_idx, mngp_vals;
+        while (true)
+        {
+            // mngp = min grandparent over each vertex's neighbors
+            grb::mxv(mngp, mask, grb::NoAccumulate(), min_second,
+                     graph, gp, grb::REPLACE);
+
+            // stochastic hooking: f[f[u]] = min(f[f[u]], mngp[u])
+            mngp_idx.resize(mngp.nvals());
+            mngp_vals.resize(mngp.nvals());
+            mngp.extractTuples(mngp_idx, mngp_vals);
+            for (grb::IndexType ix = 0; ix < mngp_idx.size(); ++ix)
+            {
+                grb::IndexType parent(f_vals[mngp_idx[ix]]);
+                if (min_op.less(mngp_vals[ix],
+                                parents.extractElement(parent)))
+                {
+                    parents.setElement(parent, mngp_vals[ix]);
+                }
+            }
+
+            // aggressive hooking: f = min(f, mngp)
+            grb::eWiseAdd(parents, grb::NoMask(), grb::NoAccumulate(),
+                          min_op, parents, mngp);
+
+            // shortcutting: f = min(f, gp)
+            grb::eWiseAdd(parents, grb::NoMask(), grb::NoAccumulate(),
+                          min_op, parents, gp);
+
+            // pointer jumping: gp = f[f]
+            parents.extractTuples(f_idx, f_vals);
+            grb::Vector<grb::IndexType> new_gp(N);
+            grb::extract(new_gp, grb::NoMask(), grb::NoAccumulate(),
+                         parents, f_vals);
+
+            if (new_gp == gp)
+            {
+                break;
+            }
+            gp = new_gp;
+        }
+
+        // flatten so every vertex points at its root
+        parents = gp;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Compute the connected components of an undirected graph with
+     *        the FastSV algorithm (Zhang, Azad and Hu, 2020).
+     *
+     * @param[in]  graph   NxN adjacency matrix of an undirected graph (the
+     *                     matrix must be symmetric).
+     * @param[out] labels  N-vector holding, for each vertex, the smallest
+     *                     vertex ID in its component.
+     */
+    template <typename MatrixT>
+    void connected_components(MatrixT const               &graph,
+                              grb::Vector<grb::IndexType> &labels)
+    {
+        grb::IndexType N(graph.nrows());
+        if ((graph.ncols() != N) || (labels.size() != N))
+        {
+            throw grb::DimensionException();
+        }
+
+        grb::IndexArrayType ramp(N);
+        for (grb::IndexType ix = 0; ix < N; ++ix)
+        {
+            ramp[ix] = ix;
+        }
+        labels.clear();
+        labels.build(ramp, ramp);
+
+        fastsv(graph, labels, grb::NoMask(), N);
+    }
+
+    //************************************************************************
+    /**
+     * @brief Compute the connected components of an undirected graph with
+     *        Afforest style subgraph sampling (Sutton et al., 2018).
+     *
+     *  - The first neighbor_rounds neighbors of every vertex are linked
+     *    (FastSV on the sampled subgraph).
+     *  - The most common label among num_samples random vertices is taken as
+     *    the (likely) giant component.
+     *  - FastSV finishes on the full graph with the giant component's label
+     *    ordered first, skipping the rows of its vertices: each of their
+     *    remaining edges is seen from the other endpoint.
+     *
+     * @param[in]  graph            NxN adjacency matrix of an undirected
+     *                              graph (the matrix must be symmetric).
+     * @param[out] labels           N-vector holding, for each vertex, the ID
+     *                              of a representative vertex of its
+     *                              component.
+     * @param[in]  neighbor_rounds  Number of neighbors per vertex to sample
+     * @param[in]  num_samples      Number of vertices sampled to find the
+     *                              giant component
+     * @param[in]  random_seed      The seed for the sampling RNG
+     */
+    template <typename MatrixT>
+    void connected_components_afforest(
+        MatrixT const               &graph,
+        grb::Vector<grb::IndexType> &labels,
+        unsigned int                 neighbor_rounds = 2,
+        grb::IndexType               num_samples = 1024,
+        double                       random_seed = 11.0)
+    {
+        using T = typename MatrixT::ScalarType;
+
+        grb::IndexType N(graph.nrows());
+        if ((graph.ncols() != N) || (labels.size() != N))
+        {
+            throw grb::DimensionException();
+        }
+
+        grb::IndexArrayType ramp(N);
+        for (grb::IndexType ix = 0; ix < N; ++ix)
+        {
+            ramp[ix] = ix;
+        }
+        labels.clear();
+        labels.build(ramp, ramp);
+
+        // Subgraph of the first neighbor_rounds neighbors of each vertex
+        // (tuples come out in row major order), symmetrized.
+        grb::IndexArrayType rows(graph.nvals()), cols(graph.nvals());
+        std::vector<T>      vals(graph.nvals());
+        graph.extractTuples(rows, cols, vals);
+
+        grb::IndexArrayType s_rows, s_cols;
+        unsigned int count(0);
+        for (grb::IndexType ix = 0; ix < rows.size(); ++ix)
+        {
+            if ((ix > 0) && (rows[ix] != rows[ix - 1]))
+            {
+                count = 0;
+            }
+            if ((rows[ix] != cols[ix]) && (count < neighbor_rounds))
+            {
+                s_rows.push_back(rows[ix]); s_cols.push_back(cols[ix]);
+                s_rows.push_back(cols[ix]); s_cols.push_back(rows[ix]);
+                ++count;
+            }
+        }
+        rows.clear(); rows.shrink_to_fit();
+        cols.clear(); cols.shrink_to_fit();
+        vals.clear(); vals.shrink_to_fit();
+
+        {
+            grb::Matrix<bool> sampled(N, N);
+            sampled.build(s_rows, s_cols, std::vector<bool>(s_rows.size(), true),
+                          grb::LogicalOr<bool>());
+            fastsv(sampled, labels, grb::NoMask(), N);
+        }
+
+        // Find the most frequent label in a random sample of vertices
+        std::default_random_engine generator;
+        generator.seed(random_seed);
+        std::uniform_int_distribution<grb::IndexType> vertex(0, N - 1);
+        std::unordered_map<grb::IndexType, grb::IndexType> frequency;
+        grb::IndexType giant(N), giant_count(0);
+        for (grb::IndexType ix = 0; (N > 0) && (ix < num_samples); ++ix)
+        {
+            grb::IndexType label(labels.extractElement(vertex(generator)));
+            grb::IndexType label_count(++frequency[label]);
+            if (label_count > giant_count)
+            {
+                giant = label;
+                giant_count = label_count;
+            }
+        }
+
+        // Finish on the full graph, skipping the giant component's rows
+        grb::Vector<bool> in_giant(N);
+        grb::apply(in_giant, grb::NoMask(), grb::NoAccumulate(),
+                   std::bind(grb::Equal<grb::IndexType>(),
+                             std::placeholders::_1, giant),
+                   labels);
+        fastsv(graph, labels, grb::complement(in_giant), giant);
+    }
+} // algorithms
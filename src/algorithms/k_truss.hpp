@@ -27,8 +27,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <tuple>
+#include <vector>
 
 #include <graphblas/graphblas.hpp>
 
@@ -77,6 +80,104 @@ namespace
             return !LessT()(val, m_threshold);  // val >= threshold
         }
     };
+
+    //************************************************************************
+    /**
+     * Remove every edge of the symmetric pattern A whose support in S is
+     * below min_support, starting from the given candidate edges.  After
+     * each round of removals R, only the supports of edges that shared a
+     * triangle with an edge of R are updated:
+     *
+     *   dS(i,j) = (R +.* A_old)(i,j) + (R +.* A_new)(j,i)
+     *
+     * which counts each lost triangle once, and only those edges become
+     * candidates for the next round.  on_remove(i,j) is called for each
+     * removed edge (both directions).
+     */
+    template <typename AMatrixT, typename SMatrixT, typename RemoveFnT>
+    void peel_low_support_edges(AMatrixT                  &A,
+                                SMatrixT                  &S,
+                                grb::IndexType             min_support,
+                                grb::IndexArrayType        cand_rows,
+                                grb::IndexArrayType        cand_cols,
+                                RemoveFnT                  on_remove)
+    {
+        using T = typename SMatrixT::ScalarType;
+        grb::IndexType num_vertices(A.nrows());
+
+        grb::IndexArrayType r_rows, r_cols;
+        std::vector<std::tuple<grb::IndexType, grb::IndexType>> removed;
+        grb::IndexArrayType x_rows, x_cols;
+        std::vector<T>      x_vals;
+
+        while (!cand_rows.empty())
+        {
+            // R = candidate edges lacking support (each edge once, i < j)
+            removed.clear();
+            for (grb::IndexType idx = 0; idx < cand_rows.size(); ++idx)
+            {
+                grb::IndexType i(std::min(cand_rows[idx], cand_cols[idx]));
+                grb::IndexType j(std::max(cand_rows[idx], cand_cols[idx]));
+                if (!A.hasElement(i, j)) continue;
+
+                T support(S.hasElement(i, j) ? S.extractElement(i, j) : 0);
+                if (support < static_cast<T>(min_support))
+                {
+                    removed.emplace_back(i, j);
+                }
+            }
+            std::sort(removed.begin(), removed.end());
+            removed.erase(std::unique(removed.begin(), removed.end()),
+                          removed.end());
+            if (removed.empty()) break;
+
+            r_rows.clear(); r_cols.clear();
+            for (auto const &[i, j] : removed)
+            {
+                r_rows.push_back(i); r_cols.push_back(j);
+                r_rows.push_back(j); r_cols.push_back(i);
+            }
+            SMatrixT R(num_vertices, num_vertices);
+            R.build(r_rows, r_cols, std::vector<T>(r_rows.size(), 1));
+
+            // X = R +.* A_old
+            SMatrixT X(num_vertices, num_vertices);
+            grb::mxm(X, grb::NoMask(), grb::NoAccumulate(),
+                     grb::ArithmeticSemiring<T>(), R, A);
+
+            for (grb::IndexType idx = 0; idx < r_rows.size(); ++idx)
+            {
+                A.removeElement(r_rows[idx], r_cols[idx]);
+                S.removeElement(r_rows[idx], r_cols[idx]);
+                on_remove(r_rows[idx], r_cols[idx]);
+            }
+
+            // Y = R +.* A_new, applied transposed
+            SMatrixT Y(num_vertices, num_vertices);
+            grb::mxm(Y, grb::NoMask(), grb::NoAccumulate(),
+                     grb::ArithmeticSemiring<T>(), R, A);
+
+            cand_rows.clear(); cand_cols.clear();
+            auto update = [&](SMatrixT const &D, bool transposed)
+            {
+                grb::IndexType nvals(D.nvals());
+                x_rows.resize(nvals); x_cols.resize(nvals); x_vals.resize(nvals);
+                D.extractTuples(x_rows, x_cols, x_vals);
+                for (grb::IndexType idx = 0; idx < nvals; ++idx)
+                {
+                    grb::IndexType i(transposed ? x_cols[idx] : x_rows[idx]);
+                    grb::IndexType j(transposed ? x_rows[idx] : x_cols[idx]);
+                    if (!A.hasElement(i, j)) continue;
+
+                    S.setElement(i, j, S.extractElement(i, j) - x_vals[idx]);
+                    cand_rows.push_back(i);
+                    cand_cols.push_back(j);
+                }
+            };
+            update(X, false);
+            update(Y, true);
+        }
+    }
 }
 
 //****************************************************************************
@@ -319,4 +420,139 @@ namespace algorithms
         return A;
     }
 
+    //************************************************************************
+    /**
+     * @brief Compute the k-truss of an undirected graph, updating edge
+     *        supports incrementally.
+     *
+     * The support of every edge is computed once; afterwards removing an
+     * edge only updates the supports of the edges that shared a triangle
+     * with it, instead of recomputing (A' +.* A) .* A every round.
+     *
+     * @param[in] Ain     Symmetric adjacency matrix (structure only is used)
+     * @param[in] k_size  The k of the k-truss (k >= 2)
+     *
+     * @return The entries of Ain that belong to the k-truss.
+     */
+    template<typename AMatrixT>
+    AMatrixT k_truss_incremental(AMatrixT const &Ain,
+                                 grb::IndexType  k_size)
+    {
+        grb::IndexType num_vertices(Ain.nrows());
+        if (num_vertices != Ain.ncols())
+        {
+            throw grb::DimensionException("k_truss_incremental");
+        }
+
+        grb::IndexType nvals(Ain.nvals());
+        grb::IndexArrayType rows(nvals), cols(nvals);
+        std::vector<typename AMatrixT::ScalarType> vals(nvals);
+        Ain.extractTuples(rows, cols, vals);
+
+        grb::Matrix<grb::IndexType> A(num_vertices, num_vertices);
+        A.build(rows, cols, std::vector<grb::IndexType>(nvals, 1));
+
+        // S<A> = (A' +.* A)
+        grb::Matrix<grb::IndexType> S(num_vertices, num_vertices);
+        grb::mxm(S, A, grb::NoAccumulate(),
+                 grb::ArithmeticSemiring<grb::IndexType>(),
+                 grb::transpose(A), A, grb::REPLACE);
+
+        grb::IndexType min_support((k_size > 2) ? k_size - 2 : 0);
+        peel_low_support_edges(A, S, min_support, rows, cols,
+                               [](grb::IndexType, grb::IndexType) {});
+
+        AMatrixT Aout(num_vertices, num_vertices);
+        grb::apply(Aout, grb::structure(A), grb::NoAccumulate(),
+                   grb::Identity<typename AMatrixT::ScalarType>(), Ain,
+                   grb::REPLACE);
+        return Aout;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Compute the truss number of every edge of an undirected graph
+     *        in one run.
+     *
+     * The truss number of an edge is the largest k such that the edge is in
+     * the k-truss.  Edges are peeled level by level (k = 3, 4, ...) with
+     * incremental support updates; edges removed while peeling level k have
+     * truss number k-1.
+     *
+     * @param[in] Ain  Symmetric adjacency matrix (structure only is used)
+     *
+     * @return A matrix with the structure of Ain holding each edge's truss
+     *         number (2 for edges in no triangle).
+     */
+    template<typename AMatrixT>
+    grb::Matrix<grb::IndexType> truss_decomposition(AMatrixT const &Ain)
+    {
+        grb::IndexType num_vertices(Ain.nrows());
+        if (num_vertices != Ain.ncols())
+        {
+            throw grb::DimensionException("truss_decomposition");
+        }
+
+        grb::IndexType nvals(Ain.nvals());
+        grb::IndexArrayType rows(nvals), cols(nvals);
+        std::vector<typename AMatrixT::ScalarType> vals(nvals);
+        Ain.extractTuples(rows, cols, vals);
+
+        grb::Matrix<grb::IndexType> A(num_vertices, num_vertices);
+        A.build(rows, cols, std::vector<grb::IndexType>(nvals, 1));
+
+        grb::Matrix<grb::IndexType> S(num_vertices, num_vertices);
+        grb::mxm(S, A, grb::NoAccumulate(),
+                 grb::ArithmeticSemiring<grb::IndexType>(),
+                 grb::transpose(A), A, grb::REPLACE);
+
+        grb::IndexArrayType t_rows, t_cols;
+        std::vector<grb::IndexType> t_vals;
+        t_rows.reserve(nvals); t_cols.reserve(nvals); t_vals.reserve(nvals);
+
+        grb::IndexType k(3);
+        while (A.nvals() > 0)
+        {
+            // Only edges with support below k-2 can start a peel at level k
+            nvals = S.nvals();
+            grb::IndexArrayType s_rows(nvals), s_cols(nvals);
+            std::vector<grb::IndexType> s_vals(nvals);
+            S.extractTuples(s_rows, s_cols, s_vals);
+
+            grb::IndexArrayType cand_rows, cand_cols;
+            for (grb::IndexType idx = 0; idx < nvals; ++idx)
+            {
+                if (s_vals[idx] < k - 2)
+                {
+                    cand_rows.push_back(s_rows[idx]);
+                    cand_cols.push_back(s_cols[idx]);
+                }
+            }
+            if (k == 3)
+            {
+                // edges in no triangle have no stored support
+                nvals = A.nvals();
+                rows.resize(nvals); cols.resize(nvals);
+                std::vector<grb::IndexType> a_vals(nvals);
+                A.extractTuples(rows, cols, a_vals);
+                cand_rows.insert(cand_rows.end(), rows.begin(), rows.end());
+                cand_cols.insert(cand_cols.end(), cols.begin(), cols.end());
+            }
+
+            peel_low_support_edges(
+                A, S, k - 2, cand_rows, cand_cols,
+                [&](grb::IndexType i, grb::IndexType j)
+                {
+                    t_rows.push_back(i);
+                    t_cols.push_back(j);
+                    t_vals.push_back(k - 1);
+                });
+            ++k;
+        }
+
+        grb::Matrix<grb::IndexType> Truss(num_vertices, num_vertices);
+        Truss.build(t_rows, t_cols, t_vals);
+        return Truss;
+    }
+
 }
@@ -0,0 +1,248 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+//****************************************************************************
+namespace algorithms
+{
+    //************************************************************************
+    /**
+     * @brief Pattern of an undirected graph without self loops, holding 1
+     *        for every edge.  Used by the k-core algorithms so that weights
+     *        and self loops do not count towards a vertex's degree.
+     */
+    template<typename MatrixT>
+    grb::Matrix<grb::IndexType> kcore_pattern(MatrixT const &graph)
+    {
+        grb::IndexType n(graph.nrows());
+        if (n != graph.ncols())
+        {
+            throw grb::DimensionException("kcore: graph must be square");
+        }
+
+        grb::IndexType nvals(graph.nvals());
+        grb::IndexArrayType rows(nvals), cols(nvals);
+        std::vector<typename MatrixT::ScalarType> vals(nvals);
+        graph.extractTuples(rows, cols, vals);
+
+        grb::IndexArrayType i, j;
+        i.reserve(nvals); j.reserve(nvals);
+        for (grb::IndexType idx = 0; idx < nvals; ++idx)
+        {
+            if (rows[idx] != cols[idx])
+            {
+                i.push_back(rows[idx]);
+                j.push_back(cols[idx]);
+            }
+        }
+
+        grb::Matrix<grb::IndexType> A(n, n);
+        A.build(i, j, std::vector<grb::IndexType>(i.size(), 1));
+        return A;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Compute the core number of every vertex of an undirected graph.
+     *
+     * The core number of v is the largest k such that v belongs to a
+     * subgraph in which every vertex has degree >= k.  Vertices are peeled
+     * in order of current degree using a bucket queue (one list per degree,
+     * with stale entries skipped).  At level k all vertices of degree <= k
+     * are peeled as a batch, and one masked vxm over the still-alive
+     * vertices counts how many neighbors each lost, so only vertices whose
+     * degree changed are re-bucketed.
+     *
+     * @param[in]  graph  Symmetric adjacency matrix (self loops ignored).
+     * @param[out] core   core[v] = core number of v (every element stored).
+     */
+    template<typename MatrixT>
+    void kcore(MatrixT const               &graph,
+               grb::Vector<grb::IndexType> &core)
+    {
+        grb::IndexType n(graph.nrows());
+        if (core.size() != n)
+        {
+            throw grb::DimensionException("kcore: core.size() != nrows");
+        }
+
+        auto A(kcore_pattern(graph));
+
+        // deg = A +. (row nvals counts of the pattern)
+        std::vector<grb::IndexType> deg(A.degreeStats().row_degrees);
+        grb::IndexType max_deg(A.degreeStats().max_row_degree);
+        std::vector<grb::IndexArrayType> buckets(max_deg + 1);
+        for (grb::IndexType v = 0; v < n; ++v)
+        {
+            buckets[deg[v]].push_back(v);
+        }
+
+        std::vector<bool> alive(n, true);
+        grb::Vector<bool> alive_vec(std::vector<bool>(n, true));
+
+        grb::IndexArrayType core_idx, core_vals;
+        core_idx.reserve(n); core_vals.reserve(n);
+
+        grb::Vector<grb::IndexType> peel(n), lost(n);
+        grb::IndexArrayType frontier, next;
+        grb::IndexArrayType idx;
+        std::vector<grb::IndexType> vals;
+
+        for (grb::IndexType k = 0; (core_idx.size() < n) && (k <= max_deg); ++k)
+        {
+            // everything still alive has degree >= k here; take degree k
+            frontier.clear();
+            for (auto v : buckets[k])
+            {
+                if (alive[v] && (deg[v] == k))
+                {
+                    frontier.push_back(v);
+                }
+            }
+            grb::IndexArrayType().swap(buckets[k]);
+
+            while (!frontier.empty())
+            {
+                for (auto v : frontier)
+                {
+                    alive[v] = false;
+                    alive_vec.removeElement(v);
+                    core_idx.push_back(v);
+                    core_vals.push_back(k);
+                }
+
+                // lost<alive,z> = peel +.* A
+                peel.clear();
+                peel.build(frontier,
+                           std::vector<grb::IndexType>(frontier.size(), 1));
+                grb::vxm(lost, alive_vec, grb::NoAccumulate(),
+                         grb::ArithmeticSemiring<grb::IndexType>(),
+                         peel, A, grb::REPLACE);
+
+                idx.resize(lost.nvals()); vals.resize(lost.nvals());
+                lost.extractTuples(idx, vals);
+
+                next.clear();
+                for (grb::IndexType ix = 0; ix < idx.size(); ++ix)
+                {
+                    grb::IndexType u(idx[ix]);
+                    deg[u] -= vals[ix];
+                    if (deg[u] <= k)
+                    {
+                        deg[u] = k;
+                        next.push_back(u);
+                    }
+                    else
+                    {
+                        buckets[deg[u]].push_back(u);
+                    }
+                }
+                frontier.swap(next);
+            }
+        }
+
+        core.clear();
+        core.build(core_idx, core_vals);
+    }
+
+    //************************************************************************
+    /**
+     * @brief Compute the core number of every vertex of an undirected graph
+     *        using only whole-vector operations.
+     *
+     * Same peeling as kcore, but the batch at each step is selected with
+     * an apply over the degree vector instead of a bucket queue, so every
+     * step is a data-parallel vector operation or one masked vxm.  The
+     * level jumps directly to the minimum degree of the remaining vertices.
+     *
+     * @param[in]  graph  Symmetric adjacency matrix (self loops ignored).
+     * @param[out] core   core[v] = core number of v (every element stored).
+     */
+    template<typename MatrixT>
+    void kcore_batched(MatrixT const               &graph,
+                       grb::Vector<grb::IndexType> &core)
+    {
+        grb::IndexType n(graph.nrows());
+        if (core.size() != n)
+        {
+            throw grb::DimensionException("kcore_batched: core.size() != nrows");
+        }
+
+        auto A(kcore_pattern(graph));
+
+        // deg = cached row degrees of A (explicit zeros for isolated vertices)
+        grb::Vector<grb::IndexType> deg(A.degreeStats().row_degrees);
+
+        grb::Vector<bool> alive(std::vector<bool>(n, true));
+        grb::Vector<bool> peel(n);
+        grb::Vector<grb::IndexType> alive_deg(n), lost(n);
+
+        core.clear();
+        grb::IndexType k(0);
+        while (alive.nvals() > 0)
+        {
+            // k = max(k, min(deg<alive>))
+            grb::apply(alive_deg, alive, grb::NoAccumulate(),
+                       grb::Identity<grb::IndexType>(), deg, grb::REPLACE);
+            grb::IndexType min_deg(std::numeric_limits<grb::IndexType>::max());
+            grb::reduce(min_deg, grb::NoAccumulate(),
+                        grb::MinMonoid<grb::IndexType>(), alive_deg);
+            k = std::max(k, min_deg);
+
+            // peel<alive,z> = (deg <= k)
+            grb::apply(peel, alive, grb::NoAccumulate(),
+                       std::bind(grb::LessEqual<grb::IndexType>(),
+                                 std::placeholders::_1, k),
+                       deg, grb::REPLACE);
+            grb::apply(peel, peel, grb::NoAccumulate(),
+                       grb::Identity<bool>(), peel, grb::REPLACE);
+
+            // core<peel> = k
+            grb::assign(core, peel, grb::NoAccumulate(),
+                        k, grb::AllIndices());
+
+            // alive<!peel,z> = alive
+            grb::apply(alive, grb::complement(peel), grb::NoAccumulate(),
+                       grb::Identity<bool>(), alive, grb::REPLACE);
+
+            // lost<alive,z> = peel +.* A;  deg -= lost
+            grb::vxm(lost, alive, grb::NoAccumulate(),
+                     grb::ArithmeticSemiring<grb::IndexType>(),
+                     peel, A, grb::REPLACE);
+            grb::eWiseAdd(deg, grb::NoMask(), grb::NoAccumulate(),
+                          grb::Minus<grb::IndexType>(), deg, lost);
+        }
+    }
+} // algorithms
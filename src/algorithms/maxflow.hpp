@@ -27,107 +27,93 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
 #include <vector>
-#include <random>
 
 #include <graphblas/graphblas.hpp>
 
-//****************************************************************************
-// The following are hacks because algorithm assumes access to implicit zero
-// should return a value of zero.
-//
 namespace
 {
-    template <typename T>
-    T at(grb::Vector<T> const &v,
-         grb::IndexType        idx)
+    //************************************************************************
+    /// (Min, ResidualSecond) semiring: the minimum height (or BFS level)
+    /// over the neighbours reachable through a positive residual capacity.
+    template <typename D1>
+    struct MinResidualSecondSemiring
     {
-        return (v.hasElement(idx) ? v.extractElement(idx) : T(0));
-    }
+        using first_argument_type  = D1;
+        using second_argument_type = grb::IndexType;
+        using result_type          = grb::IndexType;
 
-    template <typename T, typename... TagsT>
-    T at(grb::Matrix<T, TagsT...> const &A,
-         grb::IndexType                  idx,
-         grb::IndexType                  idy)
-    {
-        return (A.hasElement(idx, idy) ? A.extractElement(idx, idy) : T(0));
-    }
-}
+        grb::IndexType add(grb::IndexType a, grb::IndexType b) const
+        { return std::min(a, b); }
 
-//****************************************************************************
-template <typename MatrixT, typename VectorT>
-static void push(MatrixT  const &C,
-                 MatrixT        &F,
-                 VectorT        &excess,
-                 grb::IndexType  u,
-                 grb::IndexType  v)
-{
-    using T = typename MatrixT::ScalarType;
-    T a = at(excess, u);
-    T b = at(C, u, v) - at(F, u, v);
-    T send = std::min(a, b);
+        grb::IndexType mult(D1 r, grb::IndexType b) const
+        { return (r > static_cast<D1>(0)) ? b : zero(); }
 
-    F.setElement(u, v, at(F, u, v) + send);
-    F.setElement(v, u, at(F, v, u) - send);
+        grb::IndexType zero() const
+        { return std::numeric_limits<grb::IndexType>::max(); }
+    };
 
-    excess.setElement(u, at(excess,u) - send);
-    excess.setElement(v, at(excess,v) + send);
-}
+    //************************************************************************
+    /**
+     * @brief Global relabel: set every height to the residual distance to
+     *        the sink (reverse BFS over the positive residual edges).
+     *
+     * Vertices that cannot reach the sink get height N (inactive).  The
+     * source is never relabelled.
+     */
+    template <typename T>
+    void maxflow_global_relabel(grb::Matrix<T>              const &R,
+                                grb::IndexType                     source,
+                                grb::IndexType                     sink,
+                                std::vector<grb::IndexType>       &height,
+                                grb::Vector<grb::IndexType>       &hvec)
+    {
+        grb::IndexType N(R.nrows());
+        MinResidualSecondSemiring<T> min_residual;
 
-//****************************************************************************
-template <typename MatrixT, typename VectorT>
-static void relabel(MatrixT  const &C,
-                    MatrixT  const &F,
-                    VectorT        &height,
-                    grb::IndexType  u)
-{
-    using T = typename MatrixT::ScalarType;
-    grb::IndexType num_nodes(C.nrows());
+        std::fill(height.begin(), height.end(), N);
+        height[sink] = 0;
 
-    T min_height = std::numeric_limits<T>::max();
-    for (grb::IndexType v = 0; v < num_nodes; ++v)
-    {
-        if ((at(C,u, v) - at(F,u, v)) > 0)
-        {
-            T a = at(height,v);
-            min_height = std::min(min_height, a);
-            height.setElement(u, min_height + 1);
-        }
-    }
-}
+        grb::Vector<bool> visited(N);
+        visited.setElement(source, true);
+        visited.setElement(sink, true);
 
-//****************************************************************************
-/// @todo Does seen have a different scalar type (IndexType)
-template <typename MatrixT, typename VectorT>
-static void discharge(MatrixT  const &C,
-                      MatrixT        &F,
-                      VectorT        &excess,
-                      VectorT        &height,
-                      VectorT        &seen,
-                      grb::IndexType  u)
-{
-    grb::IndexType num_nodes(C.nrows());
+        grb::Vector<grb::IndexType> frontier(N), next(N);
+        frontier.setElement(sink, 0);
 
-    while (at(excess,u) > 0)
-    {
-        if (at(seen,u) < num_nodes)
+        grb::IndexArrayType idx, vals;
+        for (grb::IndexType level = 1; frontier.nvals() > 0; ++level)
         {
-            grb::IndexType v = at(seen,u);
-            if (((at(C,u, v) - at(F,u, v)) > 0) &&
-                (at(height,u) > at(height,v)))
-            {
-                push(C, F, excess, u, v);
-            }
-            else
+            // next(v) = min over w in frontier with R(v,w) > 0
+            grb::mxv(next, grb::complement(grb::structure(visited)),
+                     grb::NoAccumulate(), min_residual, R, frontier,
+                     grb::REPLACE);
+
+            idx.resize(next.nvals());
+            vals.resize(next.nvals());
+            next.extractTuples(idx.begin(), vals.begin());
+
+            frontier.clear();
+            for (grb::IndexType ix = 0; ix < idx.size(); ++ix)
             {
-                seen.setElement(u, at(seen,u) + 1);
+                if (vals[ix] == min_residual.zero())
+                    continue;
+
+                height[idx[ix]] = level;
+                visited.setElement(idx[ix], true);
+                frontier.setElement(idx[ix], level);
             }
         }
-        else
-        {
-            relabel(C, F, height, u);
-            seen.setElement(u, 0);
-        }
+
+        height[source] = N;
+
+        hvec.clear();
+        grb::IndexArrayType all(N);
+        std::iota(all.begin(), all.end(), 0UL);
+        hvec.build(all, height);
     }
 }
 
@@ -139,27 +125,28 @@ namespace algorithms
      * @brief Compute the maximum flow through a graph given the capacities of
      *        the edges of that graph using a push-relabel algorithm
      *
+     * The residual capacities live in a single matrix R (R(u,v) = c(u,v) -
+     * f(u,v), with the reverse entries present from the start) so a push
+     * touches exactly one stored entry in each direction.  The algorithm
+     * runs in synchronous rounds over the frontier of active vertices:
+     *
      * <ul>
-     * <li>Using a push-relabel removes the need to calculate augmented paths
-     * (as in Ford Fulkerson)</li>
-     * <li>Better lent itself to an implementation using GraphBLAS
-     * functions.</li>
-     * </ul>
-     * <p>In this implementation, a preflow, which is an assignment of flows to
-     * edges allowing for more incoming flow than outcoming flow while
-     * maintaining capacity constraints, is maintained.</p>
-     * <ul>
-     * <li>Use the operation <code>push</code> to "push" flow through the flow
-     * network.</li>
-     * <li><code>relabel</code> maintains the residual network (the <i>residual
-     * network</i> is the network at the current iteration in the
-     * algorithm).</li>
-     * <li>These two operations can only be performed on active vertices at
-     * each iteration, where an <i>active</i> vertex is a vertex such that
-     * all edges in the residual graph that contain it only have positive
-     * excess flows.</li>
+     * <li>Push: the residual rows of the frontier are gathered at once
+     * (diag(frontier) * R) and each active vertex pushes its excess along
+     * its admissible edges (h(u) == h(v) + 1) using the heights at the start
+     * of the round.  All residual changes of the round are applied to R as
+     * one batch.</li>
+     * <li>Relabel: the vertices still holding excess take one more than the
+     * minimum height over their residual neighbours, computed for the whole
+     * frontier with a single masked (min, residual-second) mxv.</li>
+     * <li>Global relabel: heights are reset to the exact residual distance
+     * to the sink by a reverse BFS at the start and after every N relabels,
+     * which retires vertices that can no longer reach the sink.</li>
      * </ul>
      *
+     * Only the first phase (the maximum preflow) is computed: the value of
+     * the flow is the excess collected at the sink.
+     *
      * @param[in]  capacity  The capacity matrix of the edges of the graph to
      *                       compute the max flow through.
      * @param[in]  source    The vertex to use as the source.
@@ -167,9 +154,6 @@ namespace algorithms
      *
      * @return The value of the maximum flow that can be pushed through the
      *         source.
-     *
-     * @note This is not written in the philosphy of GraphBLAS and needs to
-     *       be replaced or removed.
      */
     template<typename MatrixT>
     typename MatrixT::ScalarType maxflow_push_relabel(MatrixT  const &capacity,
@@ -177,73 +161,191 @@ namespace algorithms
                                                       grb::IndexType  sink)
     {
         using T = typename MatrixT::ScalarType;
-        grb::IndexType rows(capacity.nrows());
-        grb::IndexType cols(capacity.ncols());
-
-        grb::IndexType num_nodes = rows;
-
-        MatrixT flow(rows,cols);
-
-        grb::Vector<T> height(num_nodes);
-        grb::Vector<T> excess(num_nodes);
-        grb::Vector<T> seen(num_nodes);
+        grb::IndexType num_nodes(capacity.nrows());
 
-        std::vector<grb::IndexType> list;
+        if (capacity.ncols() != num_nodes)
+        {
+            throw grb::DimensionException(
+                "maxflow_push_relabel: capacity matrix must be square");
+        }
+        if ((source >= num_nodes) || (sink >= num_nodes))
+        {
+            throw grb::IndexOutOfBoundsException(
+                "maxflow_push_relabel: source or sink out of bounds");
+        }
+        if (source == sink)
+        {
+            return static_cast<T>(0);
+        }
 
-        for (grb::IndexType i = 0; i < num_nodes; ++i)
+        // Residual matrix: c(u,v) plus an explicit (v,u) reverse entry
+        grb::IndexArrayType rows, cols;
+        std::vector<T> vals;
         {
-            if ((i != source) && (i != sink))
+            grb::IndexArrayType ci(capacity.nvals()), cj(capacity.nvals());
+            std::vector<T> cv(capacity.nvals());
+            capacity.extractTuples(ci, cj, cv);
+
+            for (grb::IndexType ix = 0; ix < ci.size(); ++ix)
             {
-                list.push_back(i);
+                if (ci[ix] == cj[ix])
+                    continue;
+
+                rows.push_back(ci[ix]);
+                cols.push_back(cj[ix]);
+                vals.push_back(cv[ix]);
+                rows.push_back(cj[ix]);
+                cols.push_back(ci[ix]);
+                vals.push_back(static_cast<T>(0));
             }
         }
+        grb::Matrix<T> R(num_nodes, num_nodes);
+        R.build(rows, cols, vals, grb::Plus<T>());
+
+        std::vector<T> excess(num_nodes, static_cast<T>(0));
+        std::vector<grb::IndexType> height(num_nodes, 0);
+        grb::Vector<grb::IndexType> hvec(num_nodes);
 
-        height.setElement(source, num_nodes);
-        excess.setElement(source,
-                          std::numeric_limits<T>::max());
-        for (grb::IndexType i = 0; i < num_nodes; ++i)
+        grb::IndexArrayType ins_rows, ins_cols, no_del;
+        std::vector<T> ins_vals;
+
+        // Saturate every edge out of the source
+        for (grb::IndexType ix = 0; ix < rows.size(); ix += 2)
         {
-            push(capacity, flow, excess, source, i);
+            grb::IndexType v(cols[ix]);
+            if ((rows[ix] != source) || !(vals[ix] > static_cast<T>(0)))
+                continue;
+
+            excess[v] += vals[ix];
+            ins_rows.push_back(source);  ins_cols.push_back(v);
+            ins_vals.push_back(-vals[ix]);
+            ins_rows.push_back(v);       ins_cols.push_back(source);
+            ins_vals.push_back(vals[ix]);
         }
+        R.applyUpdates(ins_rows, ins_cols, ins_vals, no_del, no_del,
+                       grb::Plus<T>());
 
-        //grb::print_matrix(std::cerr, flow, "\nFLOW");
+        maxflow_global_relabel(R, source, sink, height, hvec);
 
-        grb::IndexType  p = 0;
-        while (p < (num_nodes - 2))
+        // The frontier is kept as a list plus a membership flag per vertex
+        std::vector<bool> in_frontier(num_nodes, false);
+        grb::IndexArrayType frontier, candidates;
+        auto is_active = [&](grb::IndexType u)
+            {
+                return ((u != source) && (u != sink) &&
+                        (excess[u] > static_cast<T>(0)) &&
+                        (height[u] < num_nodes));
+            };
+        auto rebuild_frontier = [&](grb::IndexArrayType const &cand)
+            {
+                for (auto u : frontier) in_frontier[u] = false;
+                frontier.clear();
+                for (auto u : cand)
+                {
+                    if (!in_frontier[u] && is_active(u))
+                    {
+                        in_frontier[u] = true;
+                        frontier.push_back(u);
+                    }
+                }
+            };
+
+        for (grb::IndexType u = 0; u < num_nodes; ++u)
+            candidates.push_back(u);
+        rebuild_frontier(candidates);
+
+        MinResidualSecondSemiring<T> min_residual;
+        grb::Matrix<T> D(num_nodes, num_nodes), Rf(num_nodes, num_nodes);
+        grb::Vector<bool> relabel_mask(num_nodes);
+        grb::Vector<grb::IndexType> min_height(num_nodes);
+        grb::IndexArrayType fi, fj;
+        std::vector<T> fv, ones;
+        grb::IndexType num_relabels(0);
+
+        while (!frontier.empty())
         {
-            grb::IndexType u = list[p];
-            T old_height = at(height, u);
-            discharge(capacity, flow, excess, height, seen, u);
-            //grb::print_matrix(std::cerr, flow, "\nFLOW after discharge");
-
-            if (at(height,u) > old_height)
+            // Push: gather the residual rows of the frontier
+            ones.assign(frontier.size(), static_cast<T>(1));
+            D.clear();
+            D.build(frontier, frontier, ones);
+            grb::mxm(Rf, grb::NoMask(), grb::NoAccumulate(),
+                     grb::ArithmeticSemiring<T>(), D, R, grb::REPLACE);
+
+            fi.resize(Rf.nvals());
+            fj.resize(Rf.nvals());
+            fv.resize(Rf.nvals());
+            Rf.extractTuples(fi, fj, fv);
+
+            candidates = frontier;
+            ins_rows.clear();  ins_cols.clear();  ins_vals.clear();
+            for (grb::IndexType ix = 0; ix < fi.size(); ++ix)
             {
-                grb::IndexType t = list[p];
-
-                list.erase(list.begin() + p);
-                list.insert(list.begin() + 0, t);
+                grb::IndexType u(fi[ix]), v(fj[ix]);
+                if (!(excess[u] > static_cast<T>(0)) ||
+                    !(fv[ix] > static_cast<T>(0)) ||
+                    (height[u] != height[v] + 1))
+                {
+                    continue;
+                }
+
+                T amount(std::min(excess[u], fv[ix]));
+                excess[u] -= amount;
+                excess[v] += amount;
+                ins_rows.push_back(u);  ins_cols.push_back(v);
+                ins_vals.push_back(-amount);
+                ins_rows.push_back(v);  ins_cols.push_back(u);
+                ins_vals.push_back(amount);
+                candidates.push_back(v);
+            }
+            R.applyUpdates(ins_rows, ins_cols, ins_vals, no_del, no_del,
+                           grb::Plus<T>());
+
+            // Relabel: every frontier vertex left with excess has no
+            // admissible edge; lift it above its lowest residual neighbour.
+            relabel_mask.clear();
+            grb::IndexArrayType stuck;
+            for (auto u : frontier)
+            {
+                if (is_active(u))
+                {
+                    relabel_mask.setElement(u, true);
+                    stuck.push_back(u);
+                }
+            }
 
-                p = 0;
+            if (!stuck.empty())
+            {
+                grb::mxv(min_height, relabel_mask, grb::NoAccumulate(),
+                         min_residual, R, hvec, grb::REPLACE);
+
+                for (auto u : stuck)
+                {
+                    // No residual neighbour at all: the vertex is retired
+                    grb::IndexType h(num_nodes);
+                    if (min_height.hasElement(u) &&
+                        (min_height.extractElement(u) < num_nodes))
+                    {
+                        h = min_height.extractElement(u) + 1;
+                    }
+                    if (h > height[u])
+                    {
+                        height[u] = h;
+                        hvec.setElement(u, h);
+                        ++num_relabels;
+                    }
+                }
             }
-            else
+
+            if (num_relabels >= num_nodes)
             {
-                p += 1;
+                maxflow_global_relabel(R, source, sink, height, hvec);
+                num_relabels = 0;
             }
+
+            rebuild_frontier(candidates);
         }
 
-        //T maxflow = static_cast<T>(0);
-        //for (grb::IndexType i = 0; i < num_nodes; ++i)
-        //{
-        //    maxflow += flow.extractElement(source, i);
-        //}
-        //grb::print_matrix(std::cerr, flow, "\nFlow");
-        grb::Vector<T> flows(rows);
-        grb::reduce(flows, grb::NoMask(), grb::NoAccumulate(),
-                    grb::Plus<T>(), flow);
-        T maxflow = at(flows,source);
-
-        //grb::print_matrix(std::cerr, flow, "Final FLOW:");
-        return maxflow;
+        return excess[sink];
     }
 
     //************************************************************************
@@ -41,27 +41,19 @@ namespace algorithms
      * @param[in] graph  The graph to compute the in-degree of a vertex in.
      * @param[in] vid    The vertex to compute the in-degree of.
      *
-     * @return The in-degree of vertex vid (G(:,vid).nvals())
+     * @return The in-degree of vertex vid (G(:,vid).nvals()), read from
+     *         the graph's cached degree statistics.
      */
     template<typename MatrixT>
     typename MatrixT::ScalarType vertex_in_degree(MatrixT const  &graph,
                                                   grb::IndexType  vid)
     {
-        using T = typename MatrixT::ScalarType;
-
         if (vid >= graph.ncols())
         {
             throw grb::DimensionException();
         }
 
-        grb::Vector<T> in_edges(graph.nrows());
-        grb::extract(in_edges,
-                     grb::NoMask(), grb::NoAccumulate(),
-                     graph,
-                     grb::AllIndices(),
-                     vid);
-
-        return in_edges.nvals();
+        return graph.degreeStats().col_degrees[vid];
     }
 
 
@@ -71,27 +63,19 @@ namespace algorithms
      * @param[in] graph  The graph to compute the out-degree of a vertex in.
      * @param[in] vid    The vertex to compute the out-degree of.
      *
-     * @return The out-degree of vertex vid (G(vid,:).nvals())
+     * @return The out-degree of vertex vid (G(vid,:).nvals()), read from
+     *         the graph's cached degree statistics.
      */
     template<typename MatrixT>
     typename MatrixT::ScalarType vertex_out_degree(MatrixT const  &graph,
                                                    grb::IndexType  vid)
     {
-        using T = typename MatrixT::ScalarType;
-
         if (vid >= graph.nrows())
         {
             throw grb::DimensionException();
         }
 
-        grb::Vector<T> out_edges(graph.nrows());
-        grb::extract(out_edges,
-                     grb::NoMask(), grb::NoAccumulate(),
-                     grb::transpose(graph),
-                     grb::AllIndices(),
-                     vid);
-
-        return out_edges.nvals();
+        return graph.degreeStats().row_degrees[vid];
     }
 
 
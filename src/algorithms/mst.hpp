@@ -27,6 +27,9 @@
 
 #pragma once
 
+#include <limits>
+#include <numeric>
+#include <tuple>
 #include <utility>
 #include <vector>
 #include <iostream>
@@ -112,6 +115,9 @@ namespace algorithms
      * weight of the edge between that vertex and its parent to the weight
      * of the minimal spanning tree.
      *
+     * Prim's algorithm adds one vertex per iteration; for large sparse
+     * graphs use msf instead.
+     *
      * @param[in]  graph        The graph to perform the computation on.
      * @param[out] mst_parents  Parent list
      *
@@ -227,4 +233,234 @@ namespace algorithms
         return weight;
     }
 
+    //************************************************************************
+    /// An edge candidate for Boruvka's algorithm: the edge (src, dst) of the
+    /// given weight leading into component comp.  Candidates are ordered
+    /// lexicographically by (weight, comp, src, dst), which is a total order
+    /// on the edges and keeps ties from closing a cycle.
+    template <typename T>
+    struct MSFEdge
+    {
+        T              weight;
+        grb::IndexType comp;
+        grb::IndexType src;
+        grb::IndexType dst;
+
+        bool operator<(MSFEdge const &rhs) const
+        {
+            return (std::tie(weight, comp, src, dst) <
+                    std::tie(rhs.weight, rhs.comp, rhs.src, rhs.dst));
+        }
+
+        bool operator==(MSFEdge const &rhs) const
+        {
+            return (std::tie(weight, comp, src, dst) ==
+                    std::tie(rhs.weight, rhs.comp, rhs.src, rhs.dst));
+        }
+    };
+
+    template <typename T>
+    std::ostream &operator<<(std::ostream &ostr, MSFEdge<T> const &e)
+    {
+        ostr << "(" << e.weight << "," << e.comp << ","
+             << e.src << "," << e.dst << ")";
+        return ostr;
+    }
+
+    //************************************************************************
+    template<typename D1>
+    struct MSFMin
+    {
+        inline MSFEdge<D1> operator()(MSFEdge<D1> const &lhs,
+                                      MSFEdge<D1> const &rhs) const
+        {
+            return (rhs < lhs) ? rhs : lhs;
+        }
+    };
+
+    //************************************************************************
+    /// (MSFMin, edge) semiring: the lightest edge from a vertex into each
+    /// neighbour's component.  The vector operand carries (comp, dst) for
+    /// every vertex; src is filled in by the caller from the row index.
+    template <typename D1>
+    struct MSFMinEdgeSemiring
+    {
+        using first_argument_type  = D1;
+        using second_argument_type = MSFEdge<D1>;
+        using result_type          = MSFEdge<D1>;
+
+        MSFEdge<D1> add(MSFEdge<D1> const &a, MSFEdge<D1> const &b) const
+        { return MSFMin<D1>()(a, b); }
+
+        MSFEdge<D1> mult(D1 w, MSFEdge<D1> const &b) const
+        { return MSFEdge<D1>{w, b.comp, 0, b.dst}; }
+
+        MSFEdge<D1> zero() const
+        {
+            return MSFEdge<D1>{std::numeric_limits<D1>::max(),
+                               std::numeric_limits<grb::IndexType>::max(),
+                               std::numeric_limits<grb::IndexType>::max(),
+                               std::numeric_limits<grb::IndexType>::max()};
+        }
+    };
+
+    /**
+     * @brief Compute a minimum spanning forest using Boruvka's algorithm.
+     *
+     * Each round finds the lightest edge leaving every component with one
+     * mxv (a per-vertex min into the neighbours' components)
+     * and one min-reducing build (per component).  Every component hooks
+     * onto the component at the other end of its lightest edge, the parent
+     * forest is flattened by pointer jumping, and edges that became internal
+     * to a component are dropped.  The number of components at least halves
+     * every round, so there are O(log N) rounds.
+     *
+     * Disconnected graphs yield a spanning forest (one tree per connected
+     * component).  The graph is treated as undirected: the lighter of
+     * A(i,j) and A(j,i) is used and self loops are ignored.
+     *
+     * @param[in]  graph   NxN adjacency matrix of edge weights
+     * @param[out] forest  NxN symmetric matrix holding the forest's edges
+     *
+     * @return The total weight of the forest.
+     */
+    template<typename MatrixT, typename ForestMatrixT>
+    typename MatrixT::ScalarType msf(MatrixT const &graph,
+                                     ForestMatrixT &forest)
+    {
+        using T = typename MatrixT::ScalarType;
+        grb::IndexType N(graph.nrows());
+
+        if ((graph.ncols() != N) ||
+            (forest.nrows() != N) || (forest.ncols() != N))
+        {
+            throw grb::DimensionException("msf: dimension mismatch");
+        }
+
+        // Symmetrized edge matrix without self loops
+        grb::Matrix<T> E(N, N);
+        grb::eWiseAdd(E, grb::NoMask(), grb::NoAccumulate(),
+                      grb::Min<T>(), graph, grb::transpose(graph));
+
+        grb::IndexArrayType ei(E.nvals()), ej(E.nvals());
+        std::vector<T> ev(E.nvals());
+
+        std::vector<grb::IndexType> parent(N);
+        std::iota(parent.begin(), parent.end(), 0UL);
+        grb::IndexArrayType all(N);
+        std::iota(all.begin(), all.end(), 0UL);
+
+        grb::Vector<grb::IndexType> parents(N), gp(N);
+        parents.build(all, parent);
+
+        grb::Vector<MSFEdge<T>> comp_of(N), vmin(N), cmin(N);
+        std::vector<MSFEdge<T>> comp_vals(N);
+        grb::IndexArrayType min_idx, min_comp, f_idx(N), f_vals(N);
+        std::vector<MSFEdge<T>> min_vals;
+
+        grb::IndexArrayType forest_rows, forest_cols;
+        std::vector<T> forest_vals;
+        T weight = static_cast<T>(0);
+
+        MSFMinEdgeSemiring<T> min_edge;
+
+        while (true)
+        {
+            // Drop the edges that are internal to a component
+            ei.resize(E.nvals());
+            ej.resize(E.nvals());
+            ev.resize(E.nvals());
+            E.extractTuples(ei, ej, ev);
+            grb::IndexType kept(0);
+            for (grb::IndexType ix = 0; ix < ei.size(); ++ix)
+            {
+                if (parent[ei[ix]] != parent[ej[ix]])
+                {
+                    ei[kept] = ei[ix];
+                    ej[kept] = ej[ix];
+                    ev[kept] = ev[ix];
+                    ++kept;
+                }
+            }
+            if (kept == 0)
+            {
+                break;
+            }
+            if (kept < ei.size())
+            {
+                ei.resize(kept);
+                ej.resize(kept);
+                ev.resize(kept);
+                E.clear();
+                E.build(ei, ej, ev);
+            }
+
+            // vmin(i) = lightest edge from i into another component
+            for (grb::IndexType v = 0; v < N; ++v)
+            {
+                comp_vals[v] = MSFEdge<T>{static_cast<T>(0), parent[v], v, v};
+            }
+            comp_of.build(all, comp_vals);
+            grb::mxv(vmin, grb::NoMask(), grb::NoAccumulate(), min_edge,
+                     E, comp_of, grb::REPLACE);
+
+            // cmin(c) = lightest edge leaving component c
+            min_idx.resize(vmin.nvals());
+            min_vals.resize(vmin.nvals());
+            vmin.extractTuples(min_idx.begin(), min_vals.begin());
+            min_comp.resize(min_idx.size());
+            for (grb::IndexType ix = 0; ix < min_idx.size(); ++ix)
+            {
+                min_vals[ix].src = min_idx[ix];
+                min_comp[ix] = parent[min_idx[ix]];
+            }
+            cmin.build(min_comp, min_vals, MSFMin<T>());
+
+            min_idx.resize(cmin.nvals());
+            min_vals.resize(cmin.nvals());
+            cmin.extractTuples(min_idx.begin(), min_vals.begin());
+
+            // Hook every component onto its lightest neighbour.  When two
+            // components pick each other the lower ID stays the root and
+            // the edge is recorded once, by the other side.
+            for (grb::IndexType ix = 0; ix < min_idx.size(); ++ix)
+            {
+                grb::IndexType c(min_idx[ix]);
+                MSFEdge<T> const &e(min_vals[ix]);
+                if ((c < e.comp) &&
+                    (cmin.extractElement(e.comp).comp == c))
+                {
+                    continue;
+                }
+
+                parents.setElement(c, e.comp);
+                weight += e.weight;
+                forest_rows.push_back(e.src);
+                forest_cols.push_back(e.dst);
+                forest_vals.push_back(e.weight);
+                forest_rows.push_back(e.dst);
+                forest_cols.push_back(e.src);
+                forest_vals.push_back(e.weight);
+            }
+
+            // Pointer jumping: parents = parents[parents] until stable
+            while (true)
+            {
+                parents.extractTuples(f_idx.begin(), f_vals.begin());
+                grb::extract(gp, grb::NoMask(), grb::NoAccumulate(),
+                             parents, f_vals);
+                if (gp == parents)
+                {
+                    break;
+                }
+                parents = gp;
+            }
+            parents.extractTuples(f_idx.begin(), parent.begin());
+        }
+
+        forest.clear();
+        forest.build(forest_rows, forest_cols, forest_vals);
+        return weight;
+    }
+
 } // algorithms
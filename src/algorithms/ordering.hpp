@@ -0,0 +1,236 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+//****************************************************************************
+namespace
+{
+    //************************************************************************
+    // Append to 'order' the vertices reachable from 'start' in breadth
+    // first order.  Each level is computed with one masked vxm that
+    // gives every newly reached vertex the smallest position (in
+    // 'order') of a parent in the previous level; the level is then
+    // sorted by that parent position, optionally by degree, then by id.
+    // This is the Cuthill-McKee visiting order when by_degree is set.
+    template<typename MatrixT>
+    void ordering_bfs_levels(MatrixT const             &graph,
+                             grb::IndexType             start,
+                             bool                       by_degree,
+                             grb::IndexArrayType const &degree,
+                             grb::Vector<bool>         &visited,
+                             grb::IndexArrayType       &order)
+    {
+        using Level = std::tuple<grb::IndexType,   // parent position
+                                 grb::IndexType,   // degree (or 0)
+                                 grb::IndexType>;  // vertex id
+        grb::IndexType n(graph.nrows());
+
+        grb::Vector<grb::IndexType> frontier(n), next(n);
+        frontier.setElement(start, order.size());
+        visited.setElement(start, true);
+        order.push_back(start);
+
+        grb::IndexArrayType idx;
+        grb::IndexArrayType parent_pos;
+        std::vector<Level>  level;
+
+        while (true)
+        {
+            grb::vxm(next, grb::complement(visited), grb::NoAccumulate(),
+                     grb::MinFirstSemiring<grb::IndexType>(),
+                     frontier, graph, grb::REPLACE);
+            if (next.nvals() == 0)
+            {
+                break;
+            }
+
+            idx.resize(next.nvals());
+            parent_pos.resize(next.nvals());
+            next.extractTuples(idx, parent_pos);
+
+            level.clear();
+            for (grb::IndexType ix = 0; ix < idx.size(); ++ix)
+            {
+                level.emplace_back(parent_pos[ix],
+                                   by_degree ? degree[idx[ix]] : 0,
+                                   idx[ix]);
+            }
+            std::sort(level.begin(), level.end());
+
+            frontier.clear();
+            for (auto&& [pos, deg, v] : level)
+            {
+                frontier.setElement(v, order.size());
+                visited.setElement(v, true);
+                order.push_back(v);
+            }
+        }
+    }
+
+    //************************************************************************
+    // Breadth first ordering of every component.  Components are started
+    // from the unvisited vertex that comes first in 'starts'.
+    template<typename MatrixT>
+    grb::IndexArrayType ordering_by_levels(
+        MatrixT const             &graph,
+        grb::IndexArrayType const &starts,
+        bool                       by_degree)
+    {
+        grb::IndexType n(graph.nrows());
+        if (n != graph.ncols())
+        {
+            throw grb::DimensionException("ordering: graph must be square");
+        }
+
+        grb::IndexArrayType const &degree(graph.degreeStats().row_degrees);
+        grb::Vector<bool> visited(n);
+        grb::IndexArrayType order;
+        order.reserve(n);
+
+        for (auto start : starts)
+        {
+            if (order.size() == n)
+            {
+                break;
+            }
+            if (!visited.hasElement(start))
+            {
+                ordering_bfs_levels(graph, start, by_degree, degree,
+                                    visited, order);
+            }
+        }
+        return order;
+    }
+}
+
+//****************************************************************************
+// Vertex orderings for relabeling a graph with grb::permute.  Every ordering
+// is returned as perm[new_id] = old_id, so grb::permute(C, A, perm, perm)
+// produces the relabeled adjacency matrix and grb::invert_permutation(perm)
+// maps old ids to new ones.
+//****************************************************************************
+namespace algorithms
+{
+    //************************************************************************
+    /**
+     * @brief Order the vertices of a graph by their (out-)degree.
+     *
+     * Relabeling by degree groups the high degree vertices together and,
+     * for triangle counting on split(A), bounds the length of the rows that
+     * are intersected.  Ties keep their original relative order.
+     *
+     * @param[in]  graph       NxN adjacency matrix.
+     * @param[in]  descending  Put the highest degree vertices first.
+     *
+     * @return perm with perm[new_id] = old_id.
+     */
+    template<typename MatrixT>
+    grb::IndexArrayType degree_ordering(MatrixT const &graph,
+                                        bool           descending = false)
+    {
+        grb::IndexType n(graph.nrows());
+        if (n != graph.ncols())
+        {
+            throw grb::DimensionException(
+                "degree_ordering: graph must be square");
+        }
+
+        grb::IndexArrayType const &degree(graph.degreeStats().row_degrees);
+        grb::IndexArrayType perm(n);
+        std::iota(perm.begin(), perm.end(), 0UL);
+        std::stable_sort(perm.begin(), perm.end(),
+                         [&](grb::IndexType a, grb::IndexType b)
+                         {
+                             return (descending ?
+                                     (degree[b] < degree[a]) :
+                                     (degree[a] < degree[b]));
+                         });
+        return perm;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Reverse Cuthill-McKee ordering of an undirected graph.
+     *
+     * Each component is traversed breadth first from its lowest degree
+     * vertex, visiting the neighbors of each vertex in order of increasing
+     * degree; the concatenated order is then reversed.  Relabeling with it
+     * reduces the bandwidth of the matrix, which keeps the vector entries
+     * touched by consecutive rows of an mxv close together.
+     *
+     * @param[in]  graph  NxN adjacency matrix with a symmetric structure.
+     *
+     * @return perm with perm[new_id] = old_id.
+     */
+    template<typename MatrixT>
+    grb::IndexArrayType rcm_ordering(MatrixT const &graph)
+    {
+        grb::IndexArrayType starts(degree_ordering(graph));
+        grb::IndexArrayType order(ordering_by_levels(graph, starts, true));
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Breadth first ordering of a graph starting at the given vertex.
+     *
+     * Vertices are numbered in the order a BFS from source reaches them
+     * (each level ordered by the position of its earliest parent, then by
+     * id).  Unreached vertices are numbered by further traversals started
+     * from the lowest unvisited id.
+     *
+     * @param[in]  graph   NxN adjacency matrix.
+     * @param[in]  source  The vertex that gets new id 0.
+     *
+     * @return perm with perm[new_id] = old_id.
+     */
+    template<typename MatrixT>
+    grb::IndexArrayType bfs_ordering(MatrixT const  &graph,
+                                     grb::IndexType  source = 0)
+    {
+        grb::IndexType n(graph.nrows());
+        if (source >= n)
+        {
+            throw grb::IndexOutOfBoundsException(
+                "bfs_ordering: source out of bounds");
+        }
+
+        grb::IndexArrayType starts(n + 1);
+        starts[0] = source;
+        std::iota(starts.begin() + 1, starts.end(), 0UL);
+        return ordering_by_levels(graph, starts, false);
+    }
+} // algorithms
@@ -27,11 +27,57 @@
 
 #pragma once
 
+#include <cmath>
+#include <functional>
+#include <limits>
+
 #include <graphblas/graphblas.hpp>
 
 //****************************************************************************
 namespace algorithms
 {
+    /**
+     * @brief Compute the row normalized graph matrix scaled by the damping
+     *        factor that drives the page rank iteration.
+     *
+     * @param[in]  graph           NxN adjacency matrix of the graph
+     * @param[out] m               NxN damped transition matrix
+     * @param[in]  damping_factor  The constant to ensure stability in cyclic
+     *                             graphs
+     */
+    template<typename MatrixT, typename RealT = double>
+    void page_rank_matrix(MatrixT const       &graph,
+                          grb::Matrix<RealT>  &m,
+                          RealT                damping_factor = 0.85)
+    {
+        using T = typename MatrixT::ScalarType;
+
+        if ((graph.nrows() != m.nrows()) || (graph.ncols() != m.ncols()))
+        {
+            throw grb::DimensionException();
+        }
+
+        // cast graph scalar type to RealT
+        grb::apply(m,
+                   grb::NoMask(), grb::NoAccumulate(),
+                   grb::Identity<T,RealT>(),
+                   graph);
+
+        // Normalize the edge weights of the graph by the vertices out-degree
+        grb::normalize_rows(m);
+        //grb::print_matrix(std::cout, m, "Normalized Graph");
+
+        // scale the normalized edge weights by the damping factor
+        grb::apply(m,
+                   grb::NoMask(), grb::NoAccumulate(),
+                   std::bind(grb::Times<RealT>(),
+                             std::placeholders::_1,
+                             damping_factor),
+                   m);
+        //grb::print_matrix(std::cout, m, "Scaled Graph");
+    }
+
+    //************************************************************************
     /**
      * @brief Compute the page rank for each node in a graph.
      *
@@ -75,25 +121,7 @@ namespace algorithms
 
         // Compute the scaled graph matrix
         grb::Matrix<RealT> m(rows, cols);
-
-        // cast graph scalar type to RealT
-        grb::apply(m,
-                   grb::NoMask(), grb::NoAccumulate(),
-                   grb::Identity<T,RealT>(),
-                   graph);
-
-        // Normalize the edge weights of the graph by the vertices out-degree
-        grb::normalize_rows(m);
-        //grb::print_matrix(std::cout, m, "Normalized Graph");
-
-        // scale the normalized edge weights by the damping factor
-        grb::apply(m,
-                   grb::NoMask(), grb::NoAccumulate(),
-                   std::bind(grb::Times<RealT>(),
-                             std::placeholders::_1,
-                             damping_factor),
-                   m);
-        //grb::print_matrix(std::cout, m, "Scaled Graph");
+        page_rank_matrix(graph, m, damping_factor);
 
         auto add_scaled_teleport =
             std::bind(grb::Plus<RealT>(),
@@ -175,4 +203,131 @@ namespace algorithms
                       page_rank,
                       new_rank);
     }
+    //************************************************************************
+    /**
+     * @brief Update a page rank solution after some rows (out-edges) of the
+     *        graph have changed.
+     *
+     * Warm starts from the previous ranks instead of the uniform vector.
+     * Only the changed rows of the damped matrix are recomputed, and the
+     * error they introduce is carried as a residual vector:
+     *
+     *    residual = sum over changed rows u of rank[u]*(m'[u,:] - m[u,:])
+     *
+     * Each round pushes the vertices whose residual magnitude exceeds the
+     * threshold: their residual is added to the rank and spread to their
+     * out-neighbors with one sparse vxm.  Vertices far from the changes are
+     * never touched.
+     *
+     * @note Assumes page_rank was converged for the previous graph and m
+     *       (e.g., from page_rank and page_rank_matrix).
+     *
+     * @param[in]     graph           NxN adjacency matrix after the updates
+     * @param[in,out] m               The damped matrix of the previous graph
+     *                                (from page_rank_matrix); on return the
+     *                                damped matrix of the current graph.
+     * @param[in,out] page_rank       N vector of previous page ranks; on
+     *                                return the updated page ranks.
+     * @param[in]     changed_rows    Rows of graph whose contents changed
+     *                                (e.g., from Matrix::applyUpdates)
+     * @param[in]     damping_factor  Must match the one used for m
+     * @param[in]     threshold       Residual magnitude below which a vertex
+     *                                is considered converged.
+     * @param[in]     max_iters       The maximum number of push rounds.
+     *
+     * @return The number of push rounds performed.
+     */
+    template<typename MatrixT, typename RealT = double>
+    unsigned int page_rank_incremental(
+        MatrixT const               &graph,
+        grb::Matrix<RealT>          &m,
+        grb::Vector<RealT>          &page_rank,
+        grb::IndexArrayType const   &changed_rows,
+        RealT                        damping_factor = 0.85,
+        RealT                        threshold = 1.e-8,
+        unsigned int                 max_iters = std::numeric_limits<unsigned int>::max())
+    {
+        using T = typename MatrixT::ScalarType;
+
+        grb::IndexType rows(graph.nrows());
+
+        if ((rows != graph.ncols()) ||
+            (m.nrows() != rows) || (m.ncols() != rows) ||
+            (page_rank.size() != rows))
+        {
+            throw grb::DimensionException();
+        }
+
+        // Re-normalize the changed rows and seed the residual with the
+        // difference each one makes to its out-neighbors.
+        grb::Vector<RealT> residual(rows);
+        grb::Vector<T>     graph_row(rows);
+        grb::Vector<RealT> old_row(rows), new_row(rows);
+        for (auto row_idx : changed_rows)
+        {
+            grb::extract(graph_row, grb::NoMask(), grb::NoAccumulate(),
+                         grb::transpose(graph), grb::AllIndices(), row_idx);
+            grb::extract(old_row, grb::NoMask(), grb::NoAccumulate(),
+                         grb::transpose(m), grb::AllIndices(), row_idx);
+
+            new_row.clear();
+            if (graph_row.nvals() > 0)
+            {
+                T row_sum(0);
+                grb::reduce(row_sum, grb::NoAccumulate(),
+                            grb::PlusMonoid<T>(), graph_row);
+                grb::apply(new_row, grb::NoMask(), grb::NoAccumulate(),
+                           std::bind(grb::Times<RealT>(),
+                                     std::placeholders::_1,
+                                     damping_factor/static_cast<RealT>(row_sum)),
+                           graph_row);
+            }
+            grb::assign(m, grb::NoMask(), grb::NoAccumulate(),
+                        new_row, row_idx, grb::AllIndices());
+
+            RealT rank(page_rank.hasElement(row_idx) ?
+                       page_rank.extractElement(row_idx) : RealT(0));
+            grb::apply(residual, grb::NoMask(), grb::Plus<RealT>(),
+                       std::bind(grb::Times<RealT>(),
+                                 std::placeholders::_1, rank),
+                       new_row);
+            grb::apply(residual, grb::NoMask(), grb::Plus<RealT>(),
+                       std::bind(grb::Times<RealT>(),
+                                 std::placeholders::_1, -rank),
+                       old_row);
+        }
+
+        auto exceeds_threshold =
+            [threshold](RealT val) { return std::abs(val) > threshold; };
+
+        grb::Vector<bool>  frontier(rows);
+        grb::Vector<RealT> push(rows);
+        unsigned int iters(0);
+        while (iters < max_iters)
+        {
+            // Select the vertices with a large residual
+            grb::apply(frontier, grb::NoMask(), grb::NoAccumulate(),
+                       exceeds_threshold, residual);
+            grb::apply(push, frontier, grb::NoAccumulate(),
+                       grb::Identity<RealT>(), residual, grb::REPLACE);
+            if (push.nvals() == 0)
+            {
+                break;
+            }
+            ++iters;
+
+            // Move their residual into the rank...
+            grb::eWiseAdd(page_rank, grb::NoMask(), grb::NoAccumulate(),
+                          grb::Plus<RealT>(), page_rank, push);
+            grb::apply(residual, grb::complement(frontier),
+                       grb::NoAccumulate(),
+                       grb::Identity<RealT>(), residual, grb::REPLACE);
+
+            // ...and propagate it to their out-neighbors.
+            grb::vxm(residual, grb::NoMask(), grb::Plus<RealT>(),
+                     grb::ArithmeticSemiring<RealT>(), push, m);
+        }
+
+        return iters;
+    }
 } // algorithms
@@ -29,7 +29,10 @@
 
 #include <functional>
 #include <limits>
+#include <map>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include <graphblas/graphblas.hpp>
 
@@ -293,181 +296,265 @@ namespace algorithms
     };
 
     //************************************************************************
+    /**
+     * @brief Light/heavy split of a weighted graph for delta-stepping.
+     *
+     * AL holds the edges with weight <= delta and AH the edges with weight
+     * > delta.  Building the split costs two select passes over the graph, so
+     * construct it once and reuse it for every query issued against the same
+     * graph and delta.
+     */
     template<typename MatrixT>
-    void sssp_delta_step(MatrixT const                             &graph,
-                         typename MatrixT::ScalarType               delta,
-                         grb::IndexType                             src,
-                         grb::Vector<typename MatrixT::ScalarType> &paths)
+    class DeltaSteppingGraph
+    {
+    public:
+        using ScalarType = typename MatrixT::ScalarType;
+
+        DeltaSteppingGraph(MatrixT const &graph, ScalarType delta)
+            : m_delta(delta),
+              m_light(graph.nrows(), graph.ncols()),
+              m_heavy(graph.nrows(), graph.ncols())
+        {
+            if (graph.nrows() != graph.ncols())
+            {
+                throw grb::DimensionException("DeltaSteppingGraph");
+            }
+
+            // AL = A .* (A <= delta)
+            grb::select(m_light, grb::NoMask(), grb::NoAccumulate(),
+                        grb::ValueLE<ScalarType>(), graph, delta);
+
+            // AH = A .* (A > delta)
+            grb::select(m_heavy, grb::NoMask(), grb::NoAccumulate(),
+                        grb::ValueGT<ScalarType>(), graph, delta);
+        }
+
+        ScalarType     delta() const { return m_delta; }
+        grb::IndexType nvertices() const { return m_light.nrows(); }
+        MatrixT const &light() const { return m_light; }
+        MatrixT const &heavy() const { return m_heavy; }
+
+    private:
+        ScalarType m_delta;
+        MatrixT    m_light;
+        MatrixT    m_heavy;
+    };
+
+    //************************************************************************
+    /**
+     * @brief Delta-stepping SSSP from a batch of sources on a precomputed
+     *        light/heavy split.
+     *
+     * Tentative distances are kept in one hash map per source holding only
+     * the vertices that source has reached, so memory and the final gather
+     * scale with the reached entries rather than sources.size()*N.  Every
+     * improved entry is appended to the explicit list of the bucket its
+     * distance falls in (stale entries are skipped when the bucket is
+     * drained), so no pass over all N vertices is needed to find the next
+     * bucket.  Each light or heavy relaxation phase relaxes the frontier of
+     * all sources with a single min.+ mxm.
+     *
+     * Assumes non-negative edge weights and delta > 0.
+     *
+     * @param[in]  dsg      Light/heavy split of the graph for a given delta.
+     * @param[in]  sources  The source vertices, one per row of dists.
+     * @param[out] dists    sources.size() x N matrix.  Row k holds the
+     *                      shortest path lengths from sources[k]; unreachable
+     *                      vertices have no stored value.
+     */
+    template<typename MatrixT, typename DistMatrixT>
+    void sssp_delta_step_batch(DeltaSteppingGraph<MatrixT> const &dsg,
+                               grb::IndexArrayType const         &sources,
+                               DistMatrixT                       &dists)
     {
         using T = typename MatrixT::ScalarType;
-        //std::cerr << "delta = " << delta << std::endl;
-        //grb::print_matrix(std::cerr, graph, "A");
-
-        grb::IndexType n(graph.nrows());  /// @todo assert nrows = ncols
-        paths.clear();                    /// @todo assert size = nrows
-
-        grb::Vector<T>    t(n);
-        grb::Vector<T>    tmasked(n);
-        grb::Vector<T>    tReq(n);
-
-        grb::Vector<bool> tBi(n);
-        grb::Vector<bool> tnew(n);
-        grb::Vector<bool> tcomp(n);
-        grb::Vector<bool> tless(n);
-        grb::Vector<bool> s(n);
-
-        // t = infinity, t[src] = 0
-        t.setElement(src, 0);
-
-        // AL = A .* (A <= delta)
-        MatrixT AL(n, n);
-        grb::apply(AL, grb::NoMask(), grb::NoAccumulate(),
-                   std::bind(grb::LessEqual<T>(),
-                             std::placeholders::_1,
-                             static_cast<T>(delta)),
-                   graph);
-        grb::apply(AL, AL, grb::NoAccumulate(),
-                   grb::Identity<T>(), graph, grb::REPLACE);
-        //grb::print_matrix(std::cerr, AL, "AL = A(<=delta)");
-
-        // AH = A .* (A > delta)
-        MatrixT AH(n, n);
-        grb::apply(AH, grb::NoMask(), grb::NoAccumulate(),
-                   std::bind(grb::GreaterThan<T>(),
-                             std::placeholders::_1,
-                             delta),
-                   graph);
-        grb::apply(AH, AH, grb::NoAccumulate(),
-                   grb::Identity<T>(), graph, grb::REPLACE);
-        //grb::print_matrix(std::cerr, AH, "AH = A(>delta)");
-
-        // i = 0
-        grb::IndexType i(0);
-
-        // t >= i*delta
-        grb::apply(tcomp, grb::NoMask(), grb::NoAccumulate(),
-                   std::bind(grb::GreaterEqual<T>(),
-                             std::placeholders::_1,
-                             static_cast<T>(i)*delta),
-                   t);
-        grb::apply(tcomp, tcomp, grb::NoAccumulate(),
-                   grb::Identity<bool>(), tcomp);
-
-        //grb::print_vector(std::cerr, tcomp, "tcomp = t(>=i*delta)");
-
-        // while (t >= i*delta) not empty
-        while (tcomp.nvals() > 0)
+        using EntryType = std::tuple<grb::IndexType, grb::IndexType>;
+
+        grb::IndexType n(dsg.nvertices());
+        grb::IndexType num_src(sources.size());
+        T const delta(dsg.delta());
+
+        if ((dists.nrows() != num_src) || (dists.ncols() != n))
+        {
+            throw grb::DimensionException("sssp_delta_step_batch");
+        }
+        if (!(delta > static_cast<T>(0)))
+        {
+            throw grb::PanicException("sssp_delta_step_batch: delta <= 0");
+        }
+
+        // per reached (source, vertex): the tentative distance and the
+        // stamps of the last frontier/settled set it was added to, used to
+        // deduplicate the bucket lists
+        struct ReachedEntry
+        {
+            T              dist;
+            grb::IndexType in_frontier;
+            grb::IndexType in_settled;
+        };
+        std::vector<std::unordered_map<grb::IndexType, ReachedEntry>>
+            reached(num_src);
+        grb::IndexType frontier_stamp(0);
+
+        std::map<grb::IndexType, std::vector<EntryType>> buckets;
+
+        auto bucket_of = [delta](T d)
+            { return static_cast<grb::IndexType>(d/delta); };
+
+        for (grb::IndexType k = 0; k < num_src; ++k)
         {
-            //std::cerr << "************************************************\n";
-            //std::cerr << "****** Outer loop: i = " << i << std::endl;
-            // s = 0 (clear)
-            s.clear();
-
-            // tBi = t .* (i*delta <= t < (i+1)*delta)
-            SelectInRange<T> in_range((T)i*delta, ((T)(i + 1))*delta);
-            grb::apply(tBi, grb::NoMask(), grb::NoAccumulate(),
-                       in_range, t);
-            grb::apply(tBi, tBi, grb::NoAccumulate(),
-                       grb::Identity<T>(), tBi, grb::REPLACE);
-            //grb::print_vector(std::cerr, tBi,
-            //                        "tBi<tless> = tReq([i*d, (i+1)*d))");
-
-            // tm<tBi> = t
-            grb::apply(tmasked, tBi, grb::NoAccumulate(),
-                       grb::Identity<T>(), t, grb::REPLACE);
-            //grb::print_vector(std::cerr, tmasked, "tm = t<tBi>");
-
-            while (tmasked.nvals() > 0)
+            if (sources[k] >= n)
             {
-                //std::cerr << "******************* inner *********************\n";
-                // tReq = AL' (min.+) (t .* tBi)
-                grb::vxm(tReq, grb::NoMask(), grb::NoAccumulate(),
-                         grb::MinPlusSemiring<T>(), tmasked, AL);
-                //grb::print_vector(std::cerr, tReq, "tReq = tm*AL");
-
-                // s = s + tBi
-                grb::eWiseAdd(s,
-                              grb::NoMask(),
-                              grb::NoAccumulate(),
-                              grb::LogicalOr<bool>(),
-                              s, tBi);
-                //grb::print_vector(std::cerr, s, "s += tBi");
-
-                // Don't tBi = 0
-                // tBi.clear();
-
-                // Note that the following ("masked less than") only
-                // works if the new distances are never zero.
-                // TODO: NEED STRUCTURE ONLY MASK here
-                // tless<tReq> = tReq .< t
-                grb::eWiseAdd(tless,
-                              tReq,
-                              grb::NoAccumulate(),
-                              grb::LessThan<T>(),
-                              tReq, t, grb::REPLACE);
-                //grb::print_vector(std::cerr, tless, "tless<tReq> = tReq .< t");
-
-                // tBi<tless> = i*delta <= tReq < (i+1)*delta
-                grb::apply(tBi,
-                           tless,
-                           grb::NoAccumulate(),
-                           in_range, tReq, grb::REPLACE);
-                //grb::apply(tnew, tnew, grb::NoAccumulate(),
-                //                 grb::Identity<bool>(), tnew, grb::REPLACE);
-                //grb::print_vector(std::cerr, tBi,
-                //                        "tBi<tless> = tReq([i*d, (i+1)*d))");
-
-                // t = min(t, tReq)
-                grb::eWiseAdd(t,
-                              grb::NoMask(),
-                              grb::NoAccumulate(),
-                              grb::Min<T>(),
-                              t, tReq);
-                //grb::print_vector(std::cerr, t, "t = min(t, tReq)");
-
-                // tm<tBi> = t
-                grb::apply(tmasked, tBi, grb::NoAccumulate(),
-                           grb::Identity<T>(), t, grb::REPLACE);
-                //grb::print_vector(std::cerr, tmasked, "tm = t<tBi>");
+                throw grb::IndexOutOfBoundsException("sssp_delta_step_batch");
             }
-            //std::cerr << "******************** end inner loop *****************\n";
+            reached[k].try_emplace(sources[k],
+                                   ReachedEntry{static_cast<T>(0), 0, 0});
+            buckets[0].emplace_back(k, sources[k]);
+        }
 
-            // (t .* s)
-            grb::apply(tmasked, s, grb::NoAccumulate(),
-                       grb::Identity<T>(), t, grb::REPLACE);
-            //grb::print_vector(std::cerr, tmasked, "tm = t<s>");
+        grb::IndexArrayType  rows, cols;
+        std::vector<T>       vals;
+        std::vector<EntryType> settled;
+        DistMatrixT F(num_src, n);
+        DistMatrixT R(num_src, n);
 
-            // tReq = AH'(t .* s)
-            grb::vxm(tReq,
-                     grb::NoMask(),
-                     grb::NoAccumulate(),
-                     grb::MinPlusSemiring<T>(), tmasked, AH);
-            //grb::print_vector(std::cerr, tReq, "tReq = tcomp min.+ AH");
+        // F = dist over the given entries; R = F min.+ A; relax R into dist
+        auto relax = [&](std::vector<EntryType> const &frontier,
+                         MatrixT const                &A)
+        {
+            rows.clear(); cols.clear(); vals.clear();
+            for (auto const &[k, v] : frontier)
+            {
+                rows.push_back(k);
+                cols.push_back(v);
+                vals.push_back(reached[k].find(v)->second.dist);
+            }
+            F.clear();
+            F.build(rows, cols, vals);
 
-            // t = min(t, tReq)
-            grb::eWiseAdd(t,
-                          grb::NoMask(),
-                          grb::NoAccumulate(),
-                          grb::Min<T>(), t, tReq);
-            //grb::print_vector(std::cerr, t, "t = min(t,tReq)");
+            grb::mxm(R, grb::NoMask(), grb::NoAccumulate(),
+                     grb::MinPlusSemiring<T>(), F, A);
 
-            ++i;
+            grb::IndexType nvals(R.nvals());
+            rows.resize(nvals); cols.resize(nvals); vals.resize(nvals);
+            R.extractTuples(rows, cols, vals);
+            for (grb::IndexType idx = 0; idx < nvals; ++idx)
+            {
+                auto [it, inserted] = reached[rows[idx]].try_emplace(
+                    cols[idx], ReachedEntry{vals[idx], 0, 0});
+                if (inserted || (vals[idx] < it->second.dist))
+                {
+                    it->second.dist = vals[idx];
+                    buckets[bucket_of(vals[idx])].emplace_back(
+                        rows[idx], cols[idx]);
+                }
+            }
+        };
 
-            // t >= i*delta
-            grb::apply(tcomp,
-                       grb::NoMask(),
-                       grb::NoAccumulate(),
-                       std::bind(grb::GreaterEqual<T>(),
-                                 std::placeholders::_1,
-                                 static_cast<T>(i)*delta),
-                       t);
-            grb::apply(tcomp, tcomp, grb::NoAccumulate(),
-                       grb::Identity<bool>(), tcomp, grb::REPLACE);
-            //grb::print_vector(std::cerr, tcomp, "tcomp = t(>=i*delta)");
+        std::vector<EntryType> frontier;
+        while (!buckets.empty())
+        {
+            grb::IndexType b(buckets.begin()->first);
+            settled.clear();
+
+            // relax light edges until bucket b stops refilling
+            while (buckets.begin()->first == b)
+            {
+                std::vector<EntryType> current;
+                current.swap(buckets.begin()->second);
+                buckets.erase(buckets.begin());
+
+                ++frontier_stamp;
+                frontier.clear();
+                for (auto const &entry : current)
+                {
+                    auto const &[k, v] = entry;
+                    ReachedEntry &e(reached[k].find(v)->second);
+                    // skip entries whose distance has since moved to an
+                    // earlier bucket (already handled) or duplicates
+                    if ((bucket_of(e.dist) != b) ||
+                        (e.in_frontier == frontier_stamp))
+                    {
+                        continue;
+                    }
+                    e.in_frontier = frontier_stamp;
+                    frontier.push_back(entry);
+
+                    if (e.in_settled != b + 1)
+                    {
+                        e.in_settled = b + 1;
+                        settled.push_back(entry);
+                    }
+                }
+
+                if (!frontier.empty())
+                {
+                    relax(frontier, dsg.light());
+                }
+                if (buckets.empty())
+                {
+                    break;
+                }
+            }
+
+            // heavy edges from every vertex settled in bucket b
+            if (!settled.empty())
+            {
+                relax(settled, dsg.heavy());
+            }
+        }
+
+        rows.clear(); cols.clear(); vals.clear();
+        for (grb::IndexType k = 0; k < num_src; ++k)
+        {
+            for (auto const &[v, e] : reached[k])
+            {
+                rows.push_back(k);
+                cols.push_back(v);
+                vals.push_back(e.dist);
+            }
         }
+        dists.clear();
+        dists.build(rows, cols, vals);
+    }
+
+    //************************************************************************
+    /**
+     * @brief Single source delta-stepping on a precomputed light/heavy split.
+     */
+    template<typename MatrixT>
+    void sssp_delta_step(DeltaSteppingGraph<MatrixT> const         &dsg,
+                         grb::IndexType                             src,
+                         grb::Vector<typename MatrixT::ScalarType> &paths)
+    {
+        using T = typename MatrixT::ScalarType;
+
+        grb::Matrix<T> dists(1, dsg.nvertices());
+        sssp_delta_step_batch(dsg, grb::IndexArrayType{src}, dists);
+
+        grb::IndexArrayType rows, cols;
+        std::vector<T>      vals;
+        rows.resize(dists.nvals()); cols.resize(dists.nvals());
+        vals.resize(dists.nvals());
+        dists.extractTuples(rows, cols, vals);
+
+        paths.clear();
+        paths.build(cols, vals);
+    }
 
-        // result = t
-        grb::apply(paths, grb::NoMask(), grb::NoAccumulate(),
-                   grb::Identity<T>(), t);
+    //************************************************************************
+    /**
+     * @brief Single source delta-stepping.  Builds the light/heavy split for
+     *        every call; use DeltaSteppingGraph directly when issuing many
+     *        queries against the same graph.
+     */
+    template<typename MatrixT>
+    void sssp_delta_step(MatrixT const                             &graph,
+                         typename MatrixT::ScalarType               delta,
+                         grb::IndexType                             src,
+                         grb::Vector<typename MatrixT::ScalarType> &paths)
+    {
+        DeltaSteppingGraph<MatrixT> dsg(graph, delta);
+        sssp_delta_step(dsg, src, paths);
     }
 } // algorithms
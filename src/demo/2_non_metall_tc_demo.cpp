@@ -31,6 +31,7 @@
 #include "Timer.hpp"
 
 #include <graphblas/graphblas.hpp>
+#include <algorithms/ordering.hpp>
 #include <algorithms/triangle_count.hpp>
 
 //****************************************************************************
@@ -87,42 +88,19 @@ int main(int argc, char **argv)
     std::cout << "Read " << num_rows << " rows." << std::endl;
     std::cout << "#Nodes = " << (max_id + 1) << std::endl;
 
-    // sort the
-    using DegIdx = std::tuple<grb::IndexType,grb::IndexType>;
-    std::vector<DegIdx> degrees(max_id + 1);
-    for (grb::IndexType idx = 0; idx <= max_id; ++idx)
-    {
-        degrees[idx] = {0UL, idx};
-    }
-
-    {
-        std::ifstream infile(pathname);
-        while (infile)
-        {
-            infile >> src >> dst;
-            if (src != dst)
-            {
-                std::get<0>(degrees[src]) += 1;
-            }
-        }
-    }
-
-    std::sort(degrees.begin(), degrees.end(),
-              [](DegIdx a, DegIdx b) { return std::get<0>(b) < std::get<0>(a); });
-
-    //relabel
-   
-    for (auto &idx : iL) { idx = std::get<1>(degrees[idx]); }
-    for (auto &idx : jL) { idx = std::get<1>(degrees[idx]); }
-
     grb::IndexType NUM_NODES(max_id + 1);
     using T = int32_t;
     std::vector<T> v(iA.size(), 1);
 
     /// @todo change scalar type to unsigned int or grb::IndexType
     using MatType = grb::Matrix<T>;
+    MatType A_in(NUM_NODES, NUM_NODES);
+    A_in.build(iA.begin(), jA.begin(), v.begin(), iA.size());
+
+    // relabel the vertices in order of decreasing degree
+    grb::IndexArrayType perm(algorithms::degree_ordering(A_in, true));
     MatType A(NUM_NODES, NUM_NODES);
-    A.build(iA.begin(), jA.begin(), v.begin(), iA.size());
+    grb::permute(A, A_in, perm, perm);
 
     my_timer.stop();
     std::cout << "Graph Construction time: \t" << my_timer.elapsed() << " milli seconds." << std::endl;
@@ -32,6 +32,7 @@
 #define GRAPHBLAS_DEBUG 1
 
 #include <graphblas/graphblas.hpp>
+#include <algorithms/ordering.hpp>
 #include <algorithms/triangle_count.hpp>
 #include "Timer.hpp"
 
@@ -50,8 +51,8 @@ int main(int argc, char **argv)
 
     Timer<std::chrono::steady_clock, std::chrono::microseconds> my_timer;
 
-    grb::IndexArrayType iL, iU, iA;
-    grb::IndexArrayType jL, jU, jA;
+    grb::IndexArrayType iA;
+    grb::IndexArrayType jA;
     uint64_t num_rows = 0;
     uint64_t max_id = 0;
     uint64_t src, dst;
@@ -66,21 +67,10 @@ int main(int argc, char **argv)
             if (src > max_id) max_id = src;
             if (dst > max_id) max_id = dst;
 
-            if (src < dst)
-            {
-                iA.push_back(src);
-                jA.push_back(dst);
-
-                iU.push_back(src);
-                jU.push_back(dst);
-            }
-            else if (dst < src)
+            if (src != dst)
             {
                 iA.push_back(src);
                 jA.push_back(dst);
-
-                iL.push_back(src);
-                jL.push_back(dst);
             }
             // else ignore self loops
 
@@ -93,49 +83,6 @@ int main(int argc, char **argv)
     std::cout << "Read " << num_rows << " rows." << std::endl;
     std::cout << "#Nodes = " << (max_id + 1) << std::endl;
 
-    // sort the
-    using DegIdx = std::tuple<grb::IndexType,grb::IndexType>;
-    my_timer.start();
-    std::vector<DegIdx> degrees(max_id + 1);
-    for (grb::IndexType idx = 0; idx <= max_id; ++idx)
-    {
-        degrees[idx] = {0UL, idx};
-    }
-
-    {
-        std::ifstream infile(pathname);
-        while (infile)
-        {
-            infile >> src >> dst;
-            if (src != dst)
-            {
-                std::get<0>(degrees[src]) += 1;
-            }
-        }
-    }
-
-    std::sort(degrees.begin(), degrees.end(),
-              [](DegIdx a, DegIdx b) { return std::get<0>(b) < std::get<0>(a); });
-
-    //relabel
-    for (auto &idx : iA) { idx = std::get<1>(degrees[idx]); }
-    for (auto &idx : jA) { idx = std::get<1>(degrees[idx]); }
-    for (auto &idx : iL) { idx = std::get<1>(degrees[idx]); }
-    for (auto &idx : jL) { idx = std::get<1>(degrees[idx]); }
-    for (auto &idx : iU) { idx = std::get<1>(degrees[idx]); }
-    for (auto &idx : jU) { idx = std::get<1>(degrees[idx]); }
-
-    my_timer.stop();
-    std::cout << "Elapsed sort/relabel time: " << my_timer.elapsed() << " usec." << std::endl;
-
-    grb::IndexType idx(0);
-    for (auto&& row : degrees)
-    {
-        std::cout << idx << " <-- " << std::get<1>(row)
-                  << ": deg = " << std::get<0>(row) << std::endl;
-        idx++;
-    }
-
     grb::IndexType NUM_NODES(max_id + 1);
     using T = int32_t;
     std::vector<T> v(iA.size(), 1);
@@ -143,13 +90,28 @@ int main(int argc, char **argv)
     /// @todo change scalar type to unsigned int or grb::IndexType
     using MatType = grb::Matrix<T, grb::DirectedMatrixTag>;
 
+    MatType A_in(NUM_NODES, NUM_NODES);
+    A_in.build(iA.begin(), jA.begin(), v.begin(), iA.size());
+
+    // relabel the vertices in order of decreasing degree
+    my_timer.start();
+    grb::IndexArrayType perm(algorithms::degree_ordering(A_in, true));
+
     MatType A(NUM_NODES, NUM_NODES);
     MatType L(NUM_NODES, NUM_NODES);
     MatType U(NUM_NODES, NUM_NODES);
+    grb::permute(A, A_in, perm, perm);
+    grb::split(A, L, U);
 
-    A.build(iA.begin(), jA.begin(), v.begin(), iA.size());
-    L.build(iL.begin(), jL.begin(), v.begin(), iL.size());
-    U.build(iU.begin(), jU.begin(), v.begin(), iU.size());
+    my_timer.stop();
+    std::cout << "Elapsed sort/relabel time: " << my_timer.elapsed() << " usec." << std::endl;
+
+    auto const &degrees(A_in.degreeStats().row_degrees);
+    for (grb::IndexType idx = 0; idx < NUM_NODES; ++idx)
+    {
+        std::cout << idx << " <-- " << perm[idx]
+                  << ": deg = " << degrees[perm[idx]] << std::endl;
+    }
 
     std::cout << "Running algorithm(s)..." << std::endl;
     T count(0);
@@ -196,12 +196,62 @@ namespace grb
                         values.begin(), values.size(), dup);
         }
 
+        /**
+         * @brief Apply a batch of element deletions and insertions.
+         *
+         * Deletions are applied first, then insertions.  Each touched row is
+         * merged with its part of the batch in a single pass, so the cost is
+         * O(batch log batch + total length of the touched rows).
+         *
+         * @param[in]  insert_rows  Row indices of the elements to insert
+         * @param[in]  insert_cols  Column indices of the elements to insert
+         * @param[in]  insert_vals  Values of the elements to insert
+         * @param[in]  delete_rows  Row indices of the elements to remove
+         * @param[in]  delete_cols  Column indices of the elements to remove
+         * @param[in]  dup          Binary function to call when a value is
+         *                          inserted where one is already stored.
+         *                          stored_val = dup(stored_val, val)
+         *
+         * @return The sorted indices of the rows whose contents changed
+         *         (e.g., to seed incremental algorithms).
+         */
+        template<typename ValueT,
+                 typename BinaryOpT = grb::Second<ScalarType> >
+        IndexArrayType applyUpdates(IndexArrayType       const &insert_rows,
+                                    IndexArrayType       const &insert_cols,
+                                    std::vector<ValueT>  const &insert_vals,
+                                    IndexArrayType       const &delete_rows,
+                                    IndexArrayType       const &delete_cols,
+                                    BinaryOpT                   dup = BinaryOpT())
+        {
+            if ((insert_rows.size() != insert_cols.size()) ||
+                (insert_rows.size() != insert_vals.size()) ||
+                (delete_rows.size() != delete_cols.size()))
+            {
+                throw DimensionException("Matrix::applyUpdates");
+            }
+
+            return m_mat.applyUpdates(insert_rows.begin(), insert_cols.begin(),
+                                      insert_vals.begin(), insert_vals.size(),
+                                      delete_rows.begin(), delete_cols.begin(),
+                                      delete_rows.size(), dup);
+        }
+
         void clear() { m_mat.clear(); }
 
         IndexType nrows() const  { return m_mat.nrows(); }
         IndexType ncols() const  { return m_mat.ncols(); }
         IndexType nvals() const  { return m_mat.nvals(); }
 
+        /**
+         * @brief Row/column nvals counts (out/in-degrees of a graph) and
+         *        summary statistics of them.
+         *
+         * Computed on first use and cached until the structure of the
+         * matrix changes, so repeated calls are free.
+         */
+        DegreeStats const &degreeStats() const { return m_mat.degreeStats(); }
+
         /**
          * @brief Resize the matrix dimensions (smaller or larger)
          *
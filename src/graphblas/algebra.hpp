@@ -34,6 +34,8 @@
 #include <limits>
 #include <utility>
 
+#include <graphblas/types.hpp>
+
 namespace grb
 {
     namespace detail
@@ -341,6 +343,118 @@ namespace grb
 } // namespace grb
 
 
+//****************************************************************************
+// The Index Unary Operators (predicates for select)
+//****************************************************************************
+// Called as op(a_ij, i, j, thunk) and return true for the elements to keep.
+// For vectors j is always 0.  The positional operators take a signed thunk
+// that offsets the diagonal (or row/column) being compared against.
+
+namespace grb
+{
+    template<typename D1, typename D2 = int64_t>
+    struct TriL
+    {
+        inline bool operator()(D1, IndexType i, IndexType j, D2 k) const
+        { return static_cast<int64_t>(j) <= static_cast<int64_t>(i) + k; }
+    };
+
+    template<typename D1, typename D2 = int64_t>
+    struct TriU
+    {
+        inline bool operator()(D1, IndexType i, IndexType j, D2 k) const
+        { return static_cast<int64_t>(j) >= static_cast<int64_t>(i) + k; }
+    };
+
+    template<typename D1, typename D2 = int64_t>
+    struct Diag
+    {
+        inline bool operator()(D1, IndexType i, IndexType j, D2 k) const
+        { return static_cast<int64_t>(j) == static_cast<int64_t>(i) + k; }
+    };
+
+    template<typename D1, typename D2 = int64_t>
+    struct OffDiag
+    {
+        inline bool operator()(D1, IndexType i, IndexType j, D2 k) const
+        { return static_cast<int64_t>(j) != static_cast<int64_t>(i) + k; }
+    };
+
+    template<typename D1, typename D2 = int64_t>
+    struct RowLE
+    {
+        inline bool operator()(D1, IndexType i, IndexType, D2 k) const
+        { return static_cast<int64_t>(i) <= k; }
+    };
+
+    template<typename D1, typename D2 = int64_t>
+    struct RowGT
+    {
+        inline bool operator()(D1, IndexType i, IndexType, D2 k) const
+        { return static_cast<int64_t>(i) > k; }
+    };
+
+    template<typename D1, typename D2 = int64_t>
+    struct ColLE
+    {
+        inline bool operator()(D1, IndexType, IndexType j, D2 k) const
+        { return static_cast<int64_t>(j) <= k; }
+    };
+
+    template<typename D1, typename D2 = int64_t>
+    struct ColGT
+    {
+        inline bool operator()(D1, IndexType, IndexType j, D2 k) const
+        { return static_cast<int64_t>(j) > k; }
+    };
+
+    //-------------------------------------------------------------------------
+
+    template<typename D1, typename D2 = D1>
+    struct ValueEQ
+    {
+        inline bool operator()(D1 a, IndexType, IndexType, D2 k) const
+        { return a == k; }
+    };
+
+    template<typename D1, typename D2 = D1>
+    struct ValueNE
+    {
+        inline bool operator()(D1 a, IndexType, IndexType, D2 k) const
+        { return a != k; }
+    };
+
+    template<typename D1, typename D2 = D1>
+    struct ValueLT
+    {
+        inline bool operator()(D1 a, IndexType, IndexType, D2 k) const
+        { return a < k; }
+    };
+
+    template<typename D1, typename D2 = D1>
+    struct ValueLE
+    {
+        inline bool operator()(D1 a, IndexType, IndexType, D2 k) const
+        { return a <= k; }
+    };
+
+    template<typename D1, typename D2 = D1>
+    struct ValueGT
+    {
+        inline bool operator()(D1 a, IndexType, IndexType, D2 k) const
+        { return a > k; }
+    };
+
+    template<typename D1, typename D2 = D1>
+    struct ValueGE
+    {
+        inline bool operator()(D1 a, IndexType, IndexType, D2 k) const
+        { return a >= k; }
+    };
+
+} // namespace grb
+
+
 //****************************************************************************
 // Monoids
 //****************************************************************************
@@ -388,6 +502,11 @@ namespace grb
     GEN_GRAPHBLAS_MONOID(LogicalXorMonoid,  LogicalXor,  false)
     GEN_GRAPHBLAS_MONOID(LogicalXnorMonoid, LogicalXnor, true)
 
+    /// @note only for integral domains
+    GEN_GRAPHBLAS_MONOID(BitwiseOrMonoid,  BitwiseOr,  0)
+    GEN_GRAPHBLAS_MONOID(BitwiseAndMonoid, BitwiseAnd, ~0)
+    GEN_GRAPHBLAS_MONOID(BitwiseXorMonoid, BitwiseXor, 0)
+
     // ***********************************************************************
     // MaxMonoid identity depends on the type requiring class templates and SFINAE
     // See below for explicit instantiations
@@ -569,6 +688,10 @@ namespace grb
     GEN_GRAPHBLAS_SEMIRING(MaxFirstSemiring, MaxMonoid, First)
     GEN_GRAPHBLAS_SEMIRING(MaxSecondSemiring, MaxMonoid, Second)
 
+    // Propagate bit sets (e.g., one bit per traversal) along edges
+    GEN_GRAPHBLAS_SEMIRING(BitwiseOrFirstSemiring, BitwiseOrMonoid, First)
+    GEN_GRAPHBLAS_SEMIRING(BitwiseOrSecondSemiring, BitwiseOrMonoid, Second)
+
 } // namespace grb
 
 //****************************************************************************
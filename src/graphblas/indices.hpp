@@ -27,8 +27,10 @@
 
 #pragma once
 
+#include <iostream>
 #include <type_traits>
 #include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
 
 namespace grb
 {
@@ -195,6 +197,141 @@ namespace grb
     //**************************************************************************
     //**************************************************************************
 
+    // Iterator over a strided range: lo, lo + stride, lo + 2*stride, ...
+    class RangeIterator
+    {
+    public:
+        using difference_type = ssize_t;
+
+        RangeIterator(IndexType value = 0, IndexType stride = 1)
+            : m_value(value), m_stride(stride)
+        {
+        }
+
+        IndexType operator*() const             { return m_value; }
+
+        const RangeIterator &operator++()
+        {
+            m_value += m_stride;
+            return *this;
+        }
+
+        RangeIterator operator++(int)
+        {
+            RangeIterator copy(*this);
+            ++(*this);
+            return copy;
+        }
+
+        const RangeIterator &operator--()
+        {
+            m_value -= m_stride;
+            return *this;
+        }
+
+        RangeIterator operator--(int)
+        {
+            RangeIterator copy(*this);
+            --(*this);
+            return copy;
+        }
+
+        bool operator==(const RangeIterator &other) const
+        {
+            return m_value == other.m_value;
+        }
+
+        bool operator!=(const RangeIterator &other) const
+        {
+            return m_value != other.m_value;
+        }
+
+        IndexType operator[](difference_type n) const
+        {
+            return m_value + n*m_stride;
+        }
+
+    private:
+        IndexType m_value;
+        IndexType m_stride;
+    };
+
+    //**************************************************************************
+
+    /**
+     * A contiguous or strided index sequence, [lo, hi) with the given stride,
+     * that is never realized in memory.  Operations that take index arrays
+     * (extract, assign) recognize a Range and slice with a binary search
+     * instead of searching for every index.
+     *
+     * For example, Range(2, 9, 3) is the sequence {2, 5, 8}.
+     */
+    class Range
+    {
+    public:
+        using iterator = RangeIterator;
+
+        Range(IndexType lo, IndexType hi, IndexType stride = 1)
+            : m_lo(lo),
+              m_stride(checked_stride(stride)),
+              m_size((hi > lo) ? (hi - lo + m_stride - 1)/m_stride : 0)
+        {
+        }
+
+        bool empty() const                      { return m_size == 0; }
+
+        RangeIterator begin() const
+        { return RangeIterator(m_lo, m_stride); }
+        RangeIterator end() const
+        { return RangeIterator(m_lo + m_size*m_stride, m_stride); }
+
+        IndexType size() const                  { return m_size; }
+
+        IndexType operator[](IndexType n) const { return m_lo + n*m_stride; }
+
+        IndexType lo() const                    { return m_lo; }
+        IndexType stride() const                { return m_stride; }
+
+        /// One past the last index in the sequence
+        IndexType hi() const                    { return m_lo + m_size*m_stride; }
+
+        /// True if idx is in the sequence (O(1))
+        bool contains(IndexType idx) const
+        {
+            return ((idx >= m_lo) && (idx < hi()) &&
+                    ((idx - m_lo) % m_stride == 0));
+        }
+
+    private:
+        /// Rejects a zero stride before it is used to compute m_size
+        static IndexType checked_stride(IndexType stride)
+        {
+            if (stride == 0)
+            {
+                throw InvalidValueException("Range: stride must be positive");
+            }
+            return stride;
+        }
+
+        // m_stride must be declared before m_size (see the constructor)
+        IndexType m_lo;
+        IndexType m_stride;
+        IndexType m_size;
+    };
+
+    //**************************************************************************
+
+    // For logging
+    inline std::ostream &operator<<(std::ostream &os, const Range &range)
+    {
+        os << "Range(" << range.lo() << "," << range.hi() << ","
+           << range.stride() << ")";
+        return os;
+    }
+
+    //**************************************************************************
+    //**************************************************************************
+
     // Special marker classes to support AllIndices iteration.
     // NOTE: This should never be used, as we the AllIndicies never gets invoked.
     class AllIndicesIterator
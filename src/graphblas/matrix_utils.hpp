@@ -95,36 +95,120 @@ namespace grb
     template<typename MatrixT>
     void split(MatrixT const &A, MatrixT &L, MatrixT &U)
     {
-        /// @todo assert A, L, and U are same size.
-
         using T = typename MatrixT::ScalarType;
 
-        grb::IndexType nvals(A.nvals());
-
-        grb::IndexArrayType i(nvals), j(nvals);
-        std::vector<T> v(nvals);
-        A.extractTuples(i, j, v);
-
-        IndexArrayType iL,jL, iU,jU;
-        std::vector<T> vL, vU;
+        // One streaming select pass each: L = tril(A), U = triu(A, 1)
+        grb::select(L, grb::NoMask(), grb::NoAccumulate(),
+                    grb::TriL<T>(), A, 0, grb::REPLACE);
+        grb::select(U, grb::NoMask(), grb::NoAccumulate(),
+                    grb::TriU<T>(), A, 1, grb::REPLACE);
+    }
 
-        for (grb::IndexType idx = 0; idx < nvals; ++idx)
+    //************************************************************************
+    /**
+     * @brief Compute the inverse of a permutation: inv[perm[i]] = i.
+     *
+     * @param[in] perm  A permutation of 0..perm.size()-1
+     *
+     * @throw InvalidValueException if perm is not a permutation.
+     */
+    inline IndexArrayType invert_permutation(IndexArrayType const &perm)
+    {
+        IndexType n(perm.size());
+        IndexArrayType inv(n, n);
+        for (IndexType ix = 0; ix < n; ++ix)
         {
-            if (i[idx] < j[idx])
-            {
-                iU.push_back(i[idx]);
-                jU.push_back(j[idx]);
-                vU.push_back(v[idx]);
-            }
-            else
+            if ((perm[ix] >= n) || (inv[perm[ix]] != n))
             {
-                iL.push_back(i[idx]);
-                jL.push_back(j[idx]);
-                vL.push_back(v[idx]);
+                throw InvalidValueException(
+                    "invert_permutation: not a permutation");
             }
+            inv[perm[ix]] = ix;
+        }
+        return inv;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Permute the rows and columns of a matrix:
+     *        C(i,j) = A(row_perm[i], col_perm[j]).
+     *
+     * With row_perm = col_perm = perm, where perm[new_id] = old_id, this
+     * relabels the vertices of a graph.  Any previous contents of C are
+     * replaced.  Each stored element is moved once: O(nvals log nvals).
+     *
+     * @param[out] C         Output matrix (same dimensions as A)
+     * @param[in]  A         Input matrix
+     * @param[in]  row_perm  Permutation of the row indices
+     * @param[in]  col_perm  Permutation of the column indices
+     *
+     * @throw DimensionException if the sizes do not match.
+     * @throw InvalidValueException if either sequence is not a permutation.
+     */
+    template<typename CMatrixT, typename AMatrixT>
+    void permute(CMatrixT             &C,
+                 AMatrixT       const &A,
+                 IndexArrayType const &row_perm,
+                 IndexArrayType const &col_perm)
+    {
+        if ((C.nrows() != A.nrows()) || (C.ncols() != A.ncols()) ||
+            (row_perm.size() != A.nrows()) || (col_perm.size() != A.ncols()))
+        {
+            throw DimensionException("permute: dimensions do not match");
         }
-        L.build(iL.begin(), jL.begin(), vL.begin(), vL.size());
-        U.build(iU.begin(), jU.begin(), vU.begin(), vU.size());
+
+        IndexArrayType row_inv(invert_permutation(row_perm));
+        IndexArrayType col_inv(invert_permutation(col_perm));
+
+        IndexType nvals(A.nvals());
+        IndexArrayType rows(nvals), cols(nvals);
+        std::vector<typename AMatrixT::ScalarType> vals(nvals);
+        A.extractTuples(rows, cols, vals);
+
+        for (IndexType ix = 0; ix < nvals; ++ix)
+        {
+            rows[ix] = row_inv[rows[ix]];
+            cols[ix] = col_inv[cols[ix]];
+        }
+
+        C.clear();
+        C.build(rows, cols, vals);
+    }
+
+    //************************************************************************
+    /**
+     * @brief Permute the elements of a vector: w(i) = u(perm[i]).
+     *
+     * Results computed on a graph relabeled with perm are mapped back to
+     * the original vertex ids with permute(w, u, invert_permutation(perm)).
+     *
+     * @throw DimensionException if the sizes do not match.
+     * @throw InvalidValueException if perm is not a permutation.
+     */
+    template<typename WVectorT, typename UVectorT>
+    void permute(WVectorT             &w,
+                 UVectorT       const &u,
+                 IndexArrayType const &perm)
+    {
+        if ((w.size() != u.size()) || (perm.size() != u.size()))
+        {
+            throw DimensionException("permute: dimensions do not match");
+        }
+
+        IndexArrayType inv(invert_permutation(perm));
+
+        IndexType nvals(u.nvals());
+        IndexArrayType indices(nvals);
+        std::vector<typename UVectorT::ScalarType> vals(nvals);
+        u.extractTuples(indices, vals);
+
+        for (auto &idx : indices)
+        {
+            idx = inv[idx];
+        }
+
+        w.clear();
+        w.build(indices, vals);
     }
 
     //************************************************************************
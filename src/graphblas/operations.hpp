@@ -948,6 +948,101 @@ namespace grb
         }
     }
 
+    //************************************************************************
+    // Select (GraphBLAS 2.0)
+    //************************************************************************
+
+    /**
+     * @brief w<m,z> := u(op(u, i, 0, thunk)): keep the stored elements of
+     *        u for which the index unary operator returns true.
+     *
+     * @param[in] op     Index unary operator (e.g., ValueGT, RowLE)
+     * @param[in] thunk  Scalar passed as the last argument of op
+     */
+    template<typename WScalarT,
+             typename MaskT,
+             typename AccumT,
+             typename IndexUnaryOpT,
+             typename UVectorT,
+             typename ValueT,
+             typename ...WTagsT>
+    inline void select(Vector<WScalarT, WTagsT...> &w,
+                       MaskT                 const &mask,
+                       AccumT                const &accum,
+                       IndexUnaryOpT                op,
+                       UVectorT              const &u,
+                       ValueT                const &thunk,
+                       OutputControlEnum            outp = MERGE)
+    {
+        GRB_LOG_FN_BEGIN("select - vector variant");
+        GRB_LOG_VERBOSE("w in: " << get_internal_vector(w));
+        GRB_LOG_VERBOSE("mask in: " << get_internal_vector(mask));
+        GRB_LOG_VERBOSE_ACCUM(accum);
+        GRB_LOG_VERBOSE_OP(op);
+        GRB_LOG_VERBOSE("u in: " << get_internal_vector(u));
+        GRB_LOG_VERBOSE_OUTP(outp);
+
+        check_size_size(w, mask, "select(vec): w.size != mask.size");
+        check_size_size(w, u, "select(vec): w.size != u.size");
+
+        backend::select(get_internal_vector(w),
+                        get_internal_vector(mask),
+                        accum, op,
+                        get_internal_vector(u),
+                        thunk, outp);
+
+        GRB_LOG_VERBOSE("w out: " << get_internal_vector(w));
+        GRB_LOG_FN_END("select - vector variant");
+    }
+
+    /**
+     * @brief C<M,z> := A(op(A, i, j, thunk)): keep the stored elements of A
+     *        (or A') for which the index unary operator returns true.
+     *
+     * For example, select(L, NoMask(), NoAccumulate(), TriL<T>(), A, -1)
+     * extracts the strictly lower triangle of A in one pass.
+     *
+     * @param[in] op     Index unary operator (e.g., TriL, OffDiag, ValueLE)
+     * @param[in] thunk  Scalar passed as the last argument of op
+     */
+    template<typename CScalarT,
+             typename MaskT,
+             typename AccumT,
+             typename IndexUnaryOpT,
+             typename AMatrixT,
+             typename ValueT,
+             typename ...CTagsT>
+    inline void select(Matrix<CScalarT, CTagsT...> &C,
+                       MaskT                 const &Mask,
+                       AccumT                const &accum,
+                       IndexUnaryOpT                op,
+                       AMatrixT              const &A,
+                       ValueT                const &thunk,
+                       OutputControlEnum            outp = MERGE)
+    {
+        GRB_LOG_FN_BEGIN("select - matrix variant");
+        GRB_LOG_VERBOSE("C in: " << get_internal_matrix(C));
+        GRB_LOG_VERBOSE("Mask in: " << get_internal_matrix(Mask));
+        GRB_LOG_VERBOSE_ACCUM(accum);
+        GRB_LOG_VERBOSE_OP(op);
+        GRB_LOG_VERBOSE("A in: " << A);
+        GRB_LOG_VERBOSE_OUTP(outp);
+
+        check_ncols_ncols(C, Mask, "select(mat): C.ncols != Mask.ncols");
+        check_nrows_nrows(C, Mask, "select(mat): C.nrows != Mask.nrows");
+        check_ncols_ncols(C, A, "select(mat): C.ncols != A.ncols");
+        check_nrows_nrows(C, A, "select(mat): C.nrows != A.nrows");
+
+        backend::select(get_internal_matrix(C),
+                        get_internal_matrix(Mask),
+                        accum, op,
+                        get_internal_matrix(A),
+                        thunk, outp);
+
+        GRB_LOG_VERBOSE("C out: " << get_internal_matrix(C));
+        GRB_LOG_FN_END("select - matrix variant");
+    }
+
     //************************************************************************
     // reduce
     //************************************************************************
@@ -1120,6 +1215,37 @@ namespace grb
         GRB_LOG_FN_END("kronecker - 4.3.11");
     }
 
+    /**
+     * @brief Stream the rows of kron(A, B) without forming the product.
+     *
+     * Calls fn(row_index, row) for every nonempty row of the product in
+     * increasing row order, where row is a std::vector of (column, value)
+     * tuples sorted by column.  Only one row exists at a time, so this is
+     * the way to generate products too large to hold (e.g., Kronecker
+     * powers of a seed graph written straight to an edge list file):
+     *
+     *     kronecker_rows(K, K2, Times<T>(),
+     *                    [&os](IndexType i, auto const &row)
+     *                    { for (auto&& [j, v] : row) os << i << ' ' << j << '\n'; });
+     *
+     * A and B may be transposed views.
+     */
+    template<typename AMatrixT,
+             typename BMatrixT,
+             typename BinaryOpT,
+             typename RowFnT>
+    inline void kronecker_rows(AMatrixT    const &A,
+                               BMatrixT    const &B,
+                               BinaryOpT          op,
+                               RowFnT             fn)
+    {
+        GRB_LOG_FN_BEGIN("kronecker_rows");
+        backend::kronecker_rows(get_internal_matrix(A),
+                                get_internal_matrix(B),
+                                op, fn);
+        GRB_LOG_FN_END("kronecker_rows");
+    }
+
     //************************************************************************
     // Context etc.
     //************************************************************************
@@ -1128,6 +1254,13 @@ namespace grb
     template <typename T>
     void wait(T&& obj) {}
 
+    /// Assemble any single element updates buffered by the matrix
+    template <typename ScalarT, typename... TagsT>
+    void wait(Matrix<ScalarT, TagsT...> &A)
+    {
+        get_internal_matrix(A).wait();
+    }
+
     //************************************************************************
     // Views
     //************************************************************************
@@ -0,0 +1,271 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+
+namespace grb
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /**
+         * @brief The hand-tuned kernels available for a semiring.
+         *
+         * The generic kernels call semiring.add()/semiring.mult() element by
+         * element through a serial dependency on the running result, and
+         * have to test u's bitmap for every element.  For the semirings
+         * below the operators are known exactly, so the kernels can be
+         * written with plain arithmetic, multiple independent partial
+         * results (which the compiler can keep in vector registers), and
+         * the monoid identity in place of the "value set" test.
+         */
+        enum class SemiringKernel
+        {
+            GENERIC,        ///< user defined or unlisted: use add()/mult()
+            PLUS_TIMES,     ///< ArithmeticSemiring on a numeric type
+            MIN_PLUS,       ///< MinPlusSemiring on an integer type
+            LOGICAL_OR_AND  ///< LogicalSemiring on bool (bitmap kernels)
+        };
+
+        //**********************************************************************
+        // Registry mapping known (monoid, binary op, domain) triples to their
+        // kernel.  All three domains must agree; anything not listed here,
+        // including semirings built from user lambdas, is GENERIC.
+        //**********************************************************************
+        template <typename SemiringT>
+        struct semiring_kernel_traits
+        {
+            static constexpr SemiringKernel kernel = SemiringKernel::GENERIC;
+        };
+
+        template <typename D>
+        struct semiring_kernel_traits<ArithmeticSemiring<D, D, D>>
+        {
+            static constexpr SemiringKernel kernel =
+                (std::is_arithmetic_v<D> && !std::is_same_v<D, bool>) ?
+                SemiringKernel::PLUS_TIMES : SemiringKernel::GENERIC;
+        };
+
+        /// @note Floating point min-plus stays generic: Min is not std::min
+        /// in the presence of NaNs.
+        template <typename D>
+        struct semiring_kernel_traits<MinPlusSemiring<D, D, D>>
+        {
+            static constexpr SemiringKernel kernel =
+                (std::is_integral_v<D> && !std::is_same_v<D, bool>) ?
+                SemiringKernel::MIN_PLUS : SemiringKernel::GENERIC;
+        };
+
+        template <>
+        struct semiring_kernel_traits<LogicalSemiring<bool, bool, bool>>
+        {
+            static constexpr SemiringKernel kernel =
+                SemiringKernel::LOGICAL_OR_AND;
+        };
+
+        template <typename SemiringT>
+        inline constexpr SemiringKernel semiring_kernel_v =
+            semiring_kernel_traits<SemiringT>::kernel;
+
+        /// Semirings with a scalar arithmetic kernel (dense_dot/dense_axpy)
+        template <typename SemiringT>
+        inline constexpr bool is_arithmetic_kernel_v =
+            (semiring_kernel_v<SemiringT> == SemiringKernel::PLUS_TIMES) ||
+            (semiring_kernel_v<SemiringT> == SemiringKernel::MIN_PLUS);
+
+        //**********************************************************************
+        /**
+         * @brief Dot product of a sparse row with a dense vector of values,
+         *        a_row * u_vals, for a semiring with an arithmetic kernel.
+         *
+         * Every element of u must be stored.  The row is consumed by four
+         * independent partial results that are combined at the end, which
+         * breaks the loop-carried dependency on the running sum.
+         *
+         * @note For floating point plus-times the summation order differs
+         *       from the generic kernel, so results may differ in the last
+         *       bits.
+         *
+         * @return false if the row is empty (no value produced).
+         */
+        template <typename SemiringT, typename D1, typename UValsT, typename D3>
+        bool dense_dot(D3                                                &ans,
+                       std::vector<std::tuple<grb::IndexType,D1> > const &A_row,
+                       UValsT                                      const &u_vals,
+                       SemiringT                                   const &op)
+        {
+            static_assert(is_arithmetic_kernel_v<SemiringT>);
+
+            if (A_row.empty())
+            {
+                return false;
+            }
+
+            D3 const identity(op.zero());
+            D3 part[4] = {identity, identity, identity, identity};
+
+            auto combine = [](D3 &lhs, D3 rhs)
+            {
+                if constexpr (semiring_kernel_v<SemiringT> ==
+                              SemiringKernel::PLUS_TIMES)
+                    lhs += rhs;
+                else
+                    lhs = std::min(lhs, rhs);
+            };
+
+            auto product = [&u_vals](auto const &elt) -> D3
+            {
+                auto&& [a_idx, a_val] = elt;
+                D3 const a(static_cast<D3>(a_val));
+                D3 const u(static_cast<D3>(u_vals[a_idx]));
+                if constexpr (semiring_kernel_v<SemiringT> ==
+                              SemiringKernel::PLUS_TIMES)
+                    return static_cast<D3>(a * u);
+                else
+                    return static_cast<D3>(a + u);
+            };
+
+            size_t const n(A_row.size());
+            size_t const n4(n - n % 4);
+            for (size_t k = 0; k < n4; k += 4)
+            {
+                combine(part[0], product(A_row[k]));
+                combine(part[1], product(A_row[k + 1]));
+                combine(part[2], product(A_row[k + 2]));
+                combine(part[3], product(A_row[k + 3]));
+            }
+            for (size_t k = n4; k < n; ++k)
+            {
+                combine(part[0], product(A_row[k]));
+            }
+
+            combine(part[0], part[1]);
+            combine(part[2], part[3]);
+            combine(part[0], part[2]);
+            ans = part[0];
+            return true;
+        }
+
+        //**********************************************************************
+        /**
+         * @brief Whether dense_axpy is worth its O(ncols) setup for u * A.
+         *
+         * The dense accumulator is allocated and scanned across every column
+         * of A, so it only pays off when u is full or the number of products
+         * (the sum of the lengths of the rows selected by u) is a sizeable
+         * fraction of ncols.  Sparse frontiers (BFS, k-core, Louvain) stay
+         * on the sorted-merge axpy whose cost is proportional to the work.
+         */
+        template <typename UVectorT, typename AMatrixT>
+        bool dense_axpy_pays_off(UVectorT const &u, AMatrixT const &A)
+        {
+            // products per output column above which dense_axpy wins
+            IndexType const DENSE_AXPY_RATIO(16);
+
+            if (u.nvals() == u.size())
+            {
+                return true;
+            }
+
+            IndexType const threshold(A.ncols()/DENSE_AXPY_RATIO);
+            IndexType flops(0);
+            for (auto&& [row_idx, u_val] : u.nonzeros())
+            {
+                flops += A[row_idx].size();
+                if (flops > threshold)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        //**********************************************************************
+        /**
+         * @brief t = u * A (or A' * u) with a dense accumulator, for a
+         *        semiring with an arithmetic kernel.
+         *
+         * The result row is held in an array initialized to the monoid
+         * identity, so each product is folded in unconditionally without
+         * searching or inserting into a sorted list.  Which columns were
+         * touched is tracked separately so that the structure of t is
+         * exactly that of the generic kernel.
+         *
+         * @param[out] t  Sorted (index, value) list of the result; must be
+         *                empty on entry.
+         */
+        template <typename TScalarT,
+                  typename SemiringT,
+                  typename UVectorT,
+                  typename AMatrixT>
+        void dense_axpy(std::vector<std::tuple<IndexType, TScalarT> > &t,
+                        SemiringT                               const &op,
+                        UVectorT                                const &u,
+                        AMatrixT                                const &A)
+        {
+            static_assert(is_arithmetic_kernel_v<SemiringT>);
+
+            IndexType const num_cols(A.ncols());
+            std::vector<TScalarT> t_vals(num_cols,
+                                         static_cast<TScalarT>(op.zero()));
+            std::vector<uint8_t>  t_set(num_cols, 0);
+
+            for (auto&& [row_idx, u_val] : u.nonzeros())
+            {
+                TScalarT const u_i(static_cast<TScalarT>(u_val));
+                for (auto&& [j, a_ij] : A[row_idx])
+                {
+                    TScalarT const a(static_cast<TScalarT>(a_ij));
+                    if constexpr (semiring_kernel_v<SemiringT> ==
+                                  SemiringKernel::PLUS_TIMES)
+                        t_vals[j] += static_cast<TScalarT>(u_i * a);
+                    else
+                        t_vals[j] = std::min(t_vals[j],
+                                             static_cast<TScalarT>(u_i + a));
+                    t_set[j] = 1;
+                }
+            }
+
+            for (IndexType j = 0; j < num_cols; ++j)
+            {
+                if (t_set[j])
+                {
+                    t.emplace_back(j, t_vals[j]);
+                }
+            }
+        }
+    } // backend
+} // grb
@@ -70,7 +70,7 @@ namespace grb
 
             if (u.nvals() > 0)
             {
-                for (auto&& [idx, val] : u.getContents()) {
+                for (auto&& [idx, val] : u.nonzeros()) {
                     t_contents.emplace_back(idx, op(val));
                 }
             }
@@ -236,7 +236,7 @@ namespace grb
 
             if (u.nvals() > 0)
             {
-                for (auto&& [idx, u_val] : u.getContents()) {
+                for (auto&& [idx, u_val] : u.nonzeros()) {
                     t_contents.emplace_back(idx, op(val, u_val));
                 }
             }
@@ -292,7 +292,7 @@ namespace grb
 
             if (u.nvals() > 0)
             {
-                for (auto&& [idx, u_val] : u.getContents()) {
+                for (auto&& [idx, u_val] : u.nonzeros()) {
                     t_contents.emplace_back(idx, op(u_val, val));
                 }
             }
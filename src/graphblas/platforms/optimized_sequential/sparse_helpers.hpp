@@ -32,15 +32,20 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <utility>
 #include <vector>
 #include <iterator>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <graphblas/algebra.hpp>
 #include <graphblas/indices.hpp>
 
+#include "PackedBitmap.hpp"
+#include "RowPartition.hpp"
+
 //****************************************************************************
 
 namespace grb
@@ -141,59 +146,82 @@ namespace grb
         }
 
         //**********************************************************************
-        /// Perform the dot product of a row of a matrix with a sparse vector
-        /// without pulling the indices out of the vector first.
-        template <typename D1, typename D2, typename D3, typename SemiringT>
+        /// Perform the dot product of a bitmap vector with a row of a matrix
+        /// (u' * A_row) by looking up the row's indices in u's bitmap, without
+        /// pulling the contents out of the vector first.
+        template <typename UVectorT, typename D1, typename D3, typename SemiringT>
         bool dot2(D3                                                &ans,
+                  UVectorT                                    const &u,
                   std::vector<std::tuple<grb::IndexType,D1> > const &A_row,
-                  std::vector<bool>                           const &u_bitmap,
-                  std::vector<D2>                             const &u_vals,
-                  grb::IndexType                                     u_nvals,
                   SemiringT                                          op)
         {
-            bool value_set(false);
-            ans = op.zero();
-
-            if ((u_nvals == 0) || A_row.empty())
+            // Known arithmetic semirings with a full u skip the bitmap
+            if constexpr (is_arithmetic_kernel_v<SemiringT>)
             {
-                return value_set;
+                if (u.nvals() == u.size())
+                {
+                    return dense_dot(ans, A_row, u.get_vals(), op);
+                }
             }
 
-            // find first stored value in u
-            grb::IndexType u_idx(0);
-            while (!u_bitmap[u_idx]) ++u_idx; // skip unstored elements
-
-            // pull first value out of the row
-            auto A_iter = A_row.begin();
-            D1 a_val;
-            grb::IndexType a_idx;
+            bool value_set(false);
+            auto const &u_bitmap(u.get_bitmap());
+            auto const &u_vals(u.get_vals());
 
-            // loop through both ordered sets to compute sparse dot prod
-            while ((A_iter != A_row.end()) && (u_idx < u_vals.size()))
+            for (auto&& [a_idx, a_val] : A_row)
             {
-                std::tie(a_idx, a_val) = *A_iter;
-                if (u_idx == a_idx)
+                if (u_bitmap[a_idx])
                 {
                     if (value_set)
                     {
-                        ans = op.add(ans, op.mult(a_val, u_vals[u_idx]));
+                        ans = op.add(ans, op.mult(u_vals[a_idx], a_val));
                     }
                     else
                     {
-                        ans = op.mult(a_val, u_vals[u_idx]);
+                        ans = op.mult(u_vals[a_idx], a_val);
                         value_set = true;
                     }
-
-                    do { ++u_idx; } while ((u_idx < u_vals.size()) && !u_bitmap[u_idx]);
-                    ++A_iter;
                 }
-                else if (u_idx > a_idx)
+            }
+
+            return value_set;
+        }
+
+        //**********************************************************************
+        /// Perform the dot product of a row of a matrix with a bitmap vector
+        /// (A_row * u), keeping the operand order of op.
+        template <typename D1, typename UVectorT, typename D3, typename SemiringT>
+        bool dot2_rev(D3                                                &ans,
+                      std::vector<std::tuple<grb::IndexType,D1> > const &A_row,
+                      UVectorT                                    const &u,
+                      SemiringT                                          op)
+        {
+            // Known arithmetic semirings with a full u skip the bitmap
+            if constexpr (is_arithmetic_kernel_v<SemiringT>)
+            {
+                if (u.nvals() == u.size())
                 {
-                    ++A_iter;
+                    return dense_dot(ans, A_row, u.get_vals(), op);
                 }
-                else
+            }
+
+            bool value_set(false);
+            auto const &u_bitmap(u.get_bitmap());
+            auto const &u_vals(u.get_vals());
+
+            for (auto&& [a_idx, a_val] : A_row)
+            {
+                if (u_bitmap[a_idx])
                 {
-                    do { ++u_idx; } while ((u_idx < u_vals.size()) && !u_bitmap[u_idx]);
+                    if (value_set)
+                    {
+                        ans = op.add(ans, op.mult(a_val, u_vals[a_idx]));
+                    }
+                    else
+                    {
+                        ans = op.mult(a_val, u_vals[a_idx]);
+                        value_set = true;
+                    }
                 }
             }
 
@@ -305,37 +333,41 @@ namespace grb
         }
 
         //************************************************************************
-        /// A reduction of a sparse vector (vector<tuple(index,value)>) using a
-        /// binary op or a monoid.
-        template <typename D1, typename D3, typename BinaryOpT>
+        /// A reduction of a sparse vector (any ordered range of tuple(index,
+        /// value), e.g. a matrix row or BitmapSparseVector::nonzeros()) using
+        /// a binary op or a monoid.
+        template <typename D3, typename SparseVectorT, typename BinaryOpT>
         bool reduction(
             D3                                                &ans,
-            std::vector<std::tuple<grb::IndexType,D1> > const &vec,
+            SparseVectorT                               const &vec,
             BinaryOpT                                          op)
         {
-            if (vec.empty())
+            auto it = vec.begin();
+            if (it == vec.end())
             {
                 return false;
             }
 
+            using D1 = std::decay_t<decltype(std::get<1>(*it))>;
             using D3ScalarType =
                 decltype(op(std::declval<D1>(), std::declval<D1>()));
             D3ScalarType tmp;
 
-            if (vec.size() == 1)
+            D1 first_val(std::get<1>(*it));
+            if (++it == vec.end())
             {
-                tmp = static_cast<D3ScalarType>(std::get<1>(vec[0]));
+                tmp = static_cast<D3ScalarType>(first_val);
             }
             else
             {
                 /// @note Since op is associative and commutative left to right
                 /// ordering is not strictly required.
-                tmp = op(std::get<1>(vec[0]), std::get<1>(vec[1]));
+                tmp = op(first_val, std::get<1>(*it));
 
                 /// @todo replace with call to std::reduce?
-                for (size_t idx = 2; idx < vec.size(); ++idx)
+                for (++it; it != vec.end(); ++it)
                 {
-                    tmp = op(tmp, std::get<1>(vec[idx]));
+                    tmp = op(tmp, std::get<1>(*it));
                 }
             }
 
@@ -348,10 +380,12 @@ namespace grb
         /// ans = op(vec1, vec2)
         ///
         /// @note ans must be a unique vector from either vec1 or vec2
-        template <typename D1, typename D2, typename D3, typename BinaryOpT>
+        /// @note the inputs can be any ordered ranges of tuple(index,value)
+        template <typename D3, typename Vector1T, typename Vector2T,
+                  typename BinaryOpT>
         void ewise_or(std::vector<std::tuple<grb::IndexType,D3> >       &ans,
-                      std::vector<std::tuple<grb::IndexType,D1> > const &vec1,
-                      std::vector<std::tuple<grb::IndexType,D2> > const &vec2,
+                      Vector1T                                    const &vec1,
+                      Vector2T                                    const &vec2,
                       BinaryOpT                                          op)
         {
             if (((void*)&ans == (void*)&vec1) || ((void*)&ans == (void*)&vec2))
@@ -415,7 +449,7 @@ namespace grb
         // This is where we turn alls into the correct range
 
         template <typename SequenceT>
-        bool searchIndices(SequenceT seq, IndexType n)
+        bool searchIndices(SequenceT const &seq, IndexType n)
         {
             for (auto it : seq)
             {
@@ -429,6 +463,11 @@ namespace grb
             return true;
         }
 
+        inline bool searchIndices(Range const &seq, IndexType n)
+        {
+            return seq.contains(n);
+        }
+
         //**********************************************************************
         /// Apply element-wise operation to union on sparse vectors.
         /// Indices in the stencil indicate where elements of vec2 should be
@@ -463,7 +502,7 @@ namespace grb
             std::vector<std::tuple<grb::IndexType,D3> >       &ans,
             std::vector<std::tuple<grb::IndexType,D1> > const &vec1,
             std::vector<std::tuple<grb::IndexType,D2> > const &vec2,
-            SequenceT                                          stencil_indices)
+            SequenceT                                   const &stencil_indices)
         {
             ans.clear();
 
@@ -549,7 +588,7 @@ namespace grb
             BinaryOpT                                               accum)
         {
             // If there is an accumulate operations, do nothing with the stencil
-            ewise_or(z, w.getContents(), t, accum);
+            ewise_or(z, w.nonzeros(), t, accum);
         }
 
         //**********************************************************************
@@ -686,7 +725,7 @@ namespace grb
             BinaryOpT                                               accum)
         {
             //z.clear();
-            ewise_or(z, w.getContents(), t, accum);
+            ewise_or(z, w.nonzeros(), t, accum);
         }
 
         //**********************************************************************
@@ -736,10 +775,12 @@ namespace grb
 
         //************************************************************************
         /// Apply element-wise operation to intersection of sparse vectors.
-        template <typename D1, typename D2, typename D3, typename BinaryOpT>
+        /// @note the inputs can be any ordered ranges of tuple(index,value)
+        template <typename D3, typename Vector1T, typename Vector2T,
+                  typename BinaryOpT>
         void ewise_and(std::vector<std::tuple<grb::IndexType,D3> >       &ans,
-                       std::vector<std::tuple<grb::IndexType,D1> > const &vec1,
-                       std::vector<std::tuple<grb::IndexType,D2> > const &vec2,
+                       Vector1T                                    const &vec1,
+                       Vector2T                                    const &vec2,
                        BinaryOpT                                          op)
         {
             ans.clear();
@@ -879,76 +920,99 @@ namespace grb
         //**********************************************************************
 
         //**********************************************************************
-        // WARNING: costly
-        template <typename MatrixT>
-        decltype(auto)
-        get_structure_row(MatrixT const &mat, IndexType row_idx)
+        /**
+         * @brief Apply one packed mask row to the corresponding rows of C
+         *        and Z (see apply_with_mask for the semantics).
+         *
+         * Rows the mask admits entirely or not at all are resolved from the
+         * packed row count without a membership test per element.
+         *
+         * @return false if the result equals c_vec (nothing to write).
+         */
+        template <typename CScalarT, typename ZScalarT>
+        bool apply_with_packed_mask(
+            std::vector<std::tuple<IndexType, CScalarT> >          &result,
+            std::vector<std::tuple<IndexType, CScalarT> > const    &c_vec,
+            std::vector<std::tuple<IndexType, ZScalarT> > const    &z_vec,
+            MaskRow                                                 mask,
+            OutputControlEnum                                       outp)
         {
-            std::vector<std::tuple<IndexType, bool> > mask_tuples;
-            mask_tuples.reserve(mat.ncols() - mat[row_idx].size());
+            result.clear();
 
-            for (auto&& [ix, val] : mat[row_idx])
+            if (mask.admits_none())
             {
-                mask_tuples.emplace_back(ix, true);
+                // C outside the mask is everything: kept or replaced by none
+                return (outp == REPLACE) && !c_vec.empty();
             }
 
-            return mask_tuples;
-        }
-
-        //**********************************************************************
-        // WARNING: costly
-        template <typename MatrixT>
-        decltype(auto)
-        get_complement_row(MatrixT const &mat, IndexType row_idx)
-        {
-            std::vector<std::tuple<IndexType, bool> > mask_tuples;
-            auto &row_tuples = mat[row_idx];
-            mask_tuples.reserve(mat.ncols() - row_tuples.size());
-            auto it = row_tuples.begin();
-
-            for (IndexType ix = 0; ix < mat.ncols(); ++ix)
+            if (mask.admits_all())
             {
-                if ((it == row_tuples.end()) || (ix < std::get<0>(*it)))
+                for (auto&& [idx, val] : z_vec)
                 {
-                    mask_tuples.emplace_back(ix, true);
+                    result.emplace_back(idx, static_cast<CScalarT>(val));
                 }
-                else
+                return true;
+            }
+
+            auto c_it = c_vec.begin();
+            auto z_it = z_vec.begin();
+            while ((c_it != c_vec.end()) || (z_it != z_vec.end()))
+            {
+                IndexType c_idx((c_it == c_vec.end()) ?
+                                std::numeric_limits<IndexType>::max() :
+                                std::get<0>(*c_it));
+                IndexType z_idx((z_it == z_vec.end()) ?
+                                std::numeric_limits<IndexType>::max() :
+                                std::get<0>(*z_it));
+                IndexType idx(std::min(c_idx, z_idx));
+
+                if (mask.admits(idx))
                 {
-                    if (static_cast<bool>(std::get<1>(*it)) == false)
+                    // inside the mask Z wins; C is dropped
+                    if (z_idx == idx)
                     {
-                        mask_tuples.emplace_back(ix, true);
+                        result.emplace_back(
+                            idx, static_cast<CScalarT>(std::get<1>(*z_it)));
                     }
-                    ++it;
                 }
-            }
+                else if ((outp == MERGE) && (c_idx == idx))
+                {
+                    // outside the mask C is kept when merging
+                    result.emplace_back(*c_it);
+                }
 
-            return mask_tuples;
+                if (c_idx == idx) ++c_it;
+                if (z_idx == idx) ++z_it;
+            }
+            return true;
         }
 
         //**********************************************************************
-        // WARNING: costly
-        template <typename MatrixT>
-        decltype(auto)
-        get_structural_complement_row(MatrixT const &mat, IndexType row_idx)
+        // C<M,z> = Z for any matrix mask, one packed mask row at a time
+        template < typename CMatrixT,
+                   typename ZMatrixT>
+        void write_with_packed_mask(CMatrixT              &C,
+                                    ZMatrixT      const   &Z,
+                                    PackedMaskRows const  &mask,
+                                    bool                   complement_flag,
+                                    OutputControlEnum      outp)
         {
-            std::vector<std::tuple<IndexType, bool> > mask_tuples;
-            auto &row_tuples = mat[row_idx];
-            mask_tuples.reserve(mat.ncols() - row_tuples.size());
-            auto it = row_tuples.begin();
+            using CScalarType = typename CMatrixT::ScalarType;
+            using CRowType = std::vector<std::tuple<IndexType, CScalarType> >;
 
-            for (IndexType ix = 0; ix < mat.ncols(); ++ix)
+            CRowType tmp_row;
+            IndexType nRows(C.nrows());
+            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
             {
-                if ((it == row_tuples.end()) || (ix < std::get<0>(*it)))
-                {
-                    mask_tuples.emplace_back(ix, true);
-                }
-                else
+                auto const &C_row(static_cast<CMatrixT const &>(C)[row_idx]);
+                if (apply_with_packed_mask(tmp_row, C_row, Z[row_idx],
+                                           MaskRow(mask, row_idx,
+                                                   complement_flag),
+                                           outp))
                 {
-                    ++it;
+                    C.setRow(row_idx, tmp_row);
                 }
             }
-
-            return mask_tuples;
         }
 
         //**********************************************************************
@@ -961,19 +1025,8 @@ namespace grb
                                  MMatrixT   const   &Mask,
                                  OutputControlEnum   outp)
         {
-            using CScalarType = typename CMatrixT::ScalarType;
-            using CRowType = std::vector<std::tuple<IndexType, CScalarType> >;
-
-            CRowType tmp_row;
-            IndexType nRows(C.nrows());
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
-            {
-                apply_with_mask(tmp_row, C[row_idx], Z[row_idx],
-                                Mask[row_idx], outp);
-
-                // Now, set the new one.  Yes, we can optimize this later
-                C.setRow(row_idx, tmp_row);
-            }
+            auto mask(Mask.packedMask(false));
+            write_with_packed_mask(C, Z, *mask, false, outp);
         }
 
         //**********************************************************************
@@ -987,20 +1040,8 @@ namespace grb
             grb::MatrixComplementView<MMatrixT> const &Mask,
             OutputControlEnum                          outp)
         {
-            using CScalarType = typename CMatrixT::ScalarType;
-            using CRowType = std::vector<std::tuple<IndexType, CScalarType> >;
-
-            CRowType tmp_row;
-            IndexType nRows(C.nrows());
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
-            {
-                apply_with_mask(tmp_row, C[row_idx], Z[row_idx],
-                                get_complement_row(Mask.m_mat, row_idx),
-                                outp);
-
-                // Now, set the new one.  Yes, we can optimize this later
-                C.setRow(row_idx, tmp_row);
-            }
+            auto mask(Mask.m_mat.packedMask(false));
+            write_with_packed_mask(C, Z, *mask, true, outp);
         }
 
         //**********************************************************************
@@ -1014,20 +1055,8 @@ namespace grb
             grb::MatrixStructureView<MMatrixT> const &Mask,
             OutputControlEnum                         outp)
         {
-            using CScalarType = typename CMatrixT::ScalarType;
-            using CRowType = std::vector<std::tuple<IndexType, CScalarType> >;
-
-            CRowType tmp_row;
-            IndexType nRows(C.nrows());
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
-            {
-                apply_with_mask(tmp_row, C[row_idx], Z[row_idx],
-                                get_structure_row(Mask.m_mat, row_idx),
-                                outp);
-
-                // Now, set the new one.  Yes, we can optimize this later
-                C.setRow(row_idx, tmp_row);
-            }
+            auto mask(Mask.m_mat.packedMask(true));
+            write_with_packed_mask(C, Z, *mask, false, outp);
         }
 
         //**********************************************************************
@@ -1041,20 +1070,8 @@ namespace grb
             grb::MatrixStructuralComplementView<MMatrixT> const &Mask,
             OutputControlEnum                                    outp)
         {
-            using CScalarType = typename CMatrixT::ScalarType;
-            using CRowType = std::vector<std::tuple<IndexType, CScalarType> >;
-
-            CRowType tmp_row;
-            IndexType nRows(C.nrows());
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
-            {
-                apply_with_mask(tmp_row, C[row_idx], Z[row_idx],
-                                get_structural_complement_row(Mask.m_mat, row_idx),
-                                outp);
-
-                // Now, set the new one.  Yes, we can optimize this later
-                C.setRow(row_idx, tmp_row);
-            }
+            auto mask(Mask.m_mat.packedMask(true));
+            write_with_packed_mask(C, Z, *mask, true, outp);
         }
 
         //**********************************************************************
@@ -1070,165 +1087,339 @@ namespace grb
         }
 
         //**********************************************************************
-        // Vector Mask Churn
+        // Matrix Mask Row Lookup: true when the mask admits no column of a
+        // row, so that row of a product does not need to be computed.
         //**********************************************************************
 
         //**********************************************************************
-        // WARNING: costly
-        template <typename VectorT>
-        decltype(auto)
-        get_structure_contents(VectorT const &vec)
+        /// A complemented mask row admits nothing only when every column is
+        /// stored (and true, unless it is used for structure only).
+        template <typename MScalarT>
+        bool complement_row_is_full(
+            std::vector<std::tuple<IndexType, MScalarT>> const &m,
+            IndexType                                           ncols,
+            bool                                                structure_flag)
         {
-            std::vector<std::tuple<IndexType, bool> > mask_tuples;
+            if (m.size() != ncols) return false;
+            if (structure_flag) return true;
 
-            for (auto [ix, val] : vec.getContents())
+            for (auto&& [ix, val] : m)
             {
-                mask_tuples.emplace_back(ix, true);
+                if (!static_cast<bool>(val)) return false;
             }
+            return true;
+        }
+
+        //**********************************************************************
+        inline bool mask_excludes_row(grb::NoMask const &, IndexType)
+        {
+            return false;
+        }
 
-            return mask_tuples;
+        //**********************************************************************
+        template <typename MMatrixT>
+        bool mask_excludes_row(MMatrixT const &mask, IndexType row_idx)
+        {
+            return mask[row_idx].empty();
+        }
+
+        //**********************************************************************
+        template <typename MMatrixT>
+        bool mask_excludes_row(grb::MatrixStructureView<MMatrixT> const &mask,
+                               IndexType                                 row_idx)
+        {
+            return mask.m_mat[row_idx].empty();
+        }
+
+        //**********************************************************************
+        template <typename MMatrixT>
+        bool mask_excludes_row(grb::MatrixComplementView<MMatrixT> const &mask,
+                               IndexType                                  row_idx)
+        {
+            return complement_row_is_full(mask.m_mat[row_idx],
+                                          mask.m_mat.ncols(), false);
+        }
+
+        //**********************************************************************
+        template <typename MMatrixT>
+        bool mask_excludes_row(
+            grb::MatrixStructuralComplementView<MMatrixT> const &mask,
+            IndexType                                            row_idx)
+        {
+            return complement_row_is_full(mask.m_mat[row_idx],
+                                          mask.m_mat.ncols(), true);
+        }
+
+        //**********************************************************************
+        // Vector Mask Lookup: masks are tested in place through their bitmaps
+        //**********************************************************************
+
+        //**********************************************************************
+        inline bool check_mask_1D(grb::NoMask const &, IndexType)
+        {
+            return true;
         }
 
         //**********************************************************************
-        // WARNING: costly
         template <typename VectorT>
-        decltype(auto)
-        get_complement_contents(VectorT const &vec)
+        bool check_mask_1D(VectorT const &mask, IndexType idx)
         {
-            std::vector<std::tuple<IndexType, bool> > mask_tuples;
-            auto row_tuples(vec.getContents());
-            auto it = row_tuples.begin();
+            return (mask.get_bitmap()[idx] &&
+                    static_cast<bool>(mask.get_vals()[idx]));
+        }
+
+        //**********************************************************************
+        template <typename VectorT>
+        bool check_mask_1D(grb::VectorComplementView<VectorT> const &mask,
+                           IndexType                                 idx)
+        {
+            return !check_mask_1D(mask.m_vec, idx);
+        }
+
+        //**********************************************************************
+        template <typename VectorT>
+        bool check_mask_1D(grb::VectorStructureView<VectorT> const &mask,
+                           IndexType                                idx)
+        {
+            return mask.m_vec.get_bitmap()[idx];
+        }
+
+        //**********************************************************************
+        template <typename VectorT>
+        bool check_mask_1D(
+            grb::VectorStructuralComplementView<VectorT> const &mask,
+            IndexType                                           idx)
+        {
+            return !mask.m_vec.get_bitmap()[idx];
+        }
+
+        //**********************************************************************
+        // Word-parallel support for boolean vectors.  Intermediate results
+        // are held as a structure bitmap plus packed values, both of size n.
+        //**********************************************************************
 
-            for (IndexType ix = 0; ix < vec.size(); ++ix)
+        //**********************************************************************
+        /// Mask bits of a vector used as a value mask: stored and true.
+        template <typename VectorT>
+        PackedBitmap get_mask_bitmap(VectorT const &vec)
+        {
+            PackedBitmap bits(vec.get_bitmap());
+
+            if constexpr (std::is_same_v<typename VectorT::ScalarType, bool>)
             {
-                if ((it == row_tuples.end()) || (ix < std::get<0>(*it)))
+                auto       &bit_words(bits.words());
+                auto const &val_words(vec.get_vals().words());
+                for (IndexType wd = 0; wd < bit_words.size(); ++wd)
                 {
-                    mask_tuples.emplace_back(ix, true);
+                    bit_words[wd] &= val_words[wd];
                 }
-                else
-                {
-                    if (static_cast<bool>(std::get<1>(*it)) == false)
+            }
+            else
+            {
+                vec.get_bitmap().for_each_set(
+                    [&](IndexType idx)
                     {
-                        mask_tuples.emplace_back(ix, true);
-                    }
-                    ++it;
-                }
+                        if (!static_cast<bool>(vec.get_vals()[idx]))
+                        {
+                            bits.reset(idx);
+                        }
+                    });
             }
 
-            return mask_tuples;
+            return bits;
+        }
+
+        //**********************************************************************
+        template <typename VectorT>
+        PackedBitmap get_mask_bitmap(
+            grb::VectorComplementView<VectorT> const &mask)
+        {
+            PackedBitmap bits(get_mask_bitmap(mask.m_vec));
+            bits.flip();
+            return bits;
+        }
+
+        //**********************************************************************
+        template <typename VectorT>
+        PackedBitmap get_mask_bitmap(
+            grb::VectorStructureView<VectorT> const &mask)
+        {
+            return mask.m_vec.get_bitmap();
         }
 
         //**********************************************************************
-        // WARNING: costly
         template <typename VectorT>
-        decltype(auto)
-        get_structural_complement_contents(VectorT const &vec)
+        PackedBitmap get_mask_bitmap(
+            grb::VectorStructuralComplementView<VectorT> const &mask)
         {
-            std::vector<std::tuple<IndexType, bool> > mask_tuples;
-            auto row_tuples(vec.getContents());
-            auto it = row_tuples.begin();
+            PackedBitmap bits(mask.m_vec.get_bitmap());
+            bits.flip();
+            return bits;
+        }
 
-            for (IndexType ix = 0; ix < vec.size(); ++ix)
+        //**********************************************************************
+        /// t := w accum t, for boolean w and an accumulator with a word
+        /// equivalent (see is_word_accum_v).
+        template <typename WVectorT, typename AccumT>
+        void ewise_or_opt_accum_bitmap(PackedBitmap       &t_bitmap,
+                                       PackedBitmap       &t_vals,
+                                       WVectorT     const &w,
+                                       AccumT       const &accum)
+        {
+            if constexpr (!std::is_same_v<AccumT, NoAccumulate>)
             {
-                if ((it == row_tuples.end()) || (ix < std::get<0>(*it)))
+                auto       &tb(t_bitmap.words());
+                auto       &tv(t_vals.words());
+                auto const &wb(w.get_bitmap().words());
+                auto const &wv(w.get_vals().words());
+
+                for (IndexType wd = 0; wd < tb.size(); ++wd)
                 {
-                    mask_tuples.emplace_back(ix, true);
+                    auto both(wb[wd] & tb[wd]);
+                    tv[wd] = (both & word_op_traits<AccumT>::apply(wv[wd], tv[wd])) |
+                        (wb[wd] & ~tb[wd] & wv[wd]) |
+                        (~wb[wd] & tv[wd]);
+                    tb[wd] |= wb[wd];
                 }
-                else
+            }
+        }
+
+        //**********************************************************************
+        /// w<mask> := z for boolean w, where z is a bitmap and packed values.
+        /// z's storage is consumed.
+        template <typename WVectorT, typename MaskT>
+        void write_bitmap_with_opt_mask_1D(WVectorT                 &w,
+                                           PackedBitmap             &z_bitmap,
+                                           PackedBitmap             &z_vals,
+                                           MaskT              const &mask,
+                                           OutputControlEnum         outp)
+        {
+            if constexpr (!std::is_same_v<MaskT, grb::NoMask>)
+            {
+                PackedBitmap mask_bits(get_mask_bitmap(mask));
+                auto const &mb(mask_bits.words());
+                auto       &zb(z_bitmap.words());
+                auto       &zv(z_vals.words());
+                auto const &wb(w.get_bitmap().words());
+                auto const &wv(w.get_vals().words());
+
+                for (IndexType wd = 0; wd < zb.size(); ++wd)
                 {
-                    ++it;
+                    zb[wd] = (mb[wd] & zb[wd]) |
+                        ((outp == MERGE) ? (~mb[wd] & wb[wd]) : 0UL);
+                    zv[wd] = (mb[wd] & zv[wd]) | (~mb[wd] & wv[wd]);
                 }
             }
 
-            return mask_tuples;
+            w.swapBitmapContents(z_bitmap, z_vals);
         }
 
         //**********************************************************************
-        // Vector version
-        template <typename WVectorT,
-                  typename ZScalarT,
-                  typename MaskT>
-        void write_with_opt_mask_1D(
-            WVectorT                                           &w,
-            std::vector<std::tuple<IndexType, ZScalarT>> const &z,
-            MaskT const                                        &mask,
-            OutputControlEnum                                   outp)
+        /// t := u' lor.land A  for boolean u; scatters each row of A selected
+        /// by u into the result bitmap rather than merging sorted lists.
+        template <typename UVectorT, typename AMatrixT>
+        void logical_axpy_bitmap(PackedBitmap       &t_bitmap,
+                                 PackedBitmap       &t_vals,
+                                 UVectorT     const &u,
+                                 AMatrixT     const &A)
         {
-            using WScalarType = typename WVectorT::ScalarType;
-            std::vector<std::tuple<IndexType, WScalarType> > tmp_row;
-
-            apply_with_mask(tmp_row, w.getContents(), z,
-                            mask.getContents(),
-                            outp);
-
-            // Now, set the new one.  Yes, we can optimize this later
-            w.setContents(tmp_row);
+            auto const &u_vals(u.get_vals());
+            u.get_bitmap().for_each_set(
+                [&](IndexType row_idx)
+                {
+                    bool u_val(u_vals[row_idx]);
+                    for (auto&& [col_idx, a_val] : A[row_idx])
+                    {
+                        t_bitmap.set(col_idx);
+                        if (u_val && static_cast<bool>(a_val))
+                        {
+                            t_vals.set(col_idx);
+                        }
+                    }
+                });
         }
 
         //**********************************************************************
-        // Vector version specialized for complement mask
-        template <typename WVectorT,
-                  typename ZScalarT,
-                  typename MaskT>
-        void write_with_opt_mask_1D(
-            WVectorT                                           &w,
-            std::vector<std::tuple<IndexType, ZScalarT>> const &z,
-            grb::VectorComplementView<MaskT>             const &mask,
-            OutputControlEnum                                   outp)
+        /// t := A lor.land u  for boolean u; each row stops at the first true
+        /// product once it is known to be stored.
+        template <typename AMatrixT, typename UVectorT>
+        void logical_dot_bitmap(PackedBitmap       &t_bitmap,
+                                PackedBitmap       &t_vals,
+                                AMatrixT     const &A,
+                                UVectorT     const &u)
         {
-            using WScalarType = typename WVectorT::ScalarType;
-            std::vector<std::tuple<IndexType, WScalarType> > tmp_row;
-
-            apply_with_mask(tmp_row, w.getContents(), z,
-                            get_complement_contents(mask.m_vec),
-                            outp);
-
-            // Now, set the new one.  Yes, we can optimize this later
-            w.setContents(tmp_row);
+            auto const &u_bitmap(u.get_bitmap());
+            auto const &u_vals(u.get_vals());
+            for (IndexType row_idx = 0; row_idx < t_bitmap.size(); ++row_idx)
+            {
+                for (auto&& [col_idx, a_val] : A[row_idx])
+                {
+                    if (u_bitmap[col_idx])
+                    {
+                        t_bitmap.set(row_idx);
+                        if (static_cast<bool>(a_val) && u_vals[col_idx])
+                        {
+                            t_vals.set(row_idx);
+                            break;
+                        }
+                    }
+                }
+            }
         }
 
         //**********************************************************************
-        // Vector version specialized for structure mask
+        // Vector version: a single merge of w's stored elements and z, with
+        // each candidate index tested against the mask in place.
         template <typename WVectorT,
                   typename ZScalarT,
                   typename MaskT>
         void write_with_opt_mask_1D(
             WVectorT                                           &w,
             std::vector<std::tuple<IndexType, ZScalarT>> const &z,
-            grb::VectorStructureView<MaskT>              const &mask,
+            MaskT                                        const &mask,
             OutputControlEnum                                   outp)
         {
             using WScalarType = typename WVectorT::ScalarType;
             std::vector<std::tuple<IndexType, WScalarType> > tmp_row;
 
-            apply_with_mask(tmp_row, w.getContents(), z,
-                            get_structure_contents(mask.m_vec),
-                            outp);
-
-            // Now, set the new one.  Yes, we can optimize this later
-            w.setContents(tmp_row);
-        }
-
+            auto w_nz(w.nonzeros());
+            auto w_it = w_nz.begin();
+            auto z_it = z.begin();
+            while ((w_it != w_nz.end()) || (z_it != z.end()))
+            {
+                if ((z_it != z.end()) &&
+                    ((w_it == w_nz.end()) ||
+                     (std::get<0>(*z_it) <= std::get<0>(*w_it))))
+                {
+                    auto&& [z_idx, z_val] = *z_it;
+                    bool w_here((w_it != w_nz.end()) &&
+                                (std::get<0>(*w_it) == z_idx));
 
-        //**********************************************************************
-        // Vector version specialized for structural complement mask
-        template <typename WVectorT,
-                  typename ZScalarT,
-                  typename MaskT>
-        void write_with_opt_mask_1D(
-            WVectorT                                               &w,
-            std::vector<std::tuple<IndexType, ZScalarT>>     const &z,
-            grb::VectorStructuralComplementView<MaskT>       const &mask,
-            OutputControlEnum                                       outp)
-        {
-            using WScalarType = typename WVectorT::ScalarType;
-            std::vector<std::tuple<IndexType, WScalarType> > tmp_row;
+                    if (check_mask_1D(mask, z_idx))
+                    {
+                        tmp_row.emplace_back(z_idx,
+                                             static_cast<WScalarType>(z_val));
+                    }
+                    else if (w_here && (outp == MERGE))
+                    {
+                        tmp_row.emplace_back(*w_it);
+                    }
 
-            apply_with_mask(tmp_row, w.getContents(), z,
-                            get_structural_complement_contents(mask.m_vec),
-                            outp);
+                    if (w_here) ++w_it;
+                    ++z_it;
+                }
+                else
+                {
+                    // w only: kept outside the mask when merging
+                    IndexType w_idx(std::get<0>(*w_it));
+                    if ((outp == MERGE) && !check_mask_1D(mask, w_idx))
+                    {
+                        tmp_row.emplace_back(*w_it);
+                    }
+                    ++w_it;
+                }
+            }
 
-            // Now, set the new one.  Yes, we can optimize this later
             w.setContents(tmp_row);
         }
 
@@ -1266,6 +1457,17 @@ namespace grb
             }
         }
 
+        // Only the last index of a Range needs checking
+        inline void check_index_array_content(Range       const &array,
+                                              IndexType          dim,
+                                              std::string const &msg)
+        {
+            if (!array.empty() && (array[array.size() - 1] >= dim))
+            {
+                throw IndexOutOfBoundsException(msg);
+            }
+        }
+
         //********************************************************************
         // ALL SUPPORT
         // This is where we turns alls into the correct range
@@ -1276,9 +1478,11 @@ namespace grb
             return seq;
         }
 
-        IndexSequenceRange setupIndices(AllIndices seq, IndexType n)
+        // AllIndices becomes a unit-stride Range so that it takes the same
+        // slicing fast paths as a user supplied Range.
+        Range setupIndices(AllIndices seq, IndexType n)
         {
-            return IndexSequenceRange(0, n);
+            return Range(0, n);
         }
 
 
@@ -1408,6 +1612,145 @@ namespace grb
             GRB_LOG_FN_END("axpy");
         }
 
+        // *******************************************************************
+        /// Sparse accumulator (SPA) for one row of a matrix product: a dense
+        /// value array indexed by column, occupancy flags, and the list of
+        /// occupied columns.  Scattering a product costs O(1) instead of an
+        /// insertion into a sorted row, and the finished row is accumulated
+        /// into the destination row in place (see accumulate_into).
+        template <typename ScalarT>
+        class SparseAccumulator
+        {
+        public:
+            SparseAccumulator(IndexType num_cols)
+                : m_vals(num_cols),
+                  m_occupied(num_cols, false)
+            {
+                m_indices.reserve(num_cols);
+            }
+
+            bool empty() const { return m_indices.empty(); }
+
+            /// t[j] = add(t[j], val), or t[j] = val if t[j] is empty
+            template <typename SemiringT, typename ValueT>
+            void scatter(SemiringT const &semiring, IndexType j, ValueT val)
+            {
+                if (m_occupied[j])
+                {
+                    m_vals[j] = semiring.add(m_vals[j], val);
+                }
+                else
+                {
+                    m_occupied[j] = true;
+                    m_vals[j] = static_cast<ScalarT>(val);
+                    m_indices.push_back(j);
+                }
+            }
+
+            /// t += a*b[:]
+            template <typename SemiringT, typename AScalarT, typename BScalarT>
+            void axpy(SemiringT                                   const &semiring,
+                      AScalarT                                           a,
+                      std::vector<std::tuple<IndexType, BScalarT>> const &b)
+            {
+                for (auto&& [j, b_j] : b)
+                {
+                    scatter(semiring, j, semiring.mult(a, b_j));
+                }
+            }
+
+            /// c = t for an empty row c, in column order.  Leaves the
+            /// accumulator empty.
+            template <typename CScalarT>
+            void write_into(std::vector<std::tuple<IndexType, CScalarT>> &c)
+            {
+                std::sort(m_indices.begin(), m_indices.end());
+                c.reserve(m_indices.size());
+                for (auto j : m_indices)
+                {
+                    c.emplace_back(j, static_cast<CScalarT>(m_vals[j]));
+                    m_occupied[j] = false;
+                }
+                m_indices.clear();
+            }
+
+            /// c = c (accum) t, updating the elements of c in place and
+            /// merging in the new ones.  Leaves the accumulator empty.
+            template <typename CScalarT, typename AccumT>
+            void accumulate_into(std::vector<std::tuple<IndexType, CScalarT>> &c,
+                                 AccumT const &accum)
+            {
+                if (m_indices.empty()) return;
+
+                for (auto &c_elt : c)
+                {
+                    IndexType j(std::get<0>(c_elt));
+                    if (m_occupied[j])
+                    {
+                        std::get<1>(c_elt) = static_cast<CScalarT>(
+                            accum(std::get<1>(c_elt), m_vals[j]));
+                        m_occupied[j] = false;
+                    }
+                }
+
+                IndexType num_old(c.size());
+                for (auto j : m_indices)
+                {
+                    if (m_occupied[j])
+                    {
+                        c.emplace_back(j, static_cast<CScalarT>(m_vals[j]));
+                        m_occupied[j] = false;
+                    }
+                }
+                m_indices.clear();
+
+                if (c.size() > num_old)
+                {
+                    auto col_compare =
+                        [](std::tuple<IndexType, CScalarT> const &lhs,
+                           std::tuple<IndexType, CScalarT> const &rhs)
+                        { return std::get<0>(lhs) < std::get<0>(rhs); };
+                    std::sort(c.begin() + num_old, c.end(), col_compare);
+                    std::inplace_merge(c.begin(), c.begin() + num_old, c.end(),
+                                       col_compare);
+                }
+            }
+
+        private:
+            std::vector<ScalarT> m_vals;
+            std::vector<bool>    m_occupied;
+            IndexArrayType       m_indices;
+        };
+
+        // *******************************************************************
+        /// AT = A' for list-of-lists matrices; AT must be empty with the
+        /// transposed dimensions.  Rows of AT come out sorted.
+        ///
+        /// A counting sort: the column histogram of A (kept with its cached
+        /// degree statistics, so an unchanged A is only counted once) sizes
+        /// every row of AT exactly, then one scatter pass in row order fills
+        /// them without any reallocation.
+        template <typename ATMatrixT, typename AMatrixT>
+        void transpose_rows(ATMatrixT &AT, AMatrixT const &A)
+        {
+            if (A.nvals() == 0) return;
+
+            auto const &col_degrees(A.degreeStats().col_degrees);
+            for (IndexType col_idx = 0; col_idx < A.ncols(); ++col_idx)
+            {
+                AT[col_idx].reserve(col_degrees[col_idx]);
+            }
+
+            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            {
+                for (auto&& [col_idx, val] : A[row_idx])
+                {
+                    AT[col_idx].emplace_back(row_idx, val);
+                }
+            }
+            AT.recomputeNvals();
+        }
+
         // *******************************************************************
         /// perform the following operation on sparse vectors implemented as
         /// vector<tuple<Index, value>>
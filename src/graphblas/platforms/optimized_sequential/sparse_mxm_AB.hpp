@@ -87,7 +87,9 @@ namespace grb
         }
 
         //**********************************************************************
-        // Perform C = C + AB, where C, A, and B must all be unique
+        // Perform C = C + AB, where C and B must be unique (C may be A).
+        // Products are scattered into a sparse accumulator and accumulated
+        // into C's row in place, so no temporary row is merged and copied.
         template<typename CScalarT,
                  typename AccumT,
                  typename SemiringT,
@@ -101,11 +103,10 @@ namespace grb
             LilSparseMatrix<BScalarT> const &B)
         {
             using TScalarType = typename SemiringT::result_type;
-            typename LilSparseMatrix<TScalarType>::RowType T_row;
+            SparseAccumulator<TScalarType> T_row(B.ncols());
 
             for (IndexType i = 0; i < A.nrows(); ++i)
             {
-                T_row.clear();
                 for (auto const &Ai_elt : A[i])
                 {
                     IndexType    k(std::get<0>(Ai_elt));
@@ -114,15 +115,16 @@ namespace grb
                     if (B[k].empty()) continue;
 
                     // T[i] += (a_ik*B[k])  // must reduce in D3
-                    axpy(T_row, semiring, a_ik, B[k]);
+                    T_row.axpy(semiring, a_ik, B[k]);
                 }
 
                 if (!T_row.empty())
                 {
                     // C[i] = C[i] + T[i]
-                    C.mergeRow(i, T_row, accum);
+                    T_row.accumulate_into(C[i], accum);
                 }
             }
+            C.recomputeNvals();
         }
 
         //**********************************************************************
@@ -281,17 +283,21 @@ namespace grb
                 bool const complement_flag = true;
 
                 T_row.clear();
-                for (auto const &Ai_elt : A[i])
+                // rows the complemented mask excludes entirely are never written
+                if (!complement_row_is_full(M[i], M.ncols(), structure_flag))
                 {
-                    IndexType    k(std::get<0>(Ai_elt));
-                    AScalarT  a_ik(std::get<1>(Ai_elt));
+                    for (auto const &Ai_elt : A[i])
+                    {
+                        IndexType    k(std::get<0>(Ai_elt));
+                        AScalarT  a_ik(std::get<1>(Ai_elt));
 
-                    if (B[k].empty()) continue;
+                        if (B[k].empty()) continue;
 
-                    // T[i] += !M[i] .* (a_ik*B[k])  // must reduce in D3
-                    masked_axpy(T_row,
-                                M[i], structure_flag, complement_flag,
-                                semiring, a_ik, B[k]);
+                        // T[i] += !M[i] .* (a_ik*B[k])  // must reduce in D3
+                        masked_axpy(T_row,
+                                    M[i], structure_flag, complement_flag,
+                                    semiring, a_ik, B[k]);
+                    }
                 }
 
                 if ((outp == REPLACE) || M[i].empty())
@@ -343,17 +349,21 @@ namespace grb
                 bool const complement_flag = true;
 
                 T_row.clear();
-                for (auto const &Ai_elt : A[i])
+                // rows the complemented mask excludes entirely are never written
+                if (!complement_row_is_full(M[i], M.ncols(), structure_flag))
                 {
-                    IndexType    k(std::get<0>(Ai_elt));
-                    AScalarT  a_ik(std::get<1>(Ai_elt));
+                    for (auto const &Ai_elt : A[i])
+                    {
+                        IndexType    k(std::get<0>(Ai_elt));
+                        AScalarT  a_ik(std::get<1>(Ai_elt));
 
-                    if (B[k].empty()) continue;
+                        if (B[k].empty()) continue;
 
-                    // T[i] += !M[i] .* (a_ik*B[k])  // must reduce in D3
-                    masked_axpy(T_row,
-                                M[i], structure_flag, complement_flag,
-                                semiring, a_ik, B[k]);
+                        // T[i] += !M[i] .* (a_ik*B[k])  // must reduce in D3
+                        masked_axpy(T_row,
+                                    M[i], structure_flag, complement_flag,
+                                    semiring, a_ik, B[k]);
+                    }
                 }
 
                 // Z[i] = (!M[i] .* C[i]) + T[i], where T[i] is masked by !M[i]
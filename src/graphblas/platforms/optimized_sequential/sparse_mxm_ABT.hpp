@@ -106,14 +106,12 @@ namespace grb
             LilSparseMatrix<BScalarT> const &B)
         {
             using TScalarType = typename SemiringT::result_type;
-            std::vector<std::tuple<IndexType,TScalarType> > T_row;
+            SparseAccumulator<TScalarType> T_row(B.nrows());
 
             for (IndexType i = 0; i < A.nrows(); ++i)
             {
                 if (A[i].empty()) continue;
 
-                T_row.clear();
-
                 // Compute row i of T
                 // T[i] = (CScalarT) (A[i] *.+ B')
                 for (IndexType j = 0; j < B.nrows(); ++j)
@@ -126,16 +124,17 @@ namespace grb
                     // T[i][j] = (CScalarT) (A[i] . B[j])
                     if (dot(t_ij, A[i], B[j], semiring))
                     {
-                        T_row.emplace_back(j, t_ij);
+                        T_row.scatter(semiring, j, t_ij);
                     }
                 }
 
                 if (!T_row.empty())
                 {
-                    // C[i] = C[i] + T[i]
-                    C.mergeRow(i, T_row, accum);
+                    // C[i] = C[i] + T[i], in place
+                    T_row.accumulate_into(C[i], accum);
                 }
             }
+            C.recomputeNvals();
         }
 
         //**********************************************************************
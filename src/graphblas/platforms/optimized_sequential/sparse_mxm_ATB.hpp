@@ -40,6 +40,7 @@
 
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
+#include "sparse_mxm_AB.hpp"
 
 
 //****************************************************************************
@@ -128,6 +129,14 @@ namespace grb
             LilSparseMatrix<AScalarT> const &A,
             LilSparseMatrix<BScalarT> const &B)
         {
+            // rows the complemented mask excludes entirely are never written
+            std::vector<bool> skip_row(T.nrows());
+            for (IndexType i = 0; i < T.nrows(); ++i)
+            {
+                skip_row[i] =
+                    complement_row_is_full(M[i], M.ncols(), structure_flag);
+            }
+
             for (IndexType k = 0; k < A.nrows(); ++k)
             {
                 if (A[k].empty() || B[k].empty()) continue;
@@ -137,6 +146,8 @@ namespace grb
                     IndexType    i(std::get<0>(Ak_elt));
                     AScalarT  a_ki(std::get<1>(Ak_elt));
 
+                    if (skip_row[i]) continue;
+
                     // T[i] += !M[i] .* (a_ki*B[k])  // must reduce in D3, hence T.
                     masked_axpy(T[i],
                                 M[i], structure_flag, true,
@@ -205,16 +216,27 @@ namespace grb
 
             // =================================================================
 
-            using TScalarType = typename SemiringT::result_type;
-            LilSparseMatrix<TScalarType> T(C.nrows(), C.ncols());
+            if ((void*)&C == (void*)&B)
+            {
+                using TScalarType = typename SemiringT::result_type;
+                LilSparseMatrix<TScalarType> T(C.nrows(), C.ncols());
 
-            ATB_NoMask_kernel(T, semiring, A, B);
+                ATB_NoMask_kernel(T, semiring, A, B);
 
-            for (IndexType i = 0; i < C.nrows(); ++i)
+                for (IndexType i = 0; i < C.nrows(); ++i)
+                {
+                    if (!T[i].empty())
+                        // C[i] = C[i] + T[i]
+                        C.mergeRow(i, T[i], accum);
+                }
+            }
+            else
             {
-                if (!T[i].empty())
-                    // C[i] = C[i] + T[i]
-                    C.mergeRow(i, T[i], accum);
+                // Transposing A (O(nvals(A))) lets the rows of A'*B be
+                // accumulated into C in place instead of materializing T.
+                LilSparseMatrix<AScalarT> AT(A.ncols(), A.nrows());
+                transpose_rows(AT, A);
+                AB_NoMask_Accum_kernel(C, accum, semiring, AT, B);
             }
 
             GRB_LOG_VERBOSE("C: " << C);
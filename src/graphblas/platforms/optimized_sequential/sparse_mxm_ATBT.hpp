@@ -158,33 +158,33 @@ namespace grb
             }
 
             // =================================================================
+            // Transposing both inputs (O(nvals(A) + nvals(B))) gives the rows
+            // of A'*B' directly, so they are accumulated into C in place
+            // instead of materializing T = (B*A)'.  The copies also make the
+            // update safe when C is A or B.
             using TScalarType = typename SemiringT::result_type;
+            LilSparseMatrix<AScalarT> AT(A.ncols(), A.nrows());
+            LilSparseMatrix<BScalarT> BT(B.ncols(), B.nrows());
+            transpose_rows(AT, A);
+            transpose_rows(BT, B);
 
-            if (((void*)&C == (void*)&B) || ((void*)&C == (void*)&A))
+            SparseAccumulator<TScalarType> T_row(C.ncols());
+            for (IndexType i = 0; i < AT.nrows(); ++i)
             {
-                // create temporary to prevent overwrite of inputs
-                // T = A' +.* B'
-                LilSparseMatrix<TScalarType> T(C.nrows(), C.ncols());
-                ATBT_NoMask_NoAccum_kernel(T, semiring, A, B);
-                for (IndexType i = 0; i < C.nrows(); ++i)
+                for (auto&& [k, a_ki] : AT[i])
                 {
-                    // C[i] = C[i] + T[i]
-                    C.mergeRow(i, T[i], accum);
+                    // T[i] += B[:,k]*a_ki (operands in the same order as
+                    // the B*A form used by the other A'*B' kernels)
+                    for (auto&& [j, b_jk] : BT[k])
+                    {
+                        T_row.scatter(semiring, j, semiring.mult(b_jk, a_ki));
+                    }
                 }
-            }
-            else
-            {
-                typename LilSparseMatrix<TScalarType>::RowType T_row;
-                LilSparseMatrix<TScalarType> T(C.nrows(), C.ncols());
-                ATBT_NoMask_NoAccum_kernel(T, semiring, A, B);
 
-                // accumulate
-                for (IndexType i = 0; i < C.nrows(); ++i)
-                {
-                    // C[i] = C[i] + T[i]
-                    C.mergeRow(i, T[i], accum);
-                }
+                // C[i] = C[i] + T[i]
+                T_row.accumulate_into(C[i], accum);
             }
+            C.recomputeNvals();
         }
 
         //**********************************************************************
@@ -171,7 +171,7 @@ namespace grb
 
             if (u.nvals() > 0)
             {
-                reduction(t, u.getContents(), op);
+                reduction(t, u.nonzeros(), op);
             }
 
             // =================================================================
@@ -61,6 +61,23 @@ namespace grb
         {
             GRB_LOG_VERBOSE("w<M,z> := u +.* A");
 
+            // Boolean vectors with the logical semiring use a bitmap scatter
+            if constexpr (std::is_same_v<typename WVectorT::ScalarType, bool> &&
+                          std::is_same_v<typename UVectorT::ScalarType, bool> &&
+                          is_logical_semiring_v<SemiringT> &&
+                          is_word_accum_v<AccumT>)
+            {
+                PackedBitmap t_bitmap(w.size()), t_vals(w.size());
+                if ((A.nvals() > 0) && (u.nvals() > 0))
+                {
+                    logical_axpy_bitmap(t_bitmap, t_vals, u, A);
+                }
+
+                ewise_or_opt_accum_bitmap(t_bitmap, t_vals, w, accum);
+                write_bitmap_with_opt_mask_1D(w, t_bitmap, t_vals, mask, outp);
+                return;
+            }
+
             // =================================================================
             // Use axpy approach with the semi-ring.
             using TScalarType = typename SemiringT::result_type;
@@ -68,11 +85,26 @@ namespace grb
 
             if ((A.nvals() > 0) && (u.nvals() > 0))
             {
-                for (IndexType row_idx = 0; row_idx < u.size(); ++row_idx)
+                // Known arithmetic semirings fold into a dense accumulator
+                // when enough of the result is going to be touched
+                bool dense(false);
+                if constexpr (is_arithmetic_kernel_v<SemiringT>)
                 {
-                    if (u.hasElement(row_idx) && !A[row_idx].empty())
+                    if (dense_axpy_pays_off(u, A))
                     {
-                        axpy(t, op, u.extractElement(row_idx), A[row_idx]);
+                        dense_axpy(t, op, u, A);
+                        dense = true;
+                    }
+                }
+
+                if (!dense)
+                {
+                    for (auto&& [row_idx, u_val] : u.nonzeros())
+                    {
+                        if (!A[row_idx].empty())
+                        {
+                            axpy(t, op, u_val, A[row_idx]);
+                        }
                     }
                 }
             }
@@ -117,6 +149,23 @@ namespace grb
             GRB_LOG_VERBOSE("w<M,z> := u +.* A'");
             auto const &A(AT.m_mat);
 
+            // Boolean vectors with the logical semiring use short circuit dots
+            if constexpr (std::is_same_v<typename WVectorT::ScalarType, bool> &&
+                          std::is_same_v<typename UVectorT::ScalarType, bool> &&
+                          is_logical_semiring_v<SemiringT> &&
+                          is_word_accum_v<AccumT>)
+            {
+                PackedBitmap t_bitmap(w.size()), t_vals(w.size());
+                if ((A.nvals() > 0) && (u.nvals() > 0))
+                {
+                    logical_dot_bitmap(t_bitmap, t_vals, A, u);
+                }
+
+                ewise_or_opt_accum_bitmap(t_bitmap, t_vals, w, accum);
+                write_bitmap_with_opt_mask_1D(w, t_bitmap, t_vals, mask, outp);
+                return;
+            }
+
             // =================================================================
             // Do the basic dot-product work with the semi-ring.
             using TScalarType = typename SemiringT::result_type;
@@ -124,13 +173,13 @@ namespace grb
 
             if ((A.nvals() > 0) && (u.nvals() > 0))
             {
-                auto u_contents(u.getContents());
                 for (IndexType row_idx = 0; row_idx < w.size(); ++row_idx)
                 {
-                    if (!A[row_idx].empty())
+                    // Rows outside the mask never reach w, skip their dots
+                    if (!A[row_idx].empty() && check_mask_1D(mask, row_idx))
                     {
                         TScalarType t_val;
-                        if (dot(t_val, u_contents, A[row_idx], op))
+                        if (dot2(t_val, u, A[row_idx], op))
                         {
                             t.emplace_back(row_idx, t_val);
                         }
@@ -27,10 +27,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <typeinfo>
 #include <numeric>
+#include <iterator>
+#include <tuple>
+
+#include "PackedBitmap.hpp"
 
 namespace grb
 {
@@ -38,12 +43,86 @@ namespace grb
     {
         /**
          * @brief Class representing a sparse vector by using a bitmap + dense vector
+         *
+         * The bitmap is packed 64 elements to a word.  Boolean vectors also
+         * pack their values so that logical kernels can work on whole words.
+         *
+         * A sorted list of the stored indices is kept alongside the bitmap so
+         * that kernels can visit the stored elements in O(nvals) time without
+         * copying them (see getIndices() and nonzeros()).
          */
         template<typename ScalarT>
         class BitmapSparseVector
         {
         public:
             using ScalarType = ScalarT;
+            using ValueStorageType = BitmapValueStorage<ScalarT>;
+
+            /// Iterator over the stored (index, value) pairs, in index order
+            class const_nonzero_iterator
+            {
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type        = std::tuple<IndexType, ScalarT>;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = void;
+                using reference         = value_type;
+
+                const_nonzero_iterator(
+                    IndexArrayType::const_iterator  it,
+                    ValueStorageType        const  *vals)
+                    : m_it(it), m_vals(vals) {}
+
+                value_type operator*() const
+                {
+                    return value_type(*m_it, (*m_vals)[*m_it]);
+                }
+
+                const_nonzero_iterator &operator++() { ++m_it; return *this; }
+
+                bool operator==(const_nonzero_iterator const &rhs) const
+                {
+                    return m_it == rhs.m_it;
+                }
+
+                bool operator!=(const_nonzero_iterator const &rhs) const
+                {
+                    return m_it != rhs.m_it;
+                }
+
+            private:
+                IndexArrayType::const_iterator  m_it;
+                ValueStorageType        const  *m_vals;
+            };
+
+            /// Lightweight view of the stored elements, valid until the
+            /// vector is next modified.
+            class NonzeroRange
+            {
+            public:
+                using value_type = typename const_nonzero_iterator::value_type;
+
+                NonzeroRange(IndexArrayType   const &indices,
+                             ValueStorageType const &vals)
+                    : m_indices(indices), m_vals(vals) {}
+
+                const_nonzero_iterator begin() const
+                {
+                    return const_nonzero_iterator(m_indices.begin(), &m_vals);
+                }
+
+                const_nonzero_iterator end() const
+                {
+                    return const_nonzero_iterator(m_indices.end(), &m_vals);
+                }
+
+                IndexType size() const { return m_indices.size(); }
+                bool empty() const     { return m_indices.empty(); }
+
+            private:
+                IndexArrayType   const &m_indices;
+                ValueStorageType const &m_vals;
+            };
 
             // Ambiguous with size constructor
             // template <typename OtherVectorT>
@@ -174,7 +253,9 @@ namespace grb
                 : m_size(rhs.m_size),
                   m_nvals(rhs.m_nvals),
                   m_vals(rhs.m_vals),
-                  m_bitmap(rhs.m_bitmap)
+                  m_bitmap(rhs.m_bitmap),
+                  m_indices(rhs.m_indices),
+                  m_indices_valid(rhs.m_indices_valid)
             {
             }
 
@@ -200,6 +281,8 @@ namespace grb
                     m_nvals = rhs.m_nvals;
                     m_vals = rhs.m_vals;
                     m_bitmap = rhs.m_bitmap;
+                    m_indices = rhs.m_indices;
+                    m_indices_valid = rhs.m_indices_valid;
                 }
                 return *this;
             }
@@ -223,6 +306,7 @@ namespace grb
                     m_bitmap[idx] = true;
                 }
                 m_nvals = m_size;
+                m_indices_valid = false;
                 return *this;
             }
 
@@ -239,19 +323,17 @@ namespace grb
                     return false;
                 }
 
-                for (IndexType i = 0; i < m_size; ++i)
+                if (m_bitmap != rhs.m_bitmap)
+                {
+                    return false;
+                }
+
+                for (auto i : getIndices())
                 {
-                    if (m_bitmap[i] != rhs.m_bitmap[i])
+                    if (m_vals[i] != rhs.m_vals[i])
                     {
                         return false;
                     }
-                    if (m_bitmap[i])
-                    {
-                        if (m_vals[i] != rhs.m_vals[i])
-                        {
-                            return false;
-                        }
-                    }
                 }
 
                 return true;
@@ -271,9 +353,23 @@ namespace grb
 
             void clear()
             {
+                // Sparse vectors are cleared bit by bit to avoid O(n) work.
+                if (m_indices_valid &&
+                    (m_nvals < m_size/PackedBitmap::BITS_PER_WORD))
+                {
+                    for (auto idx : m_indices)
+                    {
+                        m_bitmap.reset(idx);
+                    }
+                }
+                else
+                {
+                    m_bitmap.assign(m_size, false);
+                }
                 m_nvals = 0;
                 //m_vals.clear();
-                m_bitmap.assign(m_size, false);
+                m_indices.clear();
+                m_indices_valid = true;
             }
 
             IndexType size() const { return m_size; }
@@ -298,26 +394,17 @@ namespace grb
                     if (new_size < m_size/2)
                     {
                         // count remaining elements
-                        IndexType new_nvals = 0UL;
-                        new_nvals = std::reduce(m_bitmap.begin(),
-                                                m_bitmap.begin() + new_size,
-                                                new_nvals,
-                                               std::plus<IndexType>());
-                        m_nvals = new_nvals;
+                        m_nvals = m_bitmap.count(0, new_size);
                     }
                     else
                     {
                         // count elements to be removed
-                        IndexType num_vals = 0UL;
-                        num_vals = std::reduce(m_bitmap.begin() + new_size,
-                                               m_bitmap.end(),
-                                               num_vals,
-                                               std::plus<IndexType>());
-                        m_nvals -= num_vals;
+                        m_nvals -= m_bitmap.count(new_size, m_bitmap.size());
                     }
 
                     m_bitmap.resize(new_size);
                     m_vals.resize(new_size);
+                    m_indices_valid = false;
                 }
                 else if (new_size > m_size)
                 {
@@ -338,8 +425,8 @@ namespace grb
                        IndexType     nvals,
                        BinaryOpT     dup = BinaryOpT())
             {
-                std::vector<ScalarType> vals(m_size);
-                std::vector<bool> bitmap(m_size);
+                ValueStorageType vals(m_size);
+                PackedBitmap     bitmap(m_size);
 
                 /// @todo check for same size indices and values
                 for (IndexType idx = 0; idx < nvals; ++idx)
@@ -363,7 +450,8 @@ namespace grb
 
                 m_vals.swap(vals);
                 m_bitmap.swap(bitmap);
-                m_nvals = nvals;
+                m_nvals = m_bitmap.count();
+                m_indices_valid = false;
             }
 
             bool hasElement(IndexType index) const
@@ -415,6 +503,17 @@ namespace grb
                 {
                     ++m_nvals;
                     m_bitmap[index] = true;
+
+                    // Appends keep the index list; anything else rebuilds it
+                    if (m_indices_valid &&
+                        (m_indices.empty() || (m_indices.back() < index)))
+                    {
+                        m_indices.push_back(index);
+                    }
+                    else
+                    {
+                        m_indices_valid = false;
+                    }
                 }
             }
 
@@ -429,6 +528,16 @@ namespace grb
                 {
                     --m_nvals;
                     m_bitmap[index] = false;
+
+                    if (m_indices_valid &&
+                        !m_indices.empty() && (m_indices.back() == index))
+                    {
+                        m_indices.pop_back();
+                    }
+                    else
+                    {
+                        m_indices_valid = false;
+                    }
                 }
             }
 
@@ -437,13 +546,10 @@ namespace grb
             void extractTuples(RAIteratorIT        i_it,
                                RAIteratorVT        v_it) const
             {
-                for (IndexType idx = 0; idx < m_size; ++idx)
+                for (auto idx : getIndices())
                 {
-                    if (m_bitmap[idx])
-                    {
-                        *i_it = idx;         ++i_it;
-                        *v_it = m_vals[idx]; ++v_it;
-                    }
+                    *i_it = idx;         ++i_it;
+                    *v_it = m_vals[idx]; ++v_it;
                 }
             }
 
@@ -476,19 +582,43 @@ namespace grb
                 return os;
             }
 
-            std::vector<bool>    const &get_bitmap() const { return m_bitmap; }
-            std::vector<ScalarT> const &get_vals() const   { return m_vals; }
+            PackedBitmap     const &get_bitmap() const { return m_bitmap; }
+            ValueStorageType const &get_vals() const   { return m_vals; }
+
+            /**
+             * @brief The indices of the stored elements in increasing order.
+             *
+             * setElement/removeElement keep the list up to date when they
+             * append to or remove from its end; other modifications cause it
+             * to be rebuilt from the bitmap on the next call.
+             */
+            IndexArrayType const &getIndices() const
+            {
+                if (!m_indices_valid)
+                {
+                    m_indices.clear();
+                    m_indices.reserve(m_nvals);
+                    m_bitmap.for_each_set(
+                        [&](IndexType idx) { m_indices.push_back(idx); });
+                    m_indices_valid = true;
+                }
+                return m_indices;
+            }
 
+            /// Zero-copy view of the stored (index, value) pairs.
+            NonzeroRange nonzeros() const
+            {
+                return NonzeroRange(getIndices(), m_vals);
+            }
+
+            /// @note This copies; kernels should prefer nonzeros().
             std::vector<std::tuple<IndexType,ScalarT> > getContents() const
             {
                 std::vector<std::tuple<IndexType,ScalarT> > contents;
                 contents.reserve(m_nvals);
-                for (IndexType idx = 0; idx < m_size; ++idx)
+                for (auto idx : getIndices())
                 {
-                    if (m_bitmap[idx])
-                    {
-                        contents.emplace_back(idx, m_vals[idx]);
-                    }
+                    contents.emplace_back(idx, m_vals[idx]);
                 }
                 return contents;
             }
@@ -498,19 +628,49 @@ namespace grb
                 std::vector<std::tuple<IndexType,OtherScalarT> > const &contents)
             {
                 clear();
+                m_indices.reserve(contents.size());
                 for (auto&& [idx, val] : contents)
                 {
                     m_bitmap[idx] = true;
                     m_vals[idx]   = static_cast<ScalarT>(val);
                     ++m_nvals;
+                    m_indices.push_back(idx);
+                }
+
+                if (!std::is_sorted(m_indices.begin(), m_indices.end()))
+                {
+                    m_indices_valid = false;
                 }
             }
 
+            /**
+             * @brief Replace the contents with a bitmap and value storage of
+             *        the same size (used by the word-parallel kernels).
+             *
+             * The arguments receive the previous contents.
+             */
+            void swapBitmapContents(PackedBitmap     &bitmap,
+                                    ValueStorageType &vals)
+            {
+                if ((bitmap.size() != m_size) || (vals.size() != m_size))
+                {
+                    throw DimensionException();
+                }
+                m_bitmap.swap(bitmap);
+                m_vals.swap(vals);
+                m_nvals = m_bitmap.count();
+                m_indices_valid = false;
+            }
+
         private:
             IndexType             m_size;
             IndexType             m_nvals;
-            std::vector<ScalarT>  m_vals;
-            std::vector<bool>     m_bitmap;
+            ValueStorageType      m_vals;
+            PackedBitmap          m_bitmap;
+
+            // Sorted indices of the stored elements (when m_indices_valid)
+            mutable IndexArrayType m_indices;
+            mutable bool           m_indices_valid = false;
         };
     } // backend
 } // grb
@@ -32,9 +32,15 @@
 #include <typeinfo>
 #include <stdexcept>
 #include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <memory>
+#include <unordered_map>
 
 #include <graphblas/graphblas.hpp>
 
+#include "PackedBitmap.hpp"
+
 //****************************************************************************
 
 namespace grb
@@ -42,6 +48,26 @@ namespace grb
     namespace backend
     {
 
+        /**
+         * @brief List-of-lists sparse matrix: one sorted vector of
+         *        (column, value) tuples per row.
+         *
+         * Single element updates are buffered: setElement appends new
+         * elements to an unsorted tail of the row ("pending tuples") and
+         * removeElement marks elements as deleted in place by flipping the
+         * high bit of their column index ("zombies").  Lookups binary search
+         * the sorted part of the row and scan the (short) tail.  Rows are
+         * assembled back into plain sorted form on the next row access
+         * (operator[], the row/column methods, extractTuples, ...) or by
+         * calling wait(), so kernels never see pending tuples or zombies.
+         *
+         * Row/column degree statistics are computed on first request and
+         * cached until the next structural change (see degreeStats()).
+         *
+         * When the matrix is used as a mask, the columns each row admits
+         * are bit packed on first request (see packedMask()) and cached
+         * until the next change to its structure or values.
+         */
         template<typename ScalarT, typename... TagsT>
         class LilSparseMatrix
         {
@@ -65,7 +91,8 @@ namespace grb
                 : m_num_rows(rhs.m_num_rows),
                   m_num_cols(rhs.m_num_cols),
                   m_nvals(rhs.m_nvals),
-                  m_data(rhs.m_data)
+                  m_data(rhs.m_data),
+                  m_pending(rhs.m_pending)
             {
             }
 
@@ -135,6 +162,8 @@ namespace grb
 
                     m_nvals = rhs.m_nvals;
                     m_data = rhs.m_data;
+                    m_pending = rhs.m_pending;
+                    invalidateStats();
                 }
                 return *this;
             }
@@ -147,6 +176,8 @@ namespace grb
              */
             bool operator==(LilSparseMatrix<ScalarT> const &rhs) const
             {
+                wait();
+                rhs.wait();
                 return ((m_num_rows == rhs.m_num_rows) &&
                         (m_num_cols == rhs.m_num_cols) &&
                         (m_nvals == rhs.m_nvals) &&
@@ -178,18 +209,165 @@ namespace grb
                 /// @todo should this function call clear?
                 //clear();
 
-                /// @todo DOING SOMETHING REALLY STUPID RIGHT NOW
-                for (IndexType ix = 0; ix < n; ++ix)
+                applyUpdates(i_it, j_it, v_it, n, i_it, j_it, 0UL, dup);
+            }
+
+            /**
+             * @brief Apply a batch of deletions followed by a batch of
+             *        insertions.
+             *
+             * Both batches are sorted by (row, column) and each touched row
+             * is rewritten in a single merge pass.  An insertion landing on a
+             * stored value (or on an earlier insertion in the batch) is
+             * combined with stored_val = dup(stored_val, val).
+             *
+             * @return The sorted indices of the rows that changed.
+             */
+            template<typename RAIteratorI,
+                     typename RAIteratorJ,
+                     typename RAIteratorV,
+                     typename RAIteratorDI,
+                     typename RAIteratorDJ,
+                     typename DupT>
+            IndexArrayType applyUpdates(RAIteratorI   i_it,
+                                        RAIteratorJ   j_it,
+                                        RAIteratorV   v_it,
+                                        IndexType     num_inserts,
+                                        RAIteratorDI  di_it,
+                                        RAIteratorDJ  dj_it,
+                                        IndexType     num_deletes,
+                                        DupT          dup)
+            {
+                for (IndexType ix = 0; ix < num_inserts; ++ix)
                 {
-                    setElement(*i_it, *j_it, *v_it, dup);
-                    ++i_it; ++j_it; ++v_it;
+                    if ((i_it[ix] >= m_num_rows) || (j_it[ix] >= m_num_cols))
+                    {
+                        throw IndexOutOfBoundsException(
+                            "applyUpdates: insert index out of bounds");
+                    }
+                }
+                for (IndexType ix = 0; ix < num_deletes; ++ix)
+                {
+                    if ((di_it[ix] >= m_num_rows) || (dj_it[ix] >= m_num_cols))
+                    {
+                        throw IndexOutOfBoundsException(
+                            "applyUpdates: delete index out of bounds");
+                    }
+                }
+
+                wait();
+                invalidateStats();
+
+                // Sort the batches by (row, col); stable so that duplicate
+                // insertions are combined in the order given.
+                IndexArrayType ins(num_inserts), del(num_deletes);
+                std::iota(ins.begin(), ins.end(), 0UL);
+                std::iota(del.begin(), del.end(), 0UL);
+                std::stable_sort(ins.begin(), ins.end(),
+                                 [&](IndexType a, IndexType b)
+                                 {
+                                     return ((i_it[a] < i_it[b]) ||
+                                             ((i_it[a] == i_it[b]) &&
+                                              (j_it[a] < j_it[b])));
+                                 });
+                std::sort(del.begin(), del.end(),
+                          [&](IndexType a, IndexType b)
+                          {
+                              return ((di_it[a] < di_it[b]) ||
+                                      ((di_it[a] == di_it[b]) &&
+                                       (dj_it[a] < dj_it[b])));
+                          });
+
+                IndexArrayType changed_rows;
+                RowType        new_row;
+                auto ins_it(ins.begin());
+                auto del_it(del.begin());
+                while ((ins_it != ins.end()) || (del_it != del.end()))
+                {
+                    IndexType row_idx(
+                        std::min((ins_it != ins.end()) ? i_it[*ins_it] : m_num_rows,
+                                 (del_it != del.end()) ? di_it[*del_it] : m_num_rows));
+
+                    RowType &row(m_data[row_idx]);
+                    auto row_it(row.begin());
+                    bool row_changed(false);
+                    new_row.clear();
+                    new_row.reserve(row.size());
+
+                    // Merge the row with this row's deletions and insertions
+                    while (true)
+                    {
+                        bool ins_here((ins_it != ins.end()) &&
+                                      (i_it[*ins_it] == row_idx));
+                        bool del_here((del_it != del.end()) &&
+                                      (di_it[*del_it] == row_idx));
+                        if ((row_it == row.end()) && !ins_here && !del_here)
+                        {
+                            break;
+                        }
+
+                        IndexType col_idx(m_num_cols);
+                        if (row_it != row.end())
+                            col_idx = std::get<0>(*row_it);
+                        if (ins_here)
+                            col_idx = std::min<IndexType>(col_idx, j_it[*ins_it]);
+                        if (del_here)
+                            col_idx = std::min<IndexType>(col_idx, dj_it[*del_it]);
+
+                        bool    has_val(false);
+                        ScalarT val{};
+                        if ((row_it != row.end()) &&
+                            (std::get<0>(*row_it) == col_idx))
+                        {
+                            has_val = true;
+                            val = std::get<1>(*row_it);
+                            ++row_it;
+                        }
+
+                        while ((del_it != del.end()) &&
+                               (di_it[*del_it] == row_idx) &&
+                               (dj_it[*del_it] == col_idx))
+                        {
+                            row_changed = row_changed || has_val;
+                            has_val = false;
+                            ++del_it;
+                        }
+
+                        while ((ins_it != ins.end()) &&
+                               (i_it[*ins_it] == row_idx) &&
+                               (j_it[*ins_it] == col_idx))
+                        {
+                            val = (has_val ?
+                                   static_cast<ScalarT>(dup(val, v_it[*ins_it])) :
+                                   static_cast<ScalarT>(v_it[*ins_it]));
+                            has_val = true;
+                            row_changed = true;
+                            ++ins_it;
+                        }
+
+                        if (has_val)
+                        {
+                            new_row.emplace_back(col_idx, val);
+                        }
+                    }
+
+                    m_nvals = m_nvals + new_row.size() - row.size();
+                    row.swap(new_row);
+                    if (row_changed)
+                    {
+                        changed_rows.push_back(row_idx);
+                    }
                 }
+
+                return changed_rows;
             }
 
             void clear()
             {
                 /// @todo make atomic? transactional?
                 m_nvals = 0;
+                m_pending.clear();
+                invalidateStats();
                 for (IndexType row = 0; row < m_data.size(); ++row)
                 {
                     m_data[row].clear();
@@ -212,6 +390,8 @@ namespace grb
                 // Invalid values check by frontend
                 //if ((new_num_rows == 0) || (new_num_cols == 0))
                 //    throw InvalidValueException();
+                wait();
+                invalidateStats();
 
                 // *******************************************
                 // Step 1: Deal with number of rows
@@ -262,23 +442,10 @@ namespace grb
                     throw IndexOutOfBoundsException(
                         "get_value_at: index out of bounds");
                 }
-                if (m_data.empty())
-                {
-                    return false;
-                }
-                if (m_data[irow].empty())
-                {
-                    return false;
-                }
 
-                for (auto tupl : m_data[irow])// Range-based loop, access by value
-                {
-                    if (std::get<0>(tupl) == icol)
-                    {
-                        return true;
-                    }
-                }
-                return false;
+                auto it(findElement(irow, icol));
+                return ((it != m_data[irow].end()) &&
+                        !is_zombie(std::get<0>(*it)));
             }
 
             // Get value at index
@@ -289,61 +456,28 @@ namespace grb
                     throw IndexOutOfBoundsException(
                         "extractElement: index out of bounds");
                 }
-                if (m_data.empty())
-                {
-                    throw NoValueException("extractElement: no data");
-                }
                 if (m_data[irow].empty())
                 {
                     throw NoValueException("extractElement: no data in row");
                 }
 
-                for (auto&& [idx, val] : m_data[irow])
+                auto it(findElement(irow, icol));
+                if ((it == m_data[irow].end()) || is_zombie(std::get<0>(*it)))
                 {
-                    if (idx == icol)
-                    {
-                        return val;
-                    }
+                    throw NoValueException("extractElement: no entry at index");
                 }
-                throw NoValueException("extractElement: no entry at index");
+                return std::get<1>(*it);
             }
 
             // Set value at index
             void setElement(IndexType irow, IndexType icol, ScalarT const &val)
             {
-                //m_data[irow].reserve(m_data[irow].capacity() + 10);
                 if (irow >= m_num_rows || icol >= m_num_cols)
                 {
                     throw IndexOutOfBoundsException("setElement: index out of bounds");
                 }
 
-                if (m_data[irow].empty())
-                {
-                    m_data[irow].emplace_back(icol, val);
-                    ++m_nvals;
-                }
-                else
-                {
-                    for (auto it = m_data[irow].begin();
-                         it != m_data[irow].end();
-                         ++it)
-                    {
-                        if (std::get<0>(*it) == icol)
-                        {
-                            // overwrite existing stored value
-                            std::get<1>(*it) = val;
-                            return;
-                        }
-                        else if (std::get<0>(*it) > icol)
-                        {
-                            m_data[irow].emplace(it, icol, val);
-                            ++m_nvals;
-                            return;
-                        }
-                    }
-                    m_data[irow].emplace_back(icol, val);
-                    ++m_nvals;
-                }
+                setOrMergeElement(irow, icol, val, grb::Second<ScalarT>());
             }
 
             // Set value at index + 'merge' with any existing value
@@ -358,56 +492,84 @@ namespace grb
                         "setElement(merge): index out of bounds");
                 }
 
-                if (m_data[irow].empty())
+                setOrMergeElement(irow, icol, val, merge);
+            }
+
+            void removeElement(IndexType irow, IndexType icol)
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
                 {
-                    m_data[irow].emplace_back(icol, val);
-                    ++m_nvals;
+                    throw IndexOutOfBoundsException("removeElement: index out of bounds");
                 }
-                else
+
+                RowType &row(m_data[irow]);
+                auto it(findElement(irow, icol));
+                if ((it == row.end()) || is_zombie(std::get<0>(*it)))
                 {
-                    for (auto it = m_data[irow].begin();
-                         it != m_data[irow].end();
-                         ++it)
+                    return;
+                }
+
+                --m_nvals;
+                invalidateStats();
+                auto pend(m_pending.find(irow));
+                if (pend == m_pending.end())
+                {
+                    // Removing the last element keeps the row assembled
+                    if (it + 1 == row.end())
                     {
-                        if (std::get<0>(*it) == icol)
-                        {
-                            // merge with existing stored value
-                            std::get<1>(*it) = merge(std::get<1>(*it), val);
-                            return;
-                        }
-                        else if (std::get<0>(*it) > icol)
-                        {
-                            m_data[irow].emplace(it, icol, val);
-                            ++m_nvals;
-                            return;
-                        }
+                        row.pop_back();
+                        return;
                     }
-                    m_data[irow].emplace_back(icol, val);
-                    ++m_nvals;
+                    pend = m_pending.emplace(
+                        irow, PendingRowInfo{row.size(), 0}).first;
                 }
-            }
 
-            void removeElement(IndexType irow, IndexType icol)
-            {
-                if (irow >= m_num_rows || icol >= m_num_cols)
+                PendingRowInfo &info(pend->second);
+                if (static_cast<IndexType>(it - row.begin()) >= info.num_sorted)
                 {
-                    throw IndexOutOfBoundsException("removeElement: index out of bounds");
+                    // Pending tuples are unordered: swap with the last one
+                    if (it + 1 != row.end())
+                    {
+                        *it = row.back();
+                    }
+                    row.pop_back();
+                }
+                else
+                {
+                    std::get<0>(*it) |= ZOMBIE_BIT;
+                    ++info.num_zombies;
                 }
 
-                /// @todo Replace with binary_search
-                auto it = std::find_if(
-                    m_data[irow].begin(), m_data[irow].end(),
-                    [&icol](ElementType const &elt) { return icol == std::get<0>(elt); });
+                // Do not let zombies outnumber the live elements
+                if (2*info.num_zombies > info.num_sorted)
+                {
+                    assembleRow(irow, info);
+                    m_pending.erase(pend);
+                }
+            }
 
-                if (it != m_data[irow].end())
+            /**
+             * @brief Assemble all pending tuples and remove all zombies.
+             *
+             * Called automatically before any row access; exposed so that
+             * callers can choose when the cost is paid (see grb::wait()).
+             */
+            void wait() const
+            {
+                if (!m_pending.empty())
                 {
-                    --m_nvals;
-                    m_data[irow].erase(it);
+                    for (auto &[row_idx, info] : m_pending)
+                    {
+                        assembleRow(row_idx, info);
+                    }
+                    m_pending.clear();
                 }
             }
 
             void recomputeNvals()
             {
+                wait();
+                invalidateStats();
                 IndexType nvals(0);
 
                 for (auto const &elt : m_data)
@@ -420,20 +582,30 @@ namespace grb
             // TODO: add error checking on dimensions?
             void swap(LilSparseMatrix<ScalarT> &rhs)
             {
+                wait();
+                rhs.wait();
                 for (IndexType idx = 0; idx < m_data.size(); ++idx)
                 {
                     m_data[idx].swap(rhs.m_data[idx]);
                 }
                 m_nvals = rhs.m_nvals;
+                invalidateStats();
+                rhs.invalidateStats();
             }
 
             // Row access
             // Warning if you use this non-const row accessor then you should
             // call recomputeNvals() at some point to fix it
-            RowType &operator[](IndexType row_index) { return m_data[row_index]; }
+            RowType &operator[](IndexType row_index)
+            {
+                wait();
+                invalidateStats();
+                return m_data[row_index];
+            }
 
             RowType const &operator[](IndexType row_index) const
             {
+                wait();
                 return m_data[row_index];
             }
 
@@ -448,6 +620,8 @@ namespace grb
                 IndexType row_index,
                 std::vector<std::tuple<IndexType, OtherScalarT> > const &row_data)
             {
+                wait();
+                invalidateStats();
                 IndexType old_nvals = m_data[row_index].size();
                 IndexType new_nvals = row_data.size();
 
@@ -465,6 +639,8 @@ namespace grb
                 IndexType row_index,
                 std::vector<std::tuple<IndexType, ScalarT> > &&row_data)
             {
+                wait();
+                invalidateStats();
                 IndexType old_nvals = m_data[row_index].size();
                 IndexType new_nvals = row_data.size();
 
@@ -493,6 +669,7 @@ namespace grb
                 AccumT const &op)
             {
                 if (row_data.empty()) return;
+                wait();
                 if (m_data[row_index].empty())
                 {
                     setRow(row_index, row_data);
@@ -538,7 +715,7 @@ namespace grb
                     tmp.emplace_back(*r_it);  ++r_it;
                 }
 
-                setRow(row_index, tmp);
+                setRow(row_index, std::move(tmp));
             }
 
             /// @deprecated Only needed for 4.3.7.3 assign: column variant"
@@ -546,6 +723,7 @@ namespace grb
             using ColType = std::vector<std::tuple<IndexType, ScalarT> >;
             ColType getCol(IndexType col_index) const
             {
+                wait();
                 std::vector<std::tuple<IndexType, ScalarT> > data;
 
                 for (IndexType ii = 0; ii < m_num_rows; ii++)
@@ -574,6 +752,8 @@ namespace grb
                 IndexType col_index,
                 std::vector<std::tuple<IndexType, OtherScalarT> > const &col_data)
             {
+                wait();
+                invalidateStats();
                 auto it = col_data.begin();
                 for (IndexType row_index = 0; row_index < m_num_rows; row_index++)
                 {
@@ -701,6 +881,81 @@ namespace grb
             //     }
             // }
 
+            /**
+             * @brief Row and column degree statistics of the matrix.
+             *
+             * Computed in a single pass over the stored indices the first
+             * time they are requested, then cached until the structure of
+             * the matrix changes (value-only updates keep the cache).
+             */
+            DegreeStats const &degreeStats() const
+            {
+                if (!m_stats)
+                {
+                    wait();
+                    auto stats(std::make_unique<DegreeStats>());
+                    stats->row_degrees.resize(m_num_rows);
+                    stats->col_degrees.assign(m_num_cols, 0UL);
+                    for (IndexType row = 0; row < m_num_rows; ++row)
+                    {
+                        stats->row_degrees[row] = m_data[row].size();
+                        for (auto&& [col_idx, val] : m_data[row])
+                        {
+                            ++(stats->col_degrees[col_idx]);
+                        }
+                    }
+
+                    stats->max_row_degree = (m_num_rows == 0) ? 0UL :
+                        *std::max_element(stats->row_degrees.begin(),
+                                          stats->row_degrees.end());
+                    stats->max_col_degree = (m_num_cols == 0) ? 0UL :
+                        *std::max_element(stats->col_degrees.begin(),
+                                          stats->col_degrees.end());
+                    stats->mean_row_degree = (m_num_rows == 0) ? 0. :
+                        static_cast<double>(m_nvals)/m_num_rows;
+                    stats->mean_col_degree = (m_num_cols == 0) ? 0. :
+                        static_cast<double>(m_nvals)/m_num_cols;
+
+                    double sum_sq(0.);
+                    for (auto deg : stats->row_degrees)
+                    {
+                        double diff(static_cast<double>(deg) -
+                                    stats->mean_row_degree);
+                        sum_sq += diff*diff;
+                    }
+                    stats->row_degree_skew =
+                        ((m_num_rows == 0) || (m_nvals == 0)) ? 0. :
+                        std::sqrt(sum_sq/m_num_rows)/stats->mean_row_degree;
+
+                    m_stats = std::move(stats);
+                }
+                return *m_stats;
+            }
+
+            /**
+             * @brief The columns admitted by each row when this matrix is
+             *        used as a mask, bit packed (see PackedMaskRows).
+             *
+             * Built on first request and cached until the structure or the
+             * values change.  Shared ownership lets a caller keep using the
+             * rows while it writes to this same matrix (C<C> = ...).
+             *
+             * @param[in] structure_flag  Admit every stored element instead
+             *                            of only the true ones.
+             */
+            std::shared_ptr<PackedMaskRows const>
+            packedMask(bool structure_flag) const
+            {
+                auto &cached(structure_flag ? m_structure_mask : m_value_mask);
+                if (!cached)
+                {
+                    wait();
+                    cached = std::make_shared<PackedMaskRows const>(
+                        *this, structure_flag);
+                }
+                return cached;
+            }
+
             template<typename RAIteratorIT,
                      typename RAIteratorJT,
                      typename RAIteratorVT>
@@ -708,6 +963,7 @@ namespace grb
                                RAIteratorJT        col_it,
                                RAIteratorVT        values) const
             {
+                wait();
                 for (IndexType row = 0; row < m_data.size(); ++row)
                 {
                     for (auto&& [col_idx, val] : m_data[row])
@@ -722,6 +978,7 @@ namespace grb
             // output specific to the storage layout of this type of matrix
             void printInfo(std::ostream &os) const
             {
+                wait();
                 os << "backend::LilSparseMatrix<" << typeid(ScalarT).name() << "> ";
                 os << "(" << m_num_rows << " x " << m_num_cols << "), nvals = "
                    << nvals() << std::endl;
@@ -795,12 +1052,183 @@ namespace grb
             }
 
         private:
+            // Deleted elements keep their place in the sorted part of a row
+            // with this bit set in their column index.
+            static constexpr IndexType ZOMBIE_BIT = IndexType(1) << 63;
+
+            // Rows with tuples appended past the sorted part are assembled
+            // once the tail reaches max(MIN_PENDING, sqrt(row size)).
+            static constexpr IndexType MIN_PENDING = 64;
+
+            struct PendingRowInfo
+            {
+                IndexType num_sorted;   // length of the sorted part
+                IndexType num_zombies;  // zombies within the sorted part
+            };
+
+            void invalidateStats()
+            {
+                m_stats.reset();
+                invalidateMasks();
+            }
+
+            void invalidateMasks()
+            {
+                m_value_mask.reset();
+                m_structure_mask.reset();
+            }
+
+            static bool is_zombie(IndexType idx)
+            {
+                return (idx & ZOMBIE_BIT) != 0;
+            }
+
+            static bool column_less(ElementType const &elt, IndexType icol)
+            {
+                return (std::get<0>(elt) & ~ZOMBIE_BIT) < icol;
+            }
+
+            // Find the stored element (live or zombie) for icol without
+            // assembling the row: binary search the sorted part, then scan
+            // the pending tuples.  Returns the row's end() if absent.
+            typename RowType::iterator findElement(IndexType irow,
+                                                   IndexType icol) const
+            {
+                RowType &row(m_data[irow]);
+                IndexType num_sorted(row.size());
+                if (!m_pending.empty())
+                {
+                    auto pend(m_pending.find(irow));
+                    if (pend != m_pending.end())
+                    {
+                        num_sorted = pend->second.num_sorted;
+                    }
+                }
+
+                auto sorted_end(row.begin() + num_sorted);
+                auto it(std::lower_bound(row.begin(), sorted_end, icol,
+                                         column_less));
+                if ((it != sorted_end) &&
+                    ((std::get<0>(*it) & ~ZOMBIE_BIT) == icol))
+                {
+                    return it;
+                }
+
+                for (it = sorted_end; it != row.end(); ++it)
+                {
+                    if (std::get<0>(*it) == icol)
+                    {
+                        return it;
+                    }
+                }
+                return row.end();
+            }
+
+            template <typename BinaryOpT>
+            void setOrMergeElement(IndexType irow, IndexType icol,
+                                   ScalarT const &val, BinaryOpT merge)
+            {
+                RowType &row(m_data[irow]);
+                auto it(findElement(irow, icol));
+                if (it != row.end())
+                {
+                    if (is_zombie(std::get<0>(*it)))
+                    {
+                        // revive the zombie in place
+                        std::get<0>(*it) = icol;
+                        std::get<1>(*it) = val;
+                        --m_pending[irow].num_zombies;
+                        ++m_nvals;
+                        invalidateStats();
+                    }
+                    else
+                    {
+                        // merge with existing stored value
+                        std::get<1>(*it) = merge(std::get<1>(*it), val);
+                        m_value_mask.reset();
+                    }
+                    return;
+                }
+
+                ++m_nvals;
+                invalidateStats();
+                auto pend(m_pending.find(irow));
+                IndexType num_sorted((pend == m_pending.end()) ?
+                                     row.size() : pend->second.num_sorted);
+
+                // Appending past the last sorted column keeps the row sorted
+                if ((num_sorted == row.size()) &&
+                    (row.empty() ||
+                     ((std::get<0>(row.back()) & ~ZOMBIE_BIT) < icol)))
+                {
+                    row.emplace_back(icol, val);
+                    if (pend != m_pending.end())
+                    {
+                        ++(pend->second.num_sorted);
+                    }
+                    return;
+                }
+
+                if (pend == m_pending.end())
+                {
+                    pend = m_pending.emplace(
+                        irow, PendingRowInfo{row.size(), 0}).first;
+                }
+                row.emplace_back(icol, val);
+
+                IndexType num_pending(row.size() - pend->second.num_sorted);
+                if (num_pending >= std::max<IndexType>(
+                        MIN_PENDING,
+                        static_cast<IndexType>(std::sqrt(row.size()))))
+                {
+                    assembleRow(irow, pend->second);
+                    m_pending.erase(pend);
+                }
+            }
+
+            // Remove zombies, sort the pending tuples and merge them into
+            // the sorted part of the row.
+            void assembleRow(IndexType irow, PendingRowInfo const &info) const
+            {
+                RowType &row(m_data[irow]);
+                auto sorted_end(row.begin() + info.num_sorted);
+
+                if (info.num_zombies > 0)
+                {
+                    auto live_end(std::remove_if(
+                                      row.begin(), sorted_end,
+                                      [](ElementType const &elt)
+                                      { return is_zombie(std::get<0>(elt)); }));
+                    sorted_end = row.erase(live_end, sorted_end);
+                }
+
+                auto col_compare = [](ElementType const &lhs,
+                                      ElementType const &rhs)
+                    { return std::get<0>(lhs) < std::get<0>(rhs); };
+                std::sort(sorted_end, row.end(), col_compare);
+                std::inplace_merge(row.begin(), sorted_end, row.end(),
+                                   col_compare);
+            }
+
             IndexType m_num_rows;
             IndexType m_num_cols;
             IndexType m_nvals;
 
-            // List-of-lists storage (LIL) really VOV
-            std::vector<RowType> m_data;
+            // List-of-lists storage (LIL) really VOV.  Mutable so that
+            // pending updates can be assembled on read.
+            mutable std::vector<RowType> m_data;
+
+            // Rows holding pending tuples and/or zombies
+            mutable std::unordered_map<IndexType, PendingRowInfo> m_pending;
+
+            // Cached degree statistics; null until requested or after a
+            // structural change.
+            mutable std::unique_ptr<DegreeStats> m_stats;
+
+            // Cached packed mask rows (value and structure); null until
+            // requested or after any change.
+            mutable std::shared_ptr<PackedMaskRows const> m_value_mask;
+            mutable std::shared_ptr<PackedMaskRows const> m_structure_mask;
         };
 
     } // namespace backend
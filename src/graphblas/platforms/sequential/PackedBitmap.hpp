@@ -0,0 +1,457 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <type_traits>
+
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+
+#include "semiring_kernels.hpp"
+
+namespace grb
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /**
+         * @brief A fixed size sequence of bits packed into 64-bit words.
+         *
+         * Used for the structure (bitmap) of BitmapSparseVector and for the
+         * values of boolean vectors so that logical operations can be
+         * performed 64 elements at a time.  Bits beyond size() in the last
+         * word are always kept clear so that word-wise results (population
+         * counts, complements) never see stale data.
+         */
+        class PackedBitmap
+        {
+        public:
+            using WordType = uint64_t;
+            static constexpr IndexType BITS_PER_WORD = 64;
+
+            /// Proxy returned by the non-const subscript operator
+            class reference
+            {
+            public:
+                reference(WordType &word, WordType bit)
+                    : m_word(word), m_bit(bit) {}
+
+                operator bool() const { return (m_word & m_bit) != 0; }
+
+                reference &operator=(bool val)
+                {
+                    if (val) m_word |= m_bit; else m_word &= ~m_bit;
+                    return *this;
+                }
+
+                reference &operator=(reference const &rhs)
+                {
+                    return operator=(static_cast<bool>(rhs));
+                }
+
+            private:
+                WordType &m_word;
+                WordType  m_bit;
+            };
+
+            PackedBitmap() : m_size(0) {}
+
+            PackedBitmap(IndexType nsize, bool value = false)
+                : m_size(nsize),
+                  m_words(num_words(nsize), value ? ~WordType(0) : WordType(0))
+            {
+                clear_tail();
+            }
+
+            explicit PackedBitmap(std::vector<bool> const &bits)
+                : m_size(bits.size()),
+                  m_words(num_words(bits.size()), WordType(0))
+            {
+                for (IndexType idx = 0; idx < m_size; ++idx)
+                {
+                    if (bits[idx]) set(idx);
+                }
+            }
+
+            IndexType size() const { return m_size; }
+
+            static IndexType num_words(IndexType nsize)
+            {
+                return (nsize + BITS_PER_WORD - 1)/BITS_PER_WORD;
+            }
+
+            static WordType bit_mask(IndexType idx)
+            {
+                return WordType(1) << (idx % BITS_PER_WORD);
+            }
+
+            bool operator[](IndexType idx) const
+            {
+                return (m_words[idx/BITS_PER_WORD] & bit_mask(idx)) != 0;
+            }
+
+            reference operator[](IndexType idx)
+            {
+                return reference(m_words[idx/BITS_PER_WORD], bit_mask(idx));
+            }
+
+            bool operator==(PackedBitmap const &rhs) const
+            {
+                return ((m_size == rhs.m_size) && (m_words == rhs.m_words));
+            }
+
+            bool operator!=(PackedBitmap const &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+            void set(IndexType idx)   { m_words[idx/BITS_PER_WORD] |=  bit_mask(idx); }
+            void reset(IndexType idx) { m_words[idx/BITS_PER_WORD] &= ~bit_mask(idx); }
+
+            void assign(IndexType nsize, bool value)
+            {
+                m_size = nsize;
+                m_words.assign(num_words(nsize),
+                               value ? ~WordType(0) : WordType(0));
+                clear_tail();
+            }
+
+            void resize(IndexType nsize, bool value = false)
+            {
+                IndexType old_size(m_size);
+                m_size = nsize;
+                m_words.resize(num_words(nsize), value ? ~WordType(0) : WordType(0));
+                if (value && (nsize > old_size) && (old_size % BITS_PER_WORD))
+                {
+                    m_words[old_size/BITS_PER_WORD] |=
+                        ~WordType(0) << (old_size % BITS_PER_WORD);
+                }
+                clear_tail();
+            }
+
+            void swap(PackedBitmap &rhs)
+            {
+                std::swap(m_size, rhs.m_size);
+                m_words.swap(rhs.m_words);
+            }
+
+            /// Invert every bit in [0, size())
+            void flip()
+            {
+                for (auto &word : m_words) word = ~word;
+                clear_tail();
+            }
+
+            /// Number of set bits in [0, size())
+            IndexType count() const
+            {
+                IndexType cnt(0);
+                for (auto word : m_words) cnt += __builtin_popcountll(word);
+                return cnt;
+            }
+
+            /// Number of set bits in [begin, end)
+            IndexType count(IndexType begin, IndexType end) const
+            {
+                IndexType cnt(0);
+                for (IndexType idx = begin; idx < end; )
+                {
+                    IndexType wd(idx/BITS_PER_WORD);
+                    IndexType lo(idx % BITS_PER_WORD);
+                    IndexType hi(std::min<IndexType>(BITS_PER_WORD,
+                                                     end - wd*BITS_PER_WORD));
+                    WordType word(m_words[wd] >> lo);
+                    if (hi - lo < BITS_PER_WORD)
+                    {
+                        word &= (WordType(1) << (hi - lo)) - 1;
+                    }
+                    cnt += __builtin_popcountll(word);
+                    idx = wd*BITS_PER_WORD + hi;
+                }
+                return cnt;
+            }
+
+            /// Index of the first set bit at or after idx, or size() if none
+            IndexType find_next(IndexType idx) const
+            {
+                if (idx >= m_size) return m_size;
+
+                IndexType wd(idx/BITS_PER_WORD);
+                WordType word(m_words[wd] & (~WordType(0) << (idx % BITS_PER_WORD)));
+                while (word == 0)
+                {
+                    if (++wd == m_words.size()) return m_size;
+                    word = m_words[wd];
+                }
+                return wd*BITS_PER_WORD + __builtin_ctzll(word);
+            }
+
+            /// Call fn(idx) for every set bit, in increasing order
+            template <typename FunctionT>
+            void for_each_set(FunctionT fn) const
+            {
+                for (IndexType wd = 0; wd < m_words.size(); ++wd)
+                {
+                    WordType word(m_words[wd]);
+                    while (word)
+                    {
+                        fn(wd*BITS_PER_WORD + __builtin_ctzll(word));
+                        word &= word - 1;
+                    }
+                }
+            }
+
+            std::vector<WordType>       &words()       { return m_words; }
+            std::vector<WordType> const &words() const { return m_words; }
+
+            /// Must be called after modifying words() with complementing ops
+            void clear_tail()
+            {
+                if ((m_size % BITS_PER_WORD) && !m_words.empty())
+                {
+                    m_words.back() &=
+                        (WordType(1) << (m_size % BITS_PER_WORD)) - 1;
+                }
+            }
+
+        private:
+            IndexType             m_size;
+            std::vector<WordType> m_words;
+        };
+
+        //**********************************************************************
+        /**
+         * @brief The columns each row of a matrix mask admits, bit packed.
+         *
+         * A row is stored as a bitset of ncols bits when that is smaller than
+         * its list of admitted column indices (more than one admitted column
+         * per 64), and as the bare sorted column indices otherwise, so a row
+         * never costs more than ncols/8 bytes nor more than 8 bytes per
+         * admitted column (a stored tuple costs 16).  Both forms share one
+         * array of 64-bit words addressed by a row offset.
+         *
+         * Built from the stored elements of a matrix: every stored element
+         * for a structure mask, only those whose value is true otherwise.
+         * Complemented masks use the same rows; see MaskRow.
+         */
+        class PackedMaskRows
+        {
+        public:
+            using WordType = PackedBitmap::WordType;
+            static constexpr IndexType BITS_PER_WORD =
+                PackedBitmap::BITS_PER_WORD;
+
+            PackedMaskRows() : m_ncols(0) {}
+
+            template <typename MatrixT>
+            PackedMaskRows(MatrixT const &mat, bool structure_flag)
+                : m_ncols(mat.ncols()),
+                  m_row_ptr(mat.nrows() + 1, 0),
+                  m_count(mat.nrows(), 0),
+                  m_dense(mat.nrows())
+            {
+                IndexType const row_words(PackedBitmap::num_words(m_ncols));
+
+                // Pass 1: admitted columns per row decide each row's form
+                for (IndexType row_idx = 0; row_idx < mat.nrows(); ++row_idx)
+                {
+                    IndexType cnt(0);
+                    for (auto&& [col_idx, val] : mat[row_idx])
+                    {
+                        if (structure_flag || static_cast<bool>(val)) ++cnt;
+                    }
+                    m_count[row_idx] = cnt;
+                    if (cnt > row_words) m_dense.set(row_idx);
+                    m_row_ptr[row_idx + 1] = m_row_ptr[row_idx] +
+                        (m_dense[row_idx] ? row_words : cnt);
+                }
+
+                // Pass 2: fill the words
+                m_words.assign(m_row_ptr.back(), WordType(0));
+                for (IndexType row_idx = 0; row_idx < mat.nrows(); ++row_idx)
+                {
+                    WordType *row_data(m_words.data() + m_row_ptr[row_idx]);
+                    bool const dense(m_dense[row_idx]);
+                    for (auto&& [col_idx, val] : mat[row_idx])
+                    {
+                        if (!(structure_flag || static_cast<bool>(val)))
+                            continue;
+
+                        if (dense)
+                            row_data[col_idx/BITS_PER_WORD] |=
+                                PackedBitmap::bit_mask(col_idx);
+                        else
+                            *row_data++ = col_idx;
+                    }
+                }
+            }
+
+            IndexType nrows() const { return m_count.size(); }
+            IndexType ncols() const { return m_ncols; }
+
+            /// Number of columns admitted by a row
+            IndexType count(IndexType row_idx) const { return m_count[row_idx]; }
+
+            /// True if the row is held as a bitset
+            bool is_dense(IndexType row_idx) const { return m_dense[row_idx]; }
+
+            /// The row's bitset words (is_dense) or column indices (otherwise)
+            WordType const *row_data(IndexType row_idx) const
+            {
+                return m_words.data() + m_row_ptr[row_idx];
+            }
+
+            /// Words used by all rows, for sizing comparisons
+            IndexType num_words() const { return m_words.size(); }
+
+        private:
+            IndexType             m_ncols;
+            IndexArrayType        m_row_ptr;
+            IndexArrayType        m_count;
+            PackedBitmap          m_dense;
+            std::vector<WordType> m_words;
+        };
+
+        //**********************************************************************
+        /**
+         * @brief Membership tests against one row of PackedMaskRows, with
+         *        an optional complement.
+         *
+         * admits() must be called with nondecreasing column indices: a
+         * bitset row is tested directly, a sparse row is walked forward.
+         */
+        class MaskRow
+        {
+        public:
+            using WordType = PackedMaskRows::WordType;
+
+            MaskRow(PackedMaskRows const &mask,
+                    IndexType             row_idx,
+                    bool                  complement_flag)
+                : m_data(mask.row_data(row_idx)),
+                  m_count(mask.count(row_idx)),
+                  m_ncols(mask.ncols()),
+                  m_dense(mask.is_dense(row_idx)),
+                  m_complement(complement_flag),
+                  m_pos(0)
+            {
+            }
+
+            /// True if the row admits no column
+            bool admits_none() const
+            {
+                return m_complement ? (m_count == m_ncols) : (m_count == 0);
+            }
+
+            /// True if the row admits every column
+            bool admits_all() const
+            {
+                return m_complement ? (m_count == 0) : (m_count == m_ncols);
+            }
+
+            bool admits(IndexType col_idx)
+            {
+                bool in_row;
+                if (m_dense)
+                {
+                    in_row = (m_data[col_idx/PackedMaskRows::BITS_PER_WORD] &
+                              PackedBitmap::bit_mask(col_idx)) != 0;
+                }
+                else
+                {
+                    while ((m_pos < m_count) && (m_data[m_pos] < col_idx))
+                        ++m_pos;
+                    in_row = (m_pos < m_count) && (m_data[m_pos] == col_idx);
+                }
+                return in_row != m_complement;
+            }
+
+        private:
+            WordType const *m_data;
+            IndexType       m_count;
+            IndexType       m_ncols;
+            bool            m_dense;
+            bool            m_complement;
+            IndexType       m_pos;
+        };
+
+        //**********************************************************************
+        /// Value storage for BitmapSparseVector: booleans are bit packed.
+        template <typename ScalarT>
+        using BitmapValueStorage =
+            std::conditional_t<std::is_same_v<ScalarT, bool>,
+                               PackedBitmap,
+                               std::vector<ScalarT>>;
+
+        //**********************************************************************
+        // Traits identifying boolean operators that have an exact 64-wide
+        // word equivalent.  Only all-bool instantiations qualify.
+        //**********************************************************************
+        template <typename OpT>
+        struct word_op_traits
+        {
+            static constexpr bool value = false;
+        };
+
+#define GEN_GRAPHBLAS_WORD_OP(BINARYOP, MONOID, WORD_EXPR)              \
+        template <>                                                     \
+        struct word_op_traits<BINARYOP<bool, bool, bool>>               \
+        {                                                               \
+            static constexpr bool value = true;                         \
+            static PackedBitmap::WordType apply(PackedBitmap::WordType a, \
+                                                PackedBitmap::WordType b) \
+            { return WORD_EXPR; }                                       \
+        };                                                              \
+        template <>                                                     \
+        struct word_op_traits<MONOID<bool>>                             \
+            : public word_op_traits<BINARYOP<bool, bool, bool>> {};
+
+        GEN_GRAPHBLAS_WORD_OP(LogicalOr,   LogicalOrMonoid,   a | b)
+        GEN_GRAPHBLAS_WORD_OP(LogicalAnd,  LogicalAndMonoid,  a & b)
+        GEN_GRAPHBLAS_WORD_OP(LogicalXor,  LogicalXorMonoid,  a ^ b)
+        GEN_GRAPHBLAS_WORD_OP(LogicalXnor, LogicalXnorMonoid, ~(a ^ b))
+
+#undef GEN_GRAPHBLAS_WORD_OP
+
+        template <typename OpT>
+        inline constexpr bool is_word_op_v = word_op_traits<OpT>::value;
+
+        /// NoAccumulate, or an accumulator with a word equivalent
+        template <typename AccumT>
+        inline constexpr bool is_word_accum_v =
+            std::is_same_v<AccumT, NoAccumulate> || is_word_op_v<AccumT>;
+
+        /// The boolean OR-AND semiring, the only one with a bitmap kernel.
+        template <typename SemiringT>
+        inline constexpr bool is_logical_semiring_v =
+            (semiring_kernel_v<SemiringT> == SemiringKernel::LOGICAL_OR_AND);
+    } // backend
+} // grb
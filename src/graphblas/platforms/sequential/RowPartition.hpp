@@ -0,0 +1,226 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+#include <graphblas/types.hpp>
+
+//****************************************************************************
+// Work-balanced partitioning of the rows of a matrix.
+//
+// Kernels that split their outer row loop among workers should split it by
+// work, not by row count: in power-law graphs a few hub rows hold most of
+// the stored values (and most of the flops of a product), so equal row
+// ranges leave one worker with nearly everything.  The work of each row is
+// expressed as an exclusive prefix sum (size nrows+1, prefix[0] == 0) and
+// the partitioners below cut that prefix into balanced pieces.
+//****************************************************************************
+
+namespace grb
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /// Prefix sum of the number of stored values in each row of A.  Uses
+        /// the cached degree statistics, so repeated calls cost O(nrows).
+        template <typename MatrixT>
+        IndexArrayType row_nnz_prefix(MatrixT const &A)
+        {
+            auto const &row_degrees(A.degreeStats().row_degrees);
+            IndexArrayType prefix(row_degrees.size() + 1, 0);
+            std::partial_sum(row_degrees.begin(), row_degrees.end(),
+                             prefix.begin() + 1);
+            return prefix;
+        }
+
+        /// The rows of A' are the columns of A.
+        template <typename MatrixT>
+        IndexArrayType row_nnz_prefix(TransposeView<MatrixT> const &AT)
+        {
+            auto const &col_degrees(AT.m_mat.degreeStats().col_degrees);
+            IndexArrayType prefix(col_degrees.size() + 1, 0);
+            std::partial_sum(col_degrees.begin(), col_degrees.end(),
+                             prefix.begin() + 1);
+            return prefix;
+        }
+
+        //**********************************************************************
+        /// Prefix sum of the multiplications needed by each row of A*B
+        /// (row-wise/Gustavson): row i costs sum_{k in A(i,:)} nvals(B(k,:)).
+        template <typename AMatrixT, typename BMatrixT>
+        IndexArrayType row_flops_prefix(AMatrixT const &A, BMatrixT const &B)
+        {
+            auto const &b_row_degrees(B.degreeStats().row_degrees);
+            IndexArrayType prefix(A.nrows() + 1, 0);
+            for (IndexType i = 0; i < A.nrows(); ++i)
+            {
+                IndexType flops(0);
+                for (auto&& [k, a_ik] : A[i])
+                {
+                    flops += b_row_degrees[k];
+                }
+                prefix[i + 1] = prefix[i] + flops;
+            }
+            return prefix;
+        }
+
+        //**********************************************************************
+        /**
+         * @brief Cut a range of rows into num_parts pieces of roughly equal
+         *        work, keeping every row whole.
+         *
+         * Part p covers rows [bounds[p], bounds[p+1]).  A part may be empty
+         * when a single row carries more than a part's share of the work;
+         * use merge_path_partition() when such rows must be split too.  Rows
+         * with no work cost nothing here, so pass a prefix that counts
+         * something per row (e.g. nnz + 1) if empty rows are not free.
+         *
+         * @param[in] work_prefix  Exclusive prefix sum of per-row work
+         * @return num_parts + 1 nondecreasing row indices, from 0 to nrows.
+         */
+        inline IndexArrayType partition_rows(IndexArrayType const &work_prefix,
+                                             IndexType             num_parts)
+        {
+            IndexType const nrows(work_prefix.size() - 1);
+            IndexType const total(work_prefix.back());
+            num_parts = std::max<IndexType>(num_parts, 1);
+
+            IndexArrayType bounds(num_parts + 1, nrows);
+            bounds[0] = 0;
+            for (IndexType p = 1; p < num_parts; ++p)
+            {
+                // First row that starts at or beyond this part's share
+                IndexType const target(
+                    static_cast<IndexType>((static_cast<double>(total) * p) /
+                                           num_parts));
+                auto it = std::lower_bound(work_prefix.begin(),
+                                           work_prefix.end() - 1, target);
+                bounds[p] = std::max<IndexType>(
+                    bounds[p - 1], std::distance(work_prefix.begin(), it));
+            }
+            return bounds;
+        }
+
+        //**********************************************************************
+        /// A position in the merge of the row ends and the stored values of a
+        /// matrix: all rows before row are complete and nz values (counting
+        /// from the start of the matrix) have been consumed.
+        struct MergePathCoord
+        {
+            IndexType row;
+            IndexType nz;
+        };
+
+        /**
+         * @brief Merge-path partition (Merrill & Garland) of rows and stored
+         *        values into num_parts pieces of equal size.
+         *
+         * The work of a matrix is the merge of its nrows row ends with its
+         * nnz stored values.  Cutting that merged list into equal pieces
+         * gives every part (nrows + nnz)/num_parts items (+/-1) no matter how
+         * the values are distributed, splitting hub rows among several parts
+         * as needed.  A row split this way yields a partial result in each
+         * part it touches; the caller combines those with the add monoid
+         * (see merge_path_segments()).
+         *
+         * @param[in] row_prefix  Exclusive prefix sum of nnz per row
+         *                        (row_nnz_prefix())
+         * @return num_parts + 1 coordinates, from (0,0) to (nrows,nnz).
+         */
+        inline std::vector<MergePathCoord>
+        merge_path_partition(IndexArrayType const &row_prefix,
+                             IndexType             num_parts)
+        {
+            IndexType const nrows(row_prefix.size() - 1);
+            IndexType const nnz(row_prefix.back());
+            IndexType const total(nrows + nnz);
+            num_parts = std::max<IndexType>(num_parts, 1);
+
+            std::vector<MergePathCoord> coords(num_parts + 1);
+            for (IndexType p = 0; p <= num_parts; ++p)
+            {
+                IndexType const diagonal(
+                    static_cast<IndexType>((static_cast<double>(total) * p) /
+                                           num_parts));
+
+                // Binary search along the diagonal for the first row whose
+                // end has not been passed: row ends win ties, so a row's
+                // last value is always consumed before the row is closed.
+                IndexType lo(diagonal > nnz ? diagonal - nnz : 0);
+                IndexType hi(std::min(diagonal, nrows));
+                while (lo < hi)
+                {
+                    IndexType const pivot((lo + hi) / 2);
+                    if (row_prefix[pivot + 1] <= diagonal - pivot - 1)
+                    {
+                        lo = pivot + 1;
+                    }
+                    else
+                    {
+                        hi = pivot;
+                    }
+                }
+                coords[p] = {lo, diagonal - lo};
+            }
+            return coords;
+        }
+
+        //**********************************************************************
+        /**
+         * @brief Visit the (possibly partial) rows covered by one part of a
+         *        merge-path partition, [begin, end).
+         *
+         * Calls fn(row, first, last) once per row that has stored values in
+         * the part, where [first, last) are offsets into that row.  A row
+         * whose values are spread over several parts is visited from each
+         * of them with disjoint offset ranges.
+         */
+        template <typename SegmentFnT>
+        void merge_path_segments(IndexArrayType const &row_prefix,
+                                 MergePathCoord const &begin,
+                                 MergePathCoord const &end,
+                                 SegmentFnT            fn)
+        {
+            IndexType nz(begin.nz);
+            for (IndexType row = begin.row;
+                 (row <= end.row) && (row + 1 < row_prefix.size()); ++row)
+            {
+                IndexType const row_end(std::min(row_prefix[row + 1], end.nz));
+                if (nz < row_end)
+                {
+                    fn(row, nz - row_prefix[row], row_end - row_prefix[row]);
+                    nz = row_end;
+                }
+            }
+        }
+    } // backend
+} // grb
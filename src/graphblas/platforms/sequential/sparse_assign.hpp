@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -75,8 +76,29 @@ namespace grb
                 ++idx;
             }
 
-            // Sort them because we want to deal with them in output order.
-            std::sort(inputOrder.begin(), inputOrder.end(), IndexCompare());
+            // Sort them because we want to deal with them in output order
+            // (already sorted index arrays are left alone).
+            if (!std::is_sorted(inputOrder.begin(), inputOrder.end(),
+                                IndexCompare()))
+            {
+                std::sort(inputOrder.begin(), inputOrder.end(), IndexCompare());
+            }
+        }
+
+        //********************************************************************
+        template <typename SequenceT>
+        std::vector<std::tuple<IndexType, IndexType>>
+        prepare_expand_indices(SequenceT const &Indices)
+        {
+            std::vector<std::tuple<IndexType, IndexType>> oi_pairs;
+            compute_outin_mapping(Indices, oi_pairs);
+            return oi_pairs;
+        }
+
+        /// A Range maps input i to output lo + i*stride directly
+        inline Range prepare_expand_indices(Range const &Indices)
+        {
+            return Indices;
         }
 
         //********************************************************************
@@ -144,6 +166,28 @@ namespace grb
             }
         }
 
+        //********************************************************************
+        // Range case: a single pass over the stored values of the source.
+        template <typename TScalarT,
+                  typename AScalarT>
+        void vectorExpand(
+            std::vector<std::tuple<IndexType, TScalarT>>        &vec_dest,
+            std::vector<std::tuple<IndexType, AScalarT>>  const &vec_src,
+            Range                                         const &Indices)
+        {
+            vec_dest.clear();
+
+            for (auto&& [src_idx, src_val] : vec_src)
+            {
+                if (src_idx >= Indices.size())
+                {
+                    break;
+                }
+                vec_dest.emplace_back(Indices[src_idx],
+                                      static_cast<TScalarT>(src_val));
+            }
+        }
+
         //********************************************************************
         // non-transposed case.
         template<typename TScalarT,
@@ -158,8 +202,7 @@ namespace grb
             T.clear();
 
             // Build the mapping pairs once up front
-            std::vector<std::tuple<IndexType, IndexType>> oi_pairs;
-            compute_outin_mapping(col_Indices, oi_pairs);
+            auto oi_pairs(prepare_expand_indices(col_Indices));
 
             // Walk the input rows (in order specified by input)
             for (IndexType in_row_index = 0;
@@ -196,9 +239,8 @@ namespace grb
 
             // Build the mapping pairs once up front (rows of AT -> cols of T)
             std::vector<std::tuple<IndexType, IndexType>> oi_col_pairs;
-            std::vector<std::tuple<IndexType, IndexType>> oi_row_pairs;
             compute_outin_mapping(col_Indices, oi_col_pairs);
-            compute_outin_mapping(row_Indices, oi_row_pairs);
+            auto oi_row_pairs(prepare_expand_indices(row_Indices));
 
             std::vector<std::tuple<IndexType,TScalarT> > out_col;
 
@@ -291,8 +333,8 @@ namespace grb
             check_index_array_content(indices, w.size(),
                                       "assign(std vec): indices content check");
 
-            std::vector<std::tuple<IndexType, IndexType>> oi_pairs;
-            compute_outin_mapping(setupIndices(indices, u.size()), oi_pairs);
+            auto oi_pairs(
+                prepare_expand_indices(setupIndices(indices, u.size())));
 
             // =================================================================
             // Expand to t
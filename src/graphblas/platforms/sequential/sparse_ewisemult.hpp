@@ -66,6 +66,33 @@ namespace grb
             VVectorT                                  const &v,
             OutputControlEnum                                outp)
         {
+            // Boolean vectors with logical operators are done a word at a time
+            if constexpr (std::is_same_v<WScalarT, bool> &&
+                          std::is_same_v<typename UVectorT::ScalarType, bool> &&
+                          std::is_same_v<typename VVectorT::ScalarType, bool> &&
+                          is_word_op_v<BinaryOpT> &&
+                          is_word_accum_v<AccumT>)
+            {
+                PackedBitmap t_bitmap(w.size()), t_vals(w.size());
+                auto       &tb(t_bitmap.words());
+                auto       &tv(t_vals.words());
+                auto const &ub(u.get_bitmap().words());
+                auto const &uv(u.get_vals().words());
+                auto const &vb(v.get_bitmap().words());
+                auto const &vv(v.get_vals().words());
+
+                for (IndexType wd = 0; wd < tb.size(); ++wd)
+                {
+                    tb[wd] = ub[wd] & vb[wd];
+                    tv[wd] = tb[wd] &
+                        word_op_traits<BinaryOpT>::apply(uv[wd], vv[wd]);
+                }
+
+                ewise_or_opt_accum_bitmap(t_bitmap, t_vals, w, accum);
+                write_bitmap_with_opt_mask_1D(w, t_bitmap, t_vals, mask, outp);
+                return;
+            }
+
             // =================================================================
             // Do the basic ewise-and work: t = u .* v
             using D3ScalarType =
@@ -75,7 +102,7 @@ namespace grb
 
             if ((u.nvals() > 0) && (v.nvals() > 0))
             {
-                ewise_and(t_contents, u.getContents(), v.getContents(), op);
+                ewise_and(t_contents, u.nonzeros(), v.nonzeros(), op);
             }
 
             // =================================================================
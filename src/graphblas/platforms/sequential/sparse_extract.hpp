@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -42,6 +43,7 @@
 
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
+#include "BitmapSparseVector.hpp"
 
 //******************************************************************************
 
@@ -51,45 +53,143 @@ namespace grb
     {
         //**********************************************************************
         /**
-         * Extracts a series of values from the vector based on the passed in
-         * indices.
-         * @tparam CScalarT  The type of the output scalar.
-         * @tparam AScalarT  The type of the input scalar.
-         * @tparam SequenceT A random access iterator into a container of indices
+         * Build the (input index, output position) pairs of an index sequence
+         * sorted by input index, so that a sorted sparse vector can be sliced
+         * with a single merge.  The indices may be out of order and contain
+         * duplicates; an already sorted sequence is not re-sorted.
+         */
+        template <typename SequenceT>
+        std::vector<std::tuple<IndexType, IndexType>>
+        prepare_extract_indices(SequenceT const &indices)
+        {
+            std::vector<std::tuple<IndexType, IndexType>> in_out;
+            in_out.reserve(indices.size());
+
+            IndexType out_idx = 0;
+            for (auto it = indices.begin(); it != indices.end();
+                 ++it, ++out_idx)
+            {
+                in_out.emplace_back(*it, out_idx);
+            }
+
+            if (!std::is_sorted(in_out.begin(), in_out.end()))
+            {
+                std::sort(in_out.begin(), in_out.end());
+            }
+            return in_out;
+        }
+
+        /// A Range is already sorted and needs no mapping
+        inline Range prepare_extract_indices(Range const &indices)
+        {
+            return indices;
+        }
+
+        //**********************************************************************
+        /**
+         * Extracts a series of values from the vector based on the (input,
+         * output) pairs from prepare_extract_indices.
          *
-         * @param vec_dest The output vector.
-         * @param vec_src The input vector.
-         * @param begin   Iterator at begining of sequence of indices to extract.
-         * @param end     Iterator at end of sequence of indices to extract.
+         * A single merge of the two sorted lists, or a binary search per
+         * stored element when the vector is much sparser than the index list.
+         * The result is put in output order (sorted only if the index list
+         * was not).
          */
         template<typename CScalarT,
-                 typename AScalarT,
-                 typename IteratorT>
+                 typename AScalarT>
         void vectorExtract(
-                std::vector<std::tuple<IndexType, CScalarT> >       &vec_dest,
-                std::vector<std::tuple<IndexType, AScalarT> > const &vec_src,
-                IteratorT           begin,
-                IteratorT           end)
+            std::vector<std::tuple<IndexType, CScalarT> >         &vec_dest,
+            std::vector<std::tuple<IndexType, AScalarT> >   const &vec_src,
+            std::vector<std::tuple<IndexType, IndexType> >  const &in_out)
         {
-            // This is expensive but the indices can be duplicates and
-            // out of order.
-
             vec_dest.clear();
 
             GRB_LOG_VERBOSE("vectorExtract: sizeof(vec_src): " << vec_src.size());
 
-            IndexType out_idx = 0;
-            for (auto col_it = begin; col_it != end; ++col_it, ++out_idx)
+            if (8*vec_src.size() < in_out.size())
+            {
+                for (auto&& [src_idx, src_val] : vec_src)
+                {
+                    auto range = std::equal_range(
+                        in_out.begin(), in_out.end(),
+                        std::make_tuple(src_idx, IndexType(0)),
+                        [](auto const &a, auto const &b)
+                        { return std::get<0>(a) < std::get<0>(b); });
+                    for (auto it = range.first; it != range.second; ++it)
+                    {
+                        vec_dest.emplace_back(std::get<1>(*it),
+                                              static_cast<CScalarT>(src_val));
+                    }
+                }
+            }
+            else
             {
-                GRB_LOG_VERBOSE("out_idx = " << out_idx);
-                IndexType wanted_idx = *col_it;
-
-                // Search through the outputs find one that matches.
                 auto A_it = vec_src.begin();
-                if (increment_while_below(A_it, vec_src.end(), wanted_idx))
+                for (auto&& [in_idx, out_idx] : in_out)
+                {
+                    if (increment_while_below(A_it, vec_src.end(), in_idx))
+                    {
+                        vec_dest.emplace_back(
+                            out_idx, static_cast<CScalarT>(std::get<1>(*A_it)));
+                    }
+                    else if (A_it == vec_src.end())
+                    {
+                        break;
+                    }
+                }
+            }
+
+            auto out_less = [](auto const &a, auto const &b)
+                { return std::get<0>(a) < std::get<0>(b); };
+            if (!std::is_sorted(vec_dest.begin(), vec_dest.end(), out_less))
+            {
+                std::sort(vec_dest.begin(), vec_dest.end(), out_less);
+            }
+        }
+
+        //**********************************************************************
+        /**
+         * Extracts a strided range of values from the vector: a binary search
+         * for the start of the range followed by a walk to its end.
+         */
+        template<typename CScalarT,
+                 typename AScalarT>
+        void vectorExtract(
+            std::vector<std::tuple<IndexType, CScalarT> >         &vec_dest,
+            std::vector<std::tuple<IndexType, AScalarT> >   const &vec_src,
+            Range                                           const &indices)
+        {
+            vec_dest.clear();
+
+            IndexType lo(indices.lo()), hi(indices.hi());
+            IndexType stride(indices.stride());
+            auto idx_less = [](auto const &elt, IndexType idx)
+                { return std::get<0>(elt) < idx; };
+
+            // Whole (prefix of the) vector: one bulk copy, no index math
+            if ((lo == 0) && (stride == 1))
+            {
+                auto src_end =
+                    (vec_src.empty() || (std::get<0>(vec_src.back()) < hi)) ?
+                    vec_src.end() :
+                    std::lower_bound(vec_src.begin(), vec_src.end(), hi,
+                                     idx_less);
+                vec_dest.assign(vec_src.begin(), src_end);
+                return;
+            }
+
+            auto A_it = std::lower_bound(vec_src.begin(), vec_src.end(), lo,
+                                         idx_less);
+
+            for (; (A_it != vec_src.end()) && (std::get<0>(*A_it) < hi);
+                 ++A_it)
+            {
+                IndexType offset(std::get<0>(*A_it) - lo);
+                if ((stride == 1) || (offset % stride == 0))
                 {
                     vec_dest.emplace_back(
-                        out_idx, static_cast<CScalarT>(std::get<1>(*A_it)));
+                        offset/stride,
+                        static_cast<CScalarT>(std::get<1>(*A_it)));
                 }
             }
         }
@@ -101,37 +201,143 @@ namespace grb
         void vectorExtract(
                 std::vector<std::tuple<IndexType, CScalarT> >       &vec_dest,
                 std::vector<std::tuple<IndexType, AScalarT> > const &vec_src,
-                SequenceT                                            indices)
+                SequenceT                                     const &indices)
         {
-            vectorExtract(vec_dest, vec_src, indices.begin(), indices.end());
+            vectorExtract(vec_dest, vec_src, prepare_extract_indices(indices));
         }
 
-        // *******************************************************************
+        //**********************************************************************
+        /**
+         * Extracts from a bitmap vector in place (no copy of its contents):
+         * one O(1) lookup per wanted index, so the output is produced in
+         * order without any sorting.
+         */
+        template<typename CScalarT,
+                 typename UScalarT,
+                 typename SequenceT>
+        void vectorExtract(
+                std::vector<std::tuple<IndexType, CScalarT> >       &vec_dest,
+                BitmapSparseVector<UScalarT>                  const &u,
+                SequenceT                                     const &indices)
+        {
+            vec_dest.clear();
+
+            IndexType out_idx = 0;
+            for (auto it = indices.begin(); it != indices.end();
+                 ++it, ++out_idx)
+            {
+                if (u.hasElement(*it))
+                {
+                    vec_dest.emplace_back(
+                        out_idx, static_cast<CScalarT>(u.extractElement(*it)));
+                }
+            }
+        }
+
+        //**********************************************************************
+        /// Range over a bitmap vector: slice its sorted index list.
+        template<typename CScalarT,
+                 typename UScalarT>
+        void vectorExtract(
+                std::vector<std::tuple<IndexType, CScalarT> >       &vec_dest,
+                BitmapSparseVector<UScalarT>                  const &u,
+                Range                                         const &indices)
+        {
+            vec_dest.clear();
+
+            auto const &u_indices(u.getIndices());
+            auto it = std::lower_bound(u_indices.begin(), u_indices.end(),
+                                       indices.lo());
+            for (; (it != u_indices.end()) && (*it < indices.hi()); ++it)
+            {
+                if (indices.contains(*it))
+                {
+                    vec_dest.emplace_back(
+                        (*it - indices.lo())/indices.stride(),
+                        static_cast<CScalarT>(u.extractElement(*it)));
+                }
+            }
+        }
+
+        //**********************************************************************
+        /**
+         * Whole-row extract, C = A(rows, 0:hi): each selected row is copied as
+         * one contiguous block.
+         */
         template<typename CScalarT,
                  typename AScalarT,
-                 typename RowIteratorT,
-                 typename ColIteratorT>
+                 typename RowSequenceT>
+        void matrixExtractRows(LilSparseMatrix<CScalarT>          &C,
+                               LilSparseMatrix<AScalarT>  const   &A,
+                               RowSequenceT               const   &row_indices,
+                               IndexType                           hi)
+        {
+            C.clear();
+
+            auto idx_less = [](auto const &elt, IndexType idx)
+                { return std::get<0>(elt) < idx; };
+
+            IndexType out_row_index = 0;
+            for (auto row_it = row_indices.begin();
+                 row_it != row_indices.end();
+                 ++row_it, ++out_row_index)
+            {
+                auto const &row(A[*row_it]);
+                auto row_end =
+                    (row.empty() || (std::get<0>(row.back()) < hi)) ?
+                    row.end() :
+                    std::lower_bound(row.begin(), row.end(), hi, idx_less);
+                C[out_row_index].assign(row.begin(), row_end);
+            }
+            C.recomputeNvals();
+        }
+
+        //**********************************************************************
+        /**
+         * Extract a sub matrix from A to C as specified via the row indices.
+         * This is always destructive to C.
+         * @tparam CMatrixT The type of matrix for C
+         * @tparam AMatrixT The type of matrix for A
+         * @param C Where to place the outputs
+         * @param A The input matrix.  (Won't be changed)
+         * @param row_indices A set of indices indicating which rows to extract.
+         * @param col_indices A set of indices indicating which columns to extract.
+         */
+        template<typename CScalarT,
+                 typename AScalarT,
+                 typename RowSequenceT,
+                 typename ColSequenceT>
         void matrixExtract(LilSparseMatrix<CScalarT>          &C,
                            LilSparseMatrix<AScalarT>  const   &A,
-                           RowIteratorT                        row_begin,
-                           RowIteratorT                        row_end,
-                           ColIteratorT                        col_begin,
-                           ColIteratorT                        col_end)
+                           RowSequenceT               const   &row_indices,
+                           ColSequenceT               const   &col_indices)
         {
+            // NOTE!! Backend code. We expect that all dimension checks done elsewhere.
+
+            if constexpr (std::is_same_v<ColSequenceT, Range>)
+            {
+                if ((col_indices.lo() == 0) && (col_indices.stride() == 1))
+                {
+                    matrixExtractRows(C, A, row_indices, col_indices.hi());
+                    return;
+                }
+            }
+
             std::vector<std::tuple<IndexType,CScalarT> > out_row;
             C.clear();
 
+            // Sort the column indices once for all of the rows
+            auto cols(prepare_extract_indices(col_indices));
+
             // Walk the rows
             IndexType out_row_index = 0;
 
-            for (auto row_it = row_begin;
-                 row_it != row_end;
+            for (auto row_it = row_indices.begin();
+                 row_it != row_indices.end();
                  ++row_it, ++out_row_index)
             {
-                auto row(A[*row_it]);
-
                 // Extract the values from the row
-                vectorExtract(out_row, row, col_begin, col_end);
+                vectorExtract(out_row, A[*row_it], cols);
 
                 if (!out_row.empty())
                     C.setRow(out_row_index, out_row);
@@ -141,22 +347,25 @@ namespace grb
         // *******************************************************************
         template<typename CScalarT,
                  typename AMatrixT,
-                 typename RowIteratorT,
-                 typename ColIteratorT>
+                 typename RowSequenceT,
+                 typename ColSequenceT>
         void matrixExtract(LilSparseMatrix<CScalarT>     &C,
                            TransposeView<AMatrixT> const &AT,
-                           RowIteratorT                   row_begin, // of AT
-                           RowIteratorT                   row_end,
-                           ColIteratorT                   col_begin, // of AT
-                           ColIteratorT                   col_end)
+                           RowSequenceT            const &row_indices, // of AT
+                           ColSequenceT            const &col_indices) // of AT
         {
             auto const &A(AT.m_mat);
             C.clear();
 
+            // Sort the row indices of AT (cols of A) once for all of the rows
+            auto rows(prepare_extract_indices(row_indices));
+            std::vector<std::tuple<IndexType,CScalarT> > out_col;
+
             // Walk the rows of A (cols of AT) and put into columns of C.
             IndexType out_row_idx = 0;
 
-            for (auto col_it = col_begin;  col_it != col_end;
+            for (auto col_it = col_indices.begin();
+                 col_it != col_indices.end();
                  ++col_it, ++out_row_idx)
             {
                 GRB_LOG_VERBOSE("matrixExtract(AT): out_row(C)=" << out_row_idx
@@ -164,136 +373,54 @@ namespace grb
 
                 // Extract the values from the rows of A (cols of AT) and place
                 // them into the *colums* of C
-                //
-                // Emplace_back version of:
-                //    vectorExtract(out_row, A[*col_it], row_begin, row_end);
+                vectorExtract(out_col, A[*col_it], rows);
 
-                IndexType out_col_idx = 0;
-                for (auto row_it = row_begin; row_it != row_end;
-                     ++row_it, ++out_col_idx)
+                for (auto&& [out_col_idx, val] : out_col)
                 {
-                    GRB_LOG_VERBOSE("matrixExtract(AT): out_col(C)=" << out_col_idx
-                                    << ", in_row(AT): " << *row_it);
-
-                    IndexType wanted_idx = *row_it;
-
-                    // Search through from the beginning of the row each to find
-                    // indices that match. This is expensive but the indices can
-                    // be duplicates and out of order.
-                    auto A_it = A[*col_it].begin();
-                    if (increment_while_below(A_it, A[*col_it].end(), wanted_idx))
-                    {
-                        GRB_LOG_VERBOSE("C["<<out_row_idx << ","
-                                        << out_col_idx << "] := "
-                                        << std::get<1>(*A_it));
-
-                        C[out_col_idx].emplace_back(
-                            out_row_idx,
-                            static_cast<CScalarT>(std::get<1>(*A_it)));
-                    }
+                    C[out_col_idx].emplace_back(out_row_idx, val);
                 }
             }
             C.recomputeNvals();
         }
 
-        /**
-         * Extract a sub matrix from A to C as specified via the row indices.
-         * This is always destructive to C.
-         * @tparam CMatrixT The type of matrix for C
-         * @tparam AMatrixT The type of matrix for A
-         * @param C Where to place the outputs
-         * @param A The input matrix.  (Won't be changed)
-         * @param row_indices A set of indices indicating which rows to extract.
-         * @param col_indices A set of indices indicating which columns to extract.
-         */
-        template<typename CMatrixT,
-                 typename AMatrixT,
-                 typename RowSequenceT,
-                 typename ColSequenceT>
-        void matrixExtract(CMatrixT                           &C,
-                           AMatrixT                   const   &A,
-                           RowSequenceT               const   &row_indices,
-                           ColSequenceT               const   &col_indices)
-        {
-            // NOTE!! Backend code. We expect that all dimension checks done elsewhere.
-
-            matrixExtract(C, A,
-                          row_indices.begin(), row_indices.end(),
-                          col_indices.begin(), col_indices.end());
-
-
-        }
-
         //********************************************************************
-        template <typename WScalarT, typename AScalarT, typename IteratorT>
+        template <typename WScalarT, typename AScalarT, typename SequenceT>
         void extractColumn(
             std::vector< std::tuple<IndexType, WScalarT> >         &vec_dest,
             LilSparseMatrix<AScalarT>                        const &A,
-            IteratorT                                               row_begin,
-            IteratorT                                               row_end,
+            SequenceT                                        const &row_indices,
             IndexType                                               col_index)
         {
             vec_dest.clear();
 
-            // Walk the rows, extracting the cell if it exists
+            // Walk the rows, binary searching for the cell in each
             IndexType out_row_index = 0;
-            for (IteratorT it = row_begin; it != row_end; ++it, ++out_row_index)
+            for (auto it = row_indices.begin(); it != row_indices.end();
+                 ++it, ++out_row_index)
             {
-                // Find the column within the row
-                for (auto&& [tmp_idx, tmp_value] : A[*it])
+                auto const &row(A[*it]);
+                auto elt = std::lower_bound(
+                    row.begin(), row.end(), col_index,
+                    [](auto const &e, IndexType idx)
+                    { return std::get<0>(e) < idx; });
+                if ((elt != row.end()) && (std::get<0>(*elt) == col_index))
                 {
-                    if (tmp_idx == col_index)
-                    {
-                        vec_dest.emplace_back(out_row_index,
-                                              static_cast<WScalarT>(tmp_value));
-                        break;
-                    }
-                    else if (tmp_idx > col_index)
-                    {
-                        break;
-                    }
+                    vec_dest.emplace_back(
+                        out_row_index, static_cast<WScalarT>(std::get<1>(*elt)));
                 }
             }
         };
 
         //********************************************************************
         // Extract a row of a TransposeView of a matrix
-        template <typename WScalarT, typename AMatrixT, typename IteratorT>
+        template <typename WScalarT, typename AMatrixT, typename SequenceT>
         void extractColumn(
             std::vector< std::tuple<IndexType, WScalarT> >        &vec_dest,
             TransposeView<AMatrixT>                         const &AT,
-            IteratorT                                              row_begin,
-            IteratorT                                              row_end,
+            SequenceT                                       const &row_indices,
             IndexType                                              col_index)
         {
-            auto const &row(AT.m_mat[col_index]);
-            vec_dest.clear();
-
-            // Walk the row, extracting the cell if it exists and is in row_indices
-
-            /// @todo Perf. can be improved for 'in order' row_indices
-            /// with "continuation"
-            IndexType out_row_index = 0;
-
-            for (IteratorT it = row_begin; it != row_end; ++it, ++out_row_index)
-            {
-                /// @todo Perf: replace this scan with a binary search
-
-                // Costly: keep rewalking same row due to duplicates
-                // and/or out of order indices
-                for (auto&& [in_row_index, in_val] : row)
-                {
-                    if (in_row_index == *it)
-                    {
-                        vec_dest.emplace_back(
-                            out_row_index, static_cast<WScalarT>(in_val));
-                    }
-                    else if (in_row_index > *it)
-                    {
-                        break;
-                    }
-                }
-            }
+            vectorExtract(vec_dest, AT.m_mat[col_index], row_indices);
         }
 
         //**********************************************************************
@@ -330,7 +457,7 @@ namespace grb
             // Extract to T
             using UScalarType =typename UVectorT::ScalarType;
             std::vector<std::tuple<IndexType, UScalarType> > t;
-            vectorExtract(t, u.getContents(),
+            vectorExtract(t, u,
                           setupIndices(indices,
                                        std::min(w.size(), u.size())));
 
@@ -446,9 +573,10 @@ namespace grb
             using AScalarType = typename AMatrixT::ScalarType;
             std::vector<std::tuple<IndexType, AScalarType>> t;
 
-            auto seq = setupIndices(row_indices,
-                                    std::min(A.nrows(), w.size()));
-            extractColumn(t, A, seq.begin(), seq.end(), col_index);
+            extractColumn(t, A,
+                          setupIndices(row_indices,
+                                       std::min(A.nrows(), w.size())),
+                          col_index);
 
             GRB_LOG_VERBOSE("t: " << t);
 
@@ -49,262 +49,119 @@ namespace grb
     namespace backend
     {
         //**********************************************************************
-        /// Implementation of 4.3.11 kronecker: Matrix kronecker product
-        //**********************************************************************
-        template<typename CMatrixT,
-                 typename MMatrixT,
-                 typename AccumT,
+        /**
+         * @brief Generate the rows of kron(A, B) in order, one at a time.
+         *
+         * Row (i_A*nrows(B) + i_B) of the product is built in a buffer
+         * sized exactly nvals(A(i_A,:)) * nvals(B(i_B,:)), its columns in
+         * sorted order, and handed to fn(row_index, row).  Empty rows are
+         * skipped.  Only one row is held at a time, so products far larger
+         * than memory can be streamed (e.g., written out as an edge list).
+         *
+         * @param[in] fn  Called as fn(IndexType, std::vector<tuple> &); the
+         *                buffer is reused for the next row unless fn moves
+         *                from it.
+         */
+        template<typename AMatrixT,
+                 typename BMatrixT,
                  typename BinaryOpT,
-                 typename AMatrixT,
-                 typename BMatrixT>
-        inline void kronecker(CMatrixT            &C,
-                              MMatrixT    const   &M,
-                              AccumT      const   &accum,
-                              BinaryOpT            op,
-                              AMatrixT    const   &A,
-                              BMatrixT    const   &B,
-                              OutputControlEnum    outp)
+                 typename RowFnT>
+        inline void kronecker_rows(AMatrixT    const &A,
+                                   BMatrixT    const &B,
+                                   BinaryOpT          op,
+                                   RowFnT             fn)
         {
-            // Dimension checks happen in front end
             IndexType nrow_A(A.nrows());
-            //IndexType ncol_A(A.ncols());
             IndexType nrow_B(B.nrows());
             IndexType ncol_B(B.ncols());
-            //Frontend checks the dimensions, but use C explicitly
-            IndexType nrow_C(C.nrows());
-            IndexType ncol_C(C.ncols());
 
-            using AScalarType = typename AMatrixT::ScalarType;
-            using BScalarType = typename BMatrixT::ScalarType;
-            using CScalarType = typename CMatrixT::ScalarType;
+            using TScalarType =
+                decltype(op(std::declval<typename AMatrixT::ScalarType>(),
+                            std::declval<typename BMatrixT::ScalarType>()));
+            std::vector<std::tuple<IndexType, TScalarType>> T_row;
 
-            // =================================================================
-            // Do the basic product work with the binaryop.
-            using TScalarType = decltype(op(std::declval<AScalarType>(),
-                                            std::declval<BScalarType>()));
-            LilSparseMatrix<TScalarType> T(nrow_C, ncol_C);
+            if ((A.nvals() == 0) || (B.nvals() == 0)) return;
 
-            if ((A.nvals() > 0) && (B.nvals() > 0))
+            for (IndexType row_idxA = 0; row_idxA < nrow_A; ++row_idxA)
             {
-                // create a row of the result at a time
-                for (IndexType row_idxA = 0; row_idxA < nrow_A; ++row_idxA)
+                auto const &A_row(A[row_idxA]);
+                if (A_row.empty()) continue;
+
+                for (IndexType row_idxB = 0; row_idxB < nrow_B; ++row_idxB)
                 {
-                    if (A[row_idxA].empty()) continue;
+                    auto const &B_row(B[row_idxB]);
+                    if (B_row.empty()) continue;
 
-                    for (IndexType row_idxB = 0; row_idxB < nrow_B; ++row_idxB)
+                    T_row.clear();
+                    T_row.reserve(A_row.size()*B_row.size());
+                    for (auto&& [col_idxA, val_A] : A_row)
                     {
-                        if (B[row_idxB].empty()) continue;
-
-                        IndexType T_row_idx(row_idxA*nrow_B + row_idxB);
-
-                        for (auto&& [col_idxA, val_A] : A[row_idxA])
+                        for (auto&& [col_idxB, val_B] : B_row)
                         {
-                            for (auto&& [col_idxB, val_B] : B[row_idxB])
-                            {
-                                TScalarType T_val(op(val_A, val_B));
-                                T[T_row_idx].emplace_back(
-                                    (col_idxA*ncol_B + col_idxB), T_val);
-                            }
+                            T_row.emplace_back(col_idxA*ncol_B + col_idxB,
+                                               op(val_A, val_B));
                         }
                     }
-                    T.recomputeNvals();
+
+                    fn(row_idxA*nrow_B + row_idxB, T_row);
                 }
             }
-
-            GRB_LOG_VERBOSE("T: " << T);
-
-            // =================================================================
-            // Accumulate into Z
-            using ZScalarType = typename std::conditional_t<
-                std::is_same_v<AccumT, NoAccumulate>,
-                TScalarType,
-                decltype(accum(std::declval<CScalarType>(),
-                               std::declval<TScalarType>()))>;
-
-            LilSparseMatrix<ZScalarType> Z(nrow_C, ncol_C);
-
-            ewise_or_opt_accum(Z, C, T, accum);
-
-            GRB_LOG_VERBOSE("Z: " << Z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace/merge
-            write_with_opt_mask(C, Z, M, outp);
-
         }
 
-        //**********************************************************************
-        /// Implementation of 4.3.11 kronecker: Matrix kronecker product
-        //**********************************************************************
-        template<typename CMatrixT,
-                 typename MMatrixT,
-                 typename AccumT,
+        /// Rows of kron(A', B), kron(A, B') and kron(A', B'): the transposed
+        /// operands are materialized (a cost linear in their size, small
+        /// next to the product) and the rows generated as above.
+        template<typename AMatrixT,
+                 typename BMatrixT,
                  typename BinaryOpT,
-                 typename AMatrixT,
-                 typename BMatrixT>
-        inline void kronecker(CMatrixT                        &C,
-                              MMatrixT                const   &M,
-                              AccumT                  const   &accum,
-                              BinaryOpT                        op,
-                              TransposeView<AMatrixT> const   &AT,
-                              BMatrixT                const   &B,
-                              OutputControlEnum                outp)
+                 typename RowFnT>
+        inline void kronecker_rows(TransposeView<AMatrixT> const &AT,
+                                   BMatrixT                const &B,
+                                   BinaryOpT                      op,
+                                   RowFnT                         fn)
         {
             auto const &A(AT.m_mat);
-
-            // Dimension checks happen in front end
-            IndexType nrow_A(A.nrows());
-            //IndexType ncol_A(A.ncols());
-            IndexType nrow_B(B.nrows());
-            IndexType ncol_B(B.ncols());
-            //Frontend checks the dimensions, but use C explicitly
-            IndexType nrow_C(C.nrows());
-            IndexType ncol_C(C.ncols());
-
-            using AScalarType = typename AMatrixT::ScalarType;
-            using BScalarType = typename BMatrixT::ScalarType;
-            using CScalarType = typename CMatrixT::ScalarType;
-
-            // =================================================================
-            // Do the basic product work with the binaryop.
-            using TScalarType = decltype(op(std::declval<AScalarType>(),
-                                            std::declval<BScalarType>()));
-            LilSparseMatrix<TScalarType> T(nrow_C, ncol_C);
-
-            if ((A.nvals() > 0) && (B.nvals() > 0))
-            {
-                // create a row of the result at a time
-                for (IndexType row_idxA = 0; row_idxA < nrow_A; ++row_idxA)
-                {
-                    if (A[row_idxA].empty()) continue;
-
-                    for (IndexType row_idxB = 0; row_idxB < nrow_B; ++row_idxB)
-                    {
-                        if (B[row_idxB].empty()) continue;
-
-                        for (auto&& [col_idxA, val_A] : A[row_idxA])
-                        {
-                            IndexType T_row_idx(col_idxA*nrow_B + row_idxB);
-
-                            for (auto&& [col_idxB, val_B] : B[row_idxB])
-                            {
-                                TScalarType T_val(op(val_A, val_B));
-                                T[T_row_idx].emplace_back(
-                                    (row_idxA*ncol_B + col_idxB), T_val);
-                            }
-                        }
-                    }
-                    T.recomputeNvals();
-                }
-            }
-
-            // =================================================================
-            // Accumulate into Z
-            using ZScalarType = typename std::conditional_t<
-                std::is_same_v<AccumT, NoAccumulate>,
-                TScalarType,
-                decltype(accum(std::declval<CScalarType>(),
-                               std::declval<TScalarType>()))>;
-
-            LilSparseMatrix<ZScalarType> Z(nrow_C, ncol_C);
-
-            ewise_or_opt_accum(Z, C, T, accum);
-
-            GRB_LOG_VERBOSE("Z: " << Z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace/merge
-            write_with_opt_mask(C, Z, M, outp);
-
+            LilSparseMatrix<typename AMatrixT::ScalarType> A_T(A.ncols(),
+                                                              A.nrows());
+            transpose_rows(A_T, A);
+            backend::kronecker_rows(A_T, B, op, fn);
         }
 
-        //**********************************************************************
-        /// Implementation of 4.3.11 kronecker: Matrix kronecker product
-        //**********************************************************************
-        template<typename CMatrixT,
-                 typename MMatrixT,
-                 typename AccumT,
+        template<typename AMatrixT,
+                 typename BMatrixT,
                  typename BinaryOpT,
-                 typename AMatrixT,
-                 typename BMatrixT>
-        inline void kronecker(CMatrixT                        &C,
-                              MMatrixT                const   &M,
-                              AccumT                  const   &accum,
-                              BinaryOpT                        op,
-                              AMatrixT                const   &A,
-                              TransposeView<BMatrixT> const   &BT,
-                              OutputControlEnum                outp)
+                 typename RowFnT>
+        inline void kronecker_rows(AMatrixT                const &A,
+                                   TransposeView<BMatrixT> const &BT,
+                                   BinaryOpT                      op,
+                                   RowFnT                         fn)
         {
             auto const &B(BT.m_mat);
+            LilSparseMatrix<typename BMatrixT::ScalarType> B_T(B.ncols(),
+                                                              B.nrows());
+            transpose_rows(B_T, B);
+            backend::kronecker_rows(A, B_T, op, fn);
+        }
 
-            // Dimension checks happen in front end
-            IndexType nrow_A(A.nrows());
-            //IndexType ncol_A(A.ncols());
-            IndexType nrow_B(B.nrows());
-            IndexType ncol_B(B.ncols());
-            //Frontend checks the dimensions, but use C explicitly
-            IndexType nrow_C(C.nrows());
-            IndexType ncol_C(C.ncols());
-
-            using AScalarType = typename AMatrixT::ScalarType;
-            using BScalarType = typename BMatrixT::ScalarType;
-            using CScalarType = typename CMatrixT::ScalarType;
-
-            // =================================================================
-            // Do the basic product work with the binaryop.
-            using TScalarType = decltype(op(std::declval<AScalarType>(),
-                                            std::declval<BScalarType>()));
-            LilSparseMatrix<TScalarType> T(nrow_C, ncol_C);
-
-            if ((A.nvals() > 0) && (B.nvals() > 0))
-            {
-                // create a row of the result at a time
-                for (IndexType row_idxA = 0; row_idxA < nrow_A; ++row_idxA)
-                {
-                    if (A[row_idxA].empty()) continue;
-
-                    for (auto&& [col_idxA, val_A] : A[row_idxA])
-                    {
-                        for (IndexType row_idxB = 0; row_idxB < nrow_B; ++row_idxB)
-                        {
-                            if (B[row_idxB].empty()) continue;
-
-                            IndexType T_col_idx(col_idxA*nrow_B + row_idxB);
-
-                            for (auto&& [col_idxB, val_B] : B[row_idxB])
-                            {
-                                TScalarType T_val(op(val_A, val_B));
-                                IndexType T_row_idx(row_idxA*ncol_B + col_idxB);
-                                T[T_row_idx].emplace_back(T_col_idx, T_val);
-                            }
-                        }
-                    }
-                    T.recomputeNvals();
-                }
-            }
-
-            // =================================================================
-            // Accumulate into Z
-            using ZScalarType = typename std::conditional_t<
-                std::is_same_v<AccumT, NoAccumulate>,
-                TScalarType,
-                decltype(accum(std::declval<CScalarType>(),
-                               std::declval<TScalarType>()))>;
-
-            LilSparseMatrix<ZScalarType> Z(nrow_C, ncol_C);
-
-            ewise_or_opt_accum(Z, C, T, accum);
-
-            GRB_LOG_VERBOSE("Z: " << Z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace/merge
-            write_with_opt_mask(C, Z, M, outp);
-
+        template<typename AMatrixT,
+                 typename BMatrixT,
+                 typename BinaryOpT,
+                 typename RowFnT>
+        inline void kronecker_rows(TransposeView<AMatrixT> const &AT,
+                                   TransposeView<BMatrixT> const &BT,
+                                   BinaryOpT                      op,
+                                   RowFnT                         fn)
+        {
+            auto const &B(BT.m_mat);
+            LilSparseMatrix<typename BMatrixT::ScalarType> B_T(B.ncols(),
+                                                              B.nrows());
+            transpose_rows(B_T, B);
+            backend::kronecker_rows(AT, B_T, op, fn);
         }
 
         //**********************************************************************
         /// Implementation of 4.3.11 kronecker: Matrix kronecker product
+        /// (all transpose combinations of A and B)
         //**********************************************************************
         template<typename CMatrixT,
                  typename MMatrixT,
@@ -312,60 +169,42 @@ namespace grb
                  typename BinaryOpT,
                  typename AMatrixT,
                  typename BMatrixT>
-        inline void kronecker(CMatrixT                        &C,
-                              MMatrixT                const   &M,
-                              AccumT                  const   &accum,
-                              BinaryOpT                        op,
-                              TransposeView<AMatrixT> const   &AT,
-                              TransposeView<BMatrixT> const   &BT,
-                              OutputControlEnum                outp)
+        inline void kronecker(CMatrixT            &C,
+                              MMatrixT    const   &M,
+                              AccumT      const   &accum,
+                              BinaryOpT            op,
+                              AMatrixT    const   &A,
+                              BMatrixT    const   &B,
+                              OutputControlEnum    outp)
         {
-            auto const &A(AT.m_mat);
-            auto const &B(BT.m_mat);
-
-            // Dimension checks happen in front end
-            IndexType nrow_A(A.nrows());
-            //IndexType ncol_A(A.ncols());
-            IndexType nrow_B(B.nrows());
-            IndexType ncol_B(B.ncols());
             //Frontend checks the dimensions, but use C explicitly
             IndexType nrow_C(C.nrows());
             IndexType ncol_C(C.ncols());
 
-            using AScalarType = typename AMatrixT::ScalarType;
-            using BScalarType = typename BMatrixT::ScalarType;
             using CScalarType = typename CMatrixT::ScalarType;
 
             // =================================================================
-            // Do the basic product work with the binaryop.
-            using TScalarType = decltype(op(std::declval<AScalarType>(),
-                                            std::declval<BScalarType>()));
+            // Do the basic product work with the binaryop, moving each
+            // (exactly sized) row into T.
+            using TScalarType = decltype(
+                op(std::declval<typename AMatrixT::ScalarType>(),
+                   std::declval<typename BMatrixT::ScalarType>()));
             LilSparseMatrix<TScalarType> T(nrow_C, ncol_C);
 
-            if ((A.nvals() > 0) && (B.nvals() > 0))
-            {
-                // create a row of the result at a time
-                for (IndexType row_idxA = 0; row_idxA < nrow_A; ++row_idxA)
-                {
-                    if (A[row_idxA].empty()) continue;
+            backend::kronecker_rows(A, B, op,
+                                    [&T](IndexType row_idx, auto &T_row)
+                                    { T[row_idx] = std::move(T_row); });
+            T.recomputeNvals();
 
-                    for (IndexType row_idxB = 0; row_idxB < nrow_B; ++row_idxB)
-                    {
-                        if (B[row_idxB].empty()) continue;
-                        IndexType T_col_idx(row_idxA*nrow_B + row_idxB);
+            GRB_LOG_VERBOSE("T: " << T);
 
-                        for (auto&& [col_idxA, val_A] : A[row_idxA])
-                        {
-                            for (auto&& [col_idxB, val_B] : B[row_idxB])
-                            {
-                                TScalarType T_val(op(val_A, val_B));
-                                IndexType T_row_idx(col_idxA*ncol_B + col_idxB);
-                                T[T_row_idx].emplace_back(T_col_idx, T_val);
-                            }
-                        }
-                    }
-                    T.recomputeNvals();
-                }
+            // Without a mask or accumulator T is the answer
+            if constexpr (std::is_same_v<MMatrixT, NoMask> &&
+                          std::is_same_v<AccumT, NoAccumulate> &&
+                          std::is_same_v<CMatrixT, decltype(T)>)
+            {
+                C.swap(T);
+                return;
             }
 
             // =================================================================
@@ -385,8 +224,6 @@ namespace grb
             // =================================================================
             // Copy Z into the final output considering mask and replace/merge
             write_with_opt_mask(C, Z, M, outp);
-
         }
-
     } // backend
 } // grb
@@ -48,6 +48,44 @@ namespace grb
 {
     namespace backend
     {
+        //**********************************************************************
+        /// T = A +.* B one row at a time, skipping the rows of T that the
+        /// mask excludes.  Each row is gathered in a SparseAccumulator and
+        /// written once in column order.
+        template<typename TMatrixT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void AB_rows(TMatrixT            &T,
+                            MMatrixT    const   &M,
+                            SemiringT            op,
+                            AMatrixT    const   &A,
+                            BMatrixT    const   &B)
+        {
+            using TScalarType = typename TMatrixT::ScalarType;
+            SparseAccumulator<TScalarType> T_acc(B.ncols());
+
+            for (IndexType i = 0; i < A.nrows(); ++i)
+            {
+                // rows the mask excludes entirely are never written
+                if (mask_excludes_row(M, i)) continue;
+
+                for (auto&& [k, a_ik] : A[i])
+                {
+                    if (B[k].empty()) continue;
+
+                    // T[i] += (a_ik*B[k])  // must reduce in D3
+                    T_acc.axpy(op, a_ik, B[k]);
+                }
+
+                if (!T_acc.empty())
+                {
+                    T_acc.write_into(T[i]);
+                }
+            }
+        }
+
         //**********************************************************************
         /// Implementation of 4.3.1 mxm: Matrix-matrix multiply: A +.* B
         //**********************************************************************
@@ -73,19 +111,7 @@ namespace grb
             // Do the axpy work with the semiring.
             using TScalarType = typename SemiringT::result_type;
             LilSparseMatrix<TScalarType> T(C.nrows(), C.ncols());
-
-            typename LilSparseMatrix<TScalarType>::RowType T_row;
-
-            for (IndexType i = 0; i < A.nrows(); ++i)
-            {
-                for (auto&& [k, a_ik] : A[i])
-                {
-                    if (B[k].empty()) continue;
-
-                    // T[i] += (a_ik*B[k])  // must reduce in D3
-                    axpy(T[i], op, a_ik, B[k]);
-                }
-            }
+            AB_rows(T, M, op, A, B);
 
             GRB_LOG_VERBOSE("T: " << T);
 
@@ -135,16 +161,11 @@ namespace grb
             using TScalarType = typename SemiringT::result_type;
             LilSparseMatrix<TScalarType> T(C.nrows(), C.ncols());
 
-            for (IndexType k = 0; k < A.nrows(); ++k)
-            {
-                if (A[k].empty() || B[k].empty()) continue;
-
-                for (auto&& [i, a_ki] : A[k])
-                {
-                    // T[i] += (a_ki*B[k])  // must reduce in D3, hence T.
-                    axpy(T[i], op, a_ki, B[k]);
-                }
-            }
+            // T = (A')B row by row, from an explicit transpose of A
+            using AScalarType = typename AMatrixT::ScalarType;
+            LilSparseMatrix<AScalarType> A_T(A.ncols(), A.nrows());
+            transpose_rows(A_T, A);
+            AB_rows(T, M, op, A_T, B);
 
             GRB_LOG_VERBOSE("T: " << T);
 
@@ -271,19 +292,21 @@ namespace grb
             using TScalarType = typename SemiringT::result_type;
             LilSparseMatrix<TScalarType> T(C.nrows(), C.ncols());
             typename LilSparseMatrix<TScalarType>::RowType T_row;
+            SparseAccumulator<TScalarType> T_acc(A.ncols());
 
             // compute transpose T = B +.* A (one row at a time and transpose)
             for (IndexType i = 0; i < B.nrows(); ++i)
             {
-                // this part is same as sparse_mxm_NoMask_NoAccum_AB
+                // this part is same as AB_rows
                 T_row.clear();
                 for (auto&& [k, b_ik] : B[i])
                 {
                     if (A[k].empty()) continue;
 
                     // T[i] += (b_ik*A[k])  // must reduce in D3
-                    axpy(T_row, op, b_ik, A[k]);
+                    T_acc.axpy(op, b_ik, A[k]);
                 }
+                T_acc.write_into(T_row);
 
                 //C.setCol(i, T_row); // this is a push_back form of setCol
                 for (auto const &t : T_row)
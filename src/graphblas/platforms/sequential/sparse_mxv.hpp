@@ -62,6 +62,23 @@ namespace grb
         {
             GRB_LOG_VERBOSE("w<M,z> := A +.* u");
 
+            // Boolean vectors with the logical semiring use short circuit dots
+            if constexpr (std::is_same_v<typename WVectorT::ScalarType, bool> &&
+                          std::is_same_v<typename UVectorT::ScalarType, bool> &&
+                          is_logical_semiring_v<SemiringT> &&
+                          is_word_accum_v<AccumT>)
+            {
+                PackedBitmap t_bitmap(w.size()), t_vals(w.size());
+                if ((A.nvals() > 0) && (u.nvals() > 0))
+                {
+                    logical_dot_bitmap(t_bitmap, t_vals, A, u);
+                }
+
+                ewise_or_opt_accum_bitmap(t_bitmap, t_vals, w, accum);
+                write_bitmap_with_opt_mask_1D(w, t_bitmap, t_vals, mask, outp);
+                return;
+            }
+
             // =================================================================
             // Do the basic dot-product work with the semi-ring.
             using TScalarType = typename SemiringT::result_type;
@@ -69,21 +86,16 @@ namespace grb
 
             if ((A.nvals() > 0) && (u.nvals() > 0))
             {
-                auto u_contents(u.getContents());
                 for (IndexType row_idx = 0; row_idx < w.size(); ++row_idx)
                 {
-                    if (!A[row_idx].empty())
+                    // Rows outside the mask never reach w, skip their dots
+                    if (!A[row_idx].empty() && check_mask_1D(mask, row_idx))
                     {
                         TScalarType t_val;
-                        /// @note In mxv_timing_test, if I reverse u_contents and
-                        /// A[row_idx], the performance improves by a factor of 2.
-                        /// But I cannot reorder in case op is not commutative.
-                        ///
-                        /// I have added dot_rev() helper that reverses the two
-                        /// vectors but keeps the order correct for op.
-                        ///
-                        /// I suspect this is strictly data dependent performance
-                        if (dot_rev(t_val, A[row_idx], u_contents, op))
+                        /// @note The row drives the dot product and u is
+                        /// probed through its bitmap, so u's contents are
+                        /// never copied and each row costs O(row length).
+                        if (dot2_rev(t_val, A[row_idx], u, op))
                         {
                             t.emplace_back(row_idx, t_val);
                         }
@@ -131,6 +143,23 @@ namespace grb
             GRB_LOG_VERBOSE("w<M,z> := A' +.* u");
             auto const &A(AT.m_mat);
 
+            // Boolean vectors with the logical semiring use a bitmap scatter
+            if constexpr (std::is_same_v<typename WVectorT::ScalarType, bool> &&
+                          std::is_same_v<typename UVectorT::ScalarType, bool> &&
+                          is_logical_semiring_v<SemiringT> &&
+                          is_word_accum_v<AccumT>)
+            {
+                PackedBitmap t_bitmap(w.size()), t_vals(w.size());
+                if ((A.nvals() > 0) && (u.nvals() > 0))
+                {
+                    logical_axpy_bitmap(t_bitmap, t_vals, u, A);
+                }
+
+                ewise_or_opt_accum_bitmap(t_bitmap, t_vals, w, accum);
+                write_bitmap_with_opt_mask_1D(w, t_bitmap, t_vals, mask, outp);
+                return;
+            }
+
             // =================================================================
             // Use axpy approach with the semi-ring.
             using TScalarType = typename SemiringT::result_type;
@@ -138,11 +167,26 @@ namespace grb
 
             if ((A.nvals() > 0) && (u.nvals() > 0))
             {
-                for (IndexType row_idx = 0; row_idx < u.size(); ++row_idx)
+                // Known arithmetic semirings fold into a dense accumulator
+                // when enough of the result is going to be touched
+                bool dense(false);
+                if constexpr (is_arithmetic_kernel_v<SemiringT>)
                 {
-                    if (u.hasElement(row_idx) && !A[row_idx].empty())
+                    if (dense_axpy_pays_off(u, A))
                     {
-                        axpy(t, op, u.extractElement(row_idx), A[row_idx]);
+                        dense_axpy(t, op, u, A);
+                        dense = true;
+                    }
+                }
+
+                if (!dense)
+                {
+                    for (auto&& [row_idx, u_val] : u.nonzeros())
+                    {
+                        if (!A[row_idx].empty())
+                        {
+                            axpy(t, op, u_val, A[row_idx]);
+                        }
                     }
                 }
             }
@@ -0,0 +1,225 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * DM20-0442
+ */
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/algebra.hpp>
+
+#include "sparse_helpers.hpp"
+#include "LilSparseMatrix.hpp"
+
+//******************************************************************************
+
+namespace grb
+{
+    namespace backend
+    {
+        //**********************************************************************
+        // Implementation of Vector variant of Select: w<m,z> := u(op(u,i,0,k))
+        template<typename WScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename IndexUnaryOpT,
+                 typename UVectorT,
+                 typename ValueT,
+                 typename ...WTagsT>
+        inline void select(
+            grb::backend::Vector<WScalarT, WTagsT...>       &w,
+            MaskT                                     const &mask,
+            AccumT                                    const &accum,
+            IndexUnaryOpT                                    op,
+            UVectorT                                  const &u,
+            ValueT                                    const &thunk,
+            OutputControlEnum                                outp)
+        {
+            GRB_LOG_VERBOSE("w<m,z> := select(op, u, thunk)");
+            // =================================================================
+            // Keep the elements of u that satisfy the predicate in t.
+            using UScalarType = typename UVectorT::ScalarType;
+            std::vector<std::tuple<IndexType,UScalarType> > t_contents;
+
+            if (u.nvals() > 0)
+            {
+                for (auto&& [idx, val] : u.nonzeros())
+                {
+                    if (op(val, idx, 0, thunk))
+                    {
+                        t_contents.emplace_back(idx, val);
+                    }
+                }
+            }
+
+            GRB_LOG_VERBOSE("t: " << t_contents);
+
+            // =================================================================
+            // Accumulate into Z
+            using ZScalarType = std::conditional_t<
+                std::is_same_v<AccumT, NoAccumulate>,
+                UScalarType,
+                decltype(accum(std::declval<WScalarT>(),
+                               std::declval<UScalarType>()))>;
+
+            std::vector<std::tuple<IndexType,ZScalarType> > z_contents;
+            ewise_or_opt_accum_1D(z_contents, w, t_contents, accum);
+
+            GRB_LOG_VERBOSE("z: " << z_contents);
+
+            // =================================================================
+            // Copy Z into the final output considering mask and replace/merge
+            write_with_opt_mask_1D(w, z_contents, mask, outp);
+        }
+
+        //**********************************************************************
+        // Implementation of Matrix variant of Select: C<M,z> := A(op(A,i,j,k))
+        template<typename CScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename IndexUnaryOpT,
+                 typename AMatrixT,
+                 typename ValueT,
+                 typename ...CTagsT>
+        inline void select(
+            grb::backend::Matrix<CScalarT, CTagsT...>       &C,
+            MaskT                                     const &Mask,
+            AccumT                                    const &accum,
+            IndexUnaryOpT                                    op,
+            AMatrixT                                  const &A,
+            ValueT                                    const &thunk,
+            OutputControlEnum                                outp)
+        {
+            GRB_LOG_VERBOSE("C<M,z> := select(op, A, thunk)");
+            IndexType nrows(A.nrows());
+            IndexType ncols(A.ncols());
+
+            // =================================================================
+            // Keep the elements of A that satisfy the predicate in T: one
+            // streaming pass over each row.
+            using AScalarType = typename AMatrixT::ScalarType;
+            LilSparseMatrix<AScalarType> T(nrows, ncols);
+
+            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            {
+                auto &t_row(T[row_idx]);
+                for (auto&& [a_idx, a_val] : A[row_idx])
+                {
+                    if (op(a_val, row_idx, a_idx, thunk))
+                    {
+                        t_row.emplace_back(a_idx, a_val);
+                    }
+                }
+            }
+            T.recomputeNvals();
+
+            GRB_LOG_VERBOSE("T: " << T);
+
+            // =================================================================
+            // Accumulate T via C into Z
+            using ZScalarType = std::conditional_t<
+                std::is_same_v<AccumT, NoAccumulate>,
+                AScalarType,
+                decltype(accum(std::declval<CScalarT>(),
+                               std::declval<AScalarType>()))>;
+
+            LilSparseMatrix<ZScalarType> Z(nrows, ncols);
+            ewise_or_opt_accum(Z, C, T, accum);
+
+            GRB_LOG_VERBOSE("Z: " << Z);
+
+            // =================================================================
+            // Copy Z into the final output considering mask and replace/merge
+            write_with_opt_mask(C, Z, Mask, outp);
+        }
+
+        //**********************************************************************
+        // Implementation of Matrix variant of Select: C<M,z> := A'(op(A',i,j,k))
+        template<typename CScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename IndexUnaryOpT,
+                 typename AMatrixT,
+                 typename ValueT,
+                 typename ...CTagsT>
+        inline void select(
+            grb::backend::Matrix<CScalarT, CTagsT...>       &C,
+            MaskT                                     const &Mask,
+            AccumT                                    const &accum,
+            IndexUnaryOpT                                    op,
+            TransposeView<AMatrixT>                   const &AT,
+            ValueT                                    const &thunk,
+            OutputControlEnum                                outp)
+        {
+            GRB_LOG_VERBOSE("C<M,z> := select(op, A', thunk)");
+            auto const &A(AT.m_mat);
+            IndexType nrows(A.nrows());
+            IndexType ncols(A.ncols());
+
+            // =================================================================
+            // Keep the elements of A' that satisfy the predicate in T.
+            using AScalarType = typename AMatrixT::ScalarType;
+            LilSparseMatrix<AScalarType> T(ncols, nrows);
+
+            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            {
+                for (auto&& [a_idx, a_val] : A[row_idx])
+                {
+                    // idx's swapped: A(row_idx, a_idx) is A'(a_idx, row_idx)
+                    if (op(a_val, a_idx, row_idx, thunk))
+                    {
+                        T[a_idx].emplace_back(row_idx, a_val);
+                    }
+                }
+            }
+            T.recomputeNvals();
+
+            GRB_LOG_VERBOSE("T: " << T);
+
+            // =================================================================
+            // Accumulate T via C into Z
+            using ZScalarType = std::conditional_t<
+                std::is_same_v<AccumT, NoAccumulate>,
+                AScalarType,
+                decltype(accum(std::declval<CScalarT>(),
+                               std::declval<AScalarType>()))>;
+
+            LilSparseMatrix<ZScalarType> Z(ncols, nrows);
+            ewise_or_opt_accum(Z, C, T, accum);
+
+            GRB_LOG_VERBOSE("Z: " << Z);
+
+            // =================================================================
+            // Copy Z into the final output considering mask and replace/merge
+            write_with_opt_mask(C, Z, Mask, outp);
+        }
+    }
+}
@@ -64,17 +64,18 @@ namespace grb
             // =================================================================
             // Transpose A into T.
             LilSparseMatrix<typename AMatrixT::ScalarType> T(ncols, nrows);
-            if (A.nvals() > 0)
+            transpose_rows(T, A);
+
+            // Without a mask or accumulator T is the answer (this also covers
+            // C aliasing A).
+            if constexpr (std::is_same_v<MaskT, NoMask> &&
+                          std::is_same_v<AccumT, NoAccumulate> &&
+                          std::is_same_v<CMatrixT, decltype(T)>)
             {
-                for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
-                {
-                    for (auto && [col_idx, val] : A[row_idx])
-                    {
-                        T[col_idx].emplace_back(row_idx, val);
-                    }
-                }
-                T.recomputeNvals();
+                C.swap(T);
+                return;
             }
+
             // =================================================================
             // Accumulate T via C into Z
             using ZScalarType = typename std::conditional_t<
@@ -215,4 +215,179 @@ BOOST_AUTO_TEST_CASE(test_mxv_sparse_nomask_noaccum)
     w.printInfo(std::cerr);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_packed_bitmap)
+{
+    grb::backend::PackedBitmap bits(130);
+    BOOST_CHECK_EQUAL(bits.count(), 0);
+    BOOST_CHECK_EQUAL(bits.find_next(0), 130);
+
+    bits.set(0); bits.set(63); bits.set(64); bits.set(129);
+    BOOST_CHECK_EQUAL(bits.count(), 4);
+    BOOST_CHECK_EQUAL(bits.count(1, 65), 2);
+    BOOST_CHECK_EQUAL(bits.find_next(1), 63);
+    BOOST_CHECK_EQUAL(bits.find_next(65), 129);
+    BOOST_CHECK(bits[64]);
+    BOOST_CHECK(!bits[65]);
+
+    bits.flip();
+    BOOST_CHECK_EQUAL(bits.count(), 126);
+
+    bits.resize(70);
+    BOOST_CHECK_EQUAL(bits.count(), 67);
+    bits.resize(200, true);
+    BOOST_CHECK_EQUAL(bits.count(), 197);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_bool_vector_packed_storage)
+{
+    grb::IndexType const N = 100;
+    grb::backend::BitmapSparseVector<bool> v(N);
+    v.setElement(3, true);
+    v.setElement(70, false);
+    v.setElement(99, true);
+
+    BOOST_CHECK_EQUAL(v.nvals(), 3);
+    BOOST_CHECK_EQUAL(v.extractElement(3), true);
+    BOOST_CHECK_EQUAL(v.extractElement(70), false);
+
+    std::vector<std::tuple<grb::IndexType, bool>> ans = {
+        {3, true}, {70, false}, {99, true}};
+    BOOST_CHECK(v.getContents() == ans);
+
+    v.removeElement(3);
+    BOOST_CHECK_EQUAL(v.nvals(), 2);
+    BOOST_CHECK(!v.hasElement(3));
+
+    v.resize(50);
+    BOOST_CHECK_EQUAL(v.nvals(), 0);
+}
+
+//****************************************************************************
+// The word-parallel boolean kernels must agree with the generic kernels
+// (exercised here through an int output vector).
+BOOST_AUTO_TEST_CASE(test_bool_word_kernels_match_generic)
+{
+    grb::IndexType const N = 150;
+    std::vector<grb::IndexType> ui, vi, mi, wi;
+    std::vector<bool> uv, vv, mv, wv;
+    for (grb::IndexType i = 0; i < N; ++i)
+    {
+        if (i % 3 == 0) { ui.push_back(i); uv.push_back(i % 2 == 0); }
+        if (i % 5 != 1) { vi.push_back(i); vv.push_back(i % 7 < 4); }
+        if (i % 4 != 3) { mi.push_back(i); mv.push_back(i % 11 < 6); }
+        if (i % 6 == 2) { wi.push_back(i); wv.push_back(i % 9 < 3); }
+    }
+
+    grb::Vector<bool> u(N), v(N), m(N), w(N);
+    u.build(ui, uv);
+    v.build(vi, vv);
+    m.build(mi, mv);
+    w.build(wi, wv);
+
+    grb::Matrix<bool> A(N, N);
+    std::vector<grb::IndexType> ai, aj;
+    std::vector<bool> av;
+    for (grb::IndexType i = 0; i < N; ++i)
+    {
+        for (grb::IndexType j = i % 13; j < N; j += 17)
+        {
+            ai.push_back(i); aj.push_back(j); av.push_back((i + j) % 5 != 0);
+        }
+    }
+    A.build(ai, aj, av);
+
+    grb::Vector<int> ref_init(N);
+    ref_init.build(wi, std::vector<int>(wv.begin(), wv.end()));
+
+    auto check = [&](grb::Vector<bool> const &fast, grb::Vector<int> const &ref)
+    {
+        BOOST_CHECK_EQUAL(fast.nvals(), ref.nvals());
+        for (grb::IndexType i = 0; i < N; ++i)
+        {
+            BOOST_CHECK_EQUAL(fast.hasElement(i), ref.hasElement(i));
+            if (fast.hasElement(i) && ref.hasElement(i))
+            {
+                BOOST_CHECK_EQUAL(fast.extractElement(i),
+                                  static_cast<bool>(ref.extractElement(i)));
+            }
+        }
+    };
+
+    {
+        grb::Vector<bool> fast(w);
+        grb::Vector<int>  ref(ref_init);
+        grb::eWiseAdd(fast, grb::complement(m), grb::LogicalOr<bool>(),
+                      grb::LogicalAnd<bool>(), u, v, grb::REPLACE);
+        grb::eWiseAdd(ref, grb::complement(m), grb::LogicalOr<bool>(),
+                      grb::LogicalAnd<bool>(), u, v, grb::REPLACE);
+        check(fast, ref);
+    }
+    {
+        grb::Vector<bool> fast(w);
+        grb::Vector<int>  ref(ref_init);
+        grb::eWiseMult(fast, grb::structure(m), grb::NoAccumulate(),
+                       grb::LogicalXor<bool>(), u, v, grb::MERGE);
+        grb::eWiseMult(ref, grb::structure(m), grb::NoAccumulate(),
+                       grb::LogicalXor<bool>(), u, v, grb::MERGE);
+        check(fast, ref);
+    }
+    {
+        grb::Vector<bool> fast(w);
+        grb::Vector<int>  ref(ref_init);
+        grb::vxm(fast, m, grb::LogicalAnd<bool>(),
+                 grb::LogicalSemiring<bool>(), v, A, grb::MERGE);
+        grb::vxm(ref, m, grb::LogicalAnd<bool>(),
+                 grb::LogicalSemiring<bool>(), v, A, grb::MERGE);
+        check(fast, ref);
+    }
+    {
+        grb::Vector<bool> fast(w);
+        grb::Vector<int>  ref(ref_init);
+        grb::mxv(fast, grb::NoMask(), grb::NoAccumulate(),
+                 grb::LogicalSemiring<bool>(), A, v);
+        grb::mxv(ref, grb::NoMask(), grb::NoAccumulate(),
+                 grb::LogicalSemiring<bool>(), A, v);
+        check(fast, ref);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_sorted_indices_and_nonzeros)
+{
+    grb::backend::BitmapSparseVector<double> v(200);
+    v.setElement(5, 1.5);
+    v.setElement(70, 2.5);
+    v.setElement(199, 3.5);
+
+    grb::IndexArrayType ans_idx = {5, 70, 199};
+    BOOST_CHECK(v.getIndices() == ans_idx);
+
+    // out of order insert and interior removal
+    v.setElement(64, 4.5);
+    v.removeElement(70);
+    ans_idx = {5, 64, 199};
+    BOOST_CHECK(v.getIndices() == ans_idx);
+
+    // removal from the end
+    v.removeElement(199);
+    ans_idx = {5, 64};
+    BOOST_CHECK(v.getIndices() == ans_idx);
+
+    std::vector<std::tuple<grb::IndexType, double>> ans = {{5, 1.5}, {64, 4.5}};
+    std::vector<std::tuple<grb::IndexType, double>> visited;
+    for (auto&& [idx, val] : v.nonzeros())
+    {
+        visited.emplace_back(idx, val);
+    }
+    BOOST_CHECK(visited == ans);
+    BOOST_CHECK_EQUAL(v.nonzeros().size(), v.nvals());
+
+    v.clear();
+    BOOST_CHECK(v.nonzeros().empty());
+    BOOST_CHECK_EQUAL(v.nvals(), 0);
+    BOOST_CHECK(!v.hasElement(5));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -323,4 +323,146 @@ BOOST_AUTO_TEST_CASE(lil_test_get_set_row)
     }
 }
 
+//****************************************************************************
+// Interleaved single element updates (pending tuples and zombies) checked
+// against a simple reference
+BOOST_AUTO_TEST_CASE(lil_test_pending_updates)
+{
+    IndexType const NROWS = 5;
+    IndexType const NCOLS = 300;
+    backend::LilSparseMatrix<int> m(NROWS, NCOLS);
+    std::vector<std::vector<int>> ref(NROWS, std::vector<int>(NCOLS, -1));
+
+    IndexType nvals(0);
+    unsigned int seed = 17;
+    for (int iter = 0; iter < 4000; ++iter)
+    {
+        seed = seed*1103515245u + 12345u;
+        IndexType row((seed >> 8) % NROWS);
+        IndexType col((seed >> 12) % NCOLS);
+        int val(static_cast<int>((seed >> 20) % 100));
+
+        if ((seed >> 28) % 3 == 0)
+        {
+            m.removeElement(row, col);
+            if (ref[row][col] >= 0) --nvals;
+            ref[row][col] = -1;
+        }
+        else
+        {
+            m.setElement(row, col, val, grb::Plus<int>());
+            if (ref[row][col] >= 0)
+            {
+                ref[row][col] += val;
+            }
+            else
+            {
+                ref[row][col] = val;
+                ++nvals;
+            }
+        }
+
+        BOOST_CHECK_EQUAL(m.nvals(), nvals);
+        BOOST_CHECK_EQUAL(m.hasElement(row, col), (ref[row][col] >= 0));
+        if (ref[row][col] >= 0)
+        {
+            BOOST_CHECK_EQUAL(m.extractElement(row, col), ref[row][col]);
+        }
+
+        // Occasionally force a read of an assembled row
+        if (iter % 500 == 0)
+        {
+            auto const &row_data(static_cast<backend::LilSparseMatrix<int> const &>(m)[row]);
+            IndexType cnt(0);
+            for (IndexType ix = 0; ix < row_data.size(); ++ix)
+            {
+                if (ix > 0)
+                {
+                    BOOST_CHECK_LT(std::get<0>(row_data[ix - 1]),
+                                   std::get<0>(row_data[ix]));
+                }
+                BOOST_CHECK_EQUAL(std::get<1>(row_data[ix]),
+                                  ref[row][std::get<0>(row_data[ix])]);
+                ++cnt;
+            }
+            IndexType ref_cnt(0);
+            for (auto v : ref[row]) if (v >= 0) ++ref_cnt;
+            BOOST_CHECK_EQUAL(cnt, ref_cnt);
+        }
+    }
+
+    m.wait();
+    m.recomputeNvals();
+    BOOST_CHECK_EQUAL(m.nvals(), nvals);
+    for (IndexType row = 0; row < NROWS; ++row)
+    {
+        for (IndexType col = 0; col < NCOLS; ++col)
+        {
+            BOOST_CHECK_EQUAL(m.hasElement(row, col), (ref[row][col] >= 0));
+        }
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(lil_test_packed_mask)
+{
+    // 4 x 200: row 0 is dense (every other column, stored true), row 1 has
+    // two trues and a stored false, row 2 is empty, row 3 is full.
+    IndexType const NCOLS(200);
+    backend::LilSparseMatrix<bool> m(4, NCOLS);
+    for (IndexType col = 0; col < NCOLS; col += 2) m.setElement(0, col, true);
+    m.setElement(1, 5, true);
+    m.setElement(1, 9, false);
+    m.setElement(1, 150, true);
+    for (IndexType col = 0; col < NCOLS; ++col) m.setElement(3, col, true);
+
+    auto value(m.packedMask(false));
+    auto structure(m.packedMask(true));
+    BOOST_CHECK(value == m.packedMask(false));     // cached
+
+    BOOST_CHECK(value->is_dense(0));
+    BOOST_CHECK(!value->is_dense(1));
+    BOOST_CHECK(!value->is_dense(2));
+    BOOST_CHECK(value->is_dense(3));
+    BOOST_CHECK_EQUAL(value->count(0), NCOLS/2);
+    BOOST_CHECK_EQUAL(value->count(1), 2);
+    BOOST_CHECK_EQUAL(structure->count(1), 3);
+    BOOST_CHECK_EQUAL(value->count(2), 0);
+
+    // never larger than one word per admitted column or per 64 columns
+    BOOST_CHECK_EQUAL(value->num_words(), 4 + 2 + 0 + 4);
+
+    for (bool complement : {false, true})
+    {
+        for (IndexType row = 0; row < 4; ++row)
+        {
+            backend::MaskRow v_row(*value, row, complement);
+            backend::MaskRow s_row(*structure, row, complement);
+            for (IndexType col = 0; col < NCOLS; ++col)
+            {
+                bool stored(m.hasElement(row, col));
+                bool val(stored && m.extractElement(row, col));
+                BOOST_CHECK_EQUAL(v_row.admits(col), val != complement);
+                BOOST_CHECK_EQUAL(s_row.admits(col), stored != complement);
+            }
+        }
+    }
+    BOOST_CHECK(backend::MaskRow(*value, 2, false).admits_none());
+    BOOST_CHECK(backend::MaskRow(*value, 2, true).admits_all());
+    BOOST_CHECK(backend::MaskRow(*value, 3, false).admits_all());
+    BOOST_CHECK(backend::MaskRow(*value, 3, true).admits_none());
+
+    // a value-only change drops the value mask; the old rows stay valid
+    m.setElement(1, 9, true);
+    auto value2(m.packedMask(false));
+    BOOST_CHECK(value2 != value);
+    BOOST_CHECK_EQUAL(value2->count(1), 3);
+    BOOST_CHECK_EQUAL(value->count(1), 2);
+
+    // a structural change drops both
+    m.removeElement(3, 0);
+    BOOST_CHECK(m.packedMask(true) != structure);
+    BOOST_CHECK_EQUAL(m.packedMask(true)->count(3), NCOLS - 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,195 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party Software
+ * subject to its own license:
+ *
+ * 1. Boost Unit Test Framework
+ * (https://www.boost.org/doc/libs/1_45_0/libs/test/doc/html/utf.html)
+ * Copyright 2001 Boost software license, Gennadiy Rozental.
+ *
+ * DM20-0442
+ */
+
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace grb;
+using namespace grb::backend;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE row_partition_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    // 12 x 12: row 3 is a hub with every column stored, the rest hold one
+    // value each (on the diagonal) except row 7, which is empty.
+    std::vector<std::vector<double>> hub_dense()
+    {
+        std::vector<std::vector<double>> dense(12, std::vector<double>(12, 0));
+        for (IndexType i = 0; i < 12; ++i)
+        {
+            if (i != 7) dense[i][i] = 1;
+            dense[3][i] = i + 1;
+        }
+        return dense;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(partition_row_nnz_prefix)
+{
+    LilSparseMatrix<double> const A(hub_dense(), 0.);
+    auto prefix(row_nnz_prefix(A));
+
+    BOOST_REQUIRE_EQUAL(prefix.size(), 13);
+    BOOST_CHECK_EQUAL(prefix[0], 0);
+    BOOST_CHECK_EQUAL(prefix[3], 3);
+    BOOST_CHECK_EQUAL(prefix[4], 15);
+    BOOST_CHECK_EQUAL(prefix[12], A.nvals());
+
+    // Columns of A are rows of A': column 3 holds two values
+    auto prefix_T(row_nnz_prefix(TransposeView(A)));
+    BOOST_CHECK_EQUAL(prefix_T[12], A.nvals());
+    BOOST_CHECK_EQUAL(prefix_T[4] - prefix_T[3], 1);
+    BOOST_CHECK_EQUAL(prefix_T[1] - prefix_T[0], 2);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(partition_row_flops_prefix)
+{
+    LilSparseMatrix<double> const A(hub_dense(), 0.);
+    auto prefix(row_flops_prefix(A, A));
+
+    // Row i of A*A costs the lengths of the rows of A that it touches
+    auto const &deg(A.degreeStats().row_degrees);
+    for (IndexType i = 0; i < A.nrows(); ++i)
+    {
+        IndexType flops(0);
+        for (auto&& [k, a_ik] : A[i]) flops += deg[k];
+        BOOST_CHECK_EQUAL(prefix[i + 1] - prefix[i], flops);
+    }
+    BOOST_CHECK_EQUAL(prefix[4] - prefix[3], 10 + 12); // hub hits itself
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(partition_rows_balanced)
+{
+    // 8 rows of unit work: equal pieces
+    IndexArrayType flat = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    IndexArrayType bounds(partition_rows(flat, 4));
+    IndexArrayType ans = {0, 2, 4, 6, 8};
+    BOOST_CHECK_EQUAL_COLLECTIONS(bounds.begin(), bounds.end(),
+                                  ans.begin(), ans.end());
+
+    // The hub row gets a part to itself, empty parts are allowed
+    LilSparseMatrix<double> const A(hub_dense(), 0.);
+    auto prefix(row_nnz_prefix(A));
+    bounds = partition_rows(prefix, 4);
+    BOOST_REQUIRE_EQUAL(bounds.size(), 5);
+    BOOST_CHECK_EQUAL(bounds.front(), 0);
+    BOOST_CHECK_EQUAL(bounds.back(), A.nrows());
+    IndexType max_row(*std::max_element(A.degreeStats().row_degrees.begin(),
+                                        A.degreeStats().row_degrees.end()));
+    for (IndexType p = 0; p < 4; ++p)
+    {
+        BOOST_CHECK(bounds[p] <= bounds[p + 1]);
+        BOOST_CHECK(prefix[bounds[p + 1]] - prefix[bounds[p]] <=
+                    prefix.back() / 4 + max_row);
+    }
+
+    // More parts than rows
+    bounds = partition_rows(IndexArrayType{0, 5, 9}, 5);
+    BOOST_CHECK_EQUAL(bounds.size(), 6);
+    BOOST_CHECK_EQUAL(bounds.back(), 2);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(partition_merge_path)
+{
+    LilSparseMatrix<double> const A(hub_dense(), 0.);
+    auto prefix(row_nnz_prefix(A));
+    IndexType const total(A.nrows() + A.nvals());
+
+    for (IndexType num_parts : {1, 2, 3, 5, 8, 30})
+    {
+        auto coords(merge_path_partition(prefix, num_parts));
+        BOOST_REQUIRE_EQUAL(coords.size(), num_parts + 1);
+        BOOST_CHECK_EQUAL(coords.front().row, 0);
+        BOOST_CHECK_EQUAL(coords.front().nz, 0);
+        BOOST_CHECK_EQUAL(coords.back().row, A.nrows());
+        BOOST_CHECK_EQUAL(coords.back().nz, A.nvals());
+
+        // Every part has the same number of merge items (+/-1) and the
+        // segments of all parts cover every stored value exactly once.
+        std::vector<double> row_sums(A.nrows(), 0.);
+        std::vector<IndexType> visits(A.nvals(), 0);
+        for (IndexType p = 0; p < num_parts; ++p)
+        {
+            IndexType items((coords[p + 1].row - coords[p].row) +
+                            (coords[p + 1].nz - coords[p].nz));
+            BOOST_CHECK(items * num_parts + num_parts >= total);
+            BOOST_CHECK(items * num_parts <= total + num_parts);
+
+            merge_path_segments(
+                prefix, coords[p], coords[p + 1],
+                [&](IndexType row, IndexType first, IndexType last)
+                {
+                    BOOST_CHECK(first < last);
+                    for (IndexType k = first; k < last; ++k)
+                    {
+                        ++visits[prefix[row] + k];
+                        row_sums[row] += std::get<1>(A[row][k]);
+                    }
+                });
+        }
+
+        for (auto v : visits) BOOST_CHECK_EQUAL(v, 1);
+        for (IndexType i = 0; i < A.nrows(); ++i)
+        {
+            double expected(0.);
+            for (auto&& [j, a_ij] : A[i]) expected += a_ij;
+            BOOST_CHECK_EQUAL(row_sums[i], expected);
+        }
+    }
+
+    // The hub row is split when there are enough parts
+    auto coords(merge_path_partition(prefix, 5));
+    IndexType hub_parts(0);
+    for (IndexType p = 0; p < 5; ++p)
+    {
+        merge_path_segments(prefix, coords[p], coords[p + 1],
+                            [&](IndexType row, IndexType, IndexType)
+                            { if (row == 3) ++hub_parts; });
+    }
+    BOOST_CHECK(hub_parts > 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -80,6 +80,28 @@ namespace grb
         }
     };
 
+    //**************************************************************************
+    /**
+     * @brief Structural statistics of a matrix: the number of stored values
+     *        in each row and column and a few summaries of those counts.
+     *
+     * Computed lazily in one pass over the matrix and cached until the
+     * structure of the matrix changes (see Matrix::degreeStats()).
+     */
+    struct DegreeStats
+    {
+        IndexArrayType row_degrees;     // nvals in each row (out-degrees)
+        IndexArrayType col_degrees;     // nvals in each column (in-degrees)
+        IndexType      max_row_degree;
+        IndexType      max_col_degree;
+        double         mean_row_degree;
+        double         mean_col_degree;
+
+        /// Coefficient of variation (stddev/mean) of the row degrees: near 0
+        /// for regular meshes, well above 1 for power-law (skewed) graphs.
+        double         row_degree_skew;
+    };
+
     //**************************************************************************
     template<typename ScalarT, typename... TagsT> class Vector;
 
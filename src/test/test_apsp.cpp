@@ -34,6 +34,7 @@
 
 #include <iostream>
 #include <limits>
+#include <random>
 
 #include <algorithms/apsp.hpp>
 #include <graphblas/graphblas.hpp>
@@ -217,4 +218,95 @@ BOOST_AUTO_TEST_CASE(new_apsp_gilbert_uint)
     BOOST_CHECK_EQUAL(G_gilbert_res, G_gilbert_answer);
 }
 
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(apsp_floyd_warshall_and_johnson_gilbert_uint)
+{
+    grb::IndexType const NUM_NODES(7);
+    grb::IndexArrayType i = {0, 0, 1, 1, 2, 3, 3, 4, 5, 6, 6, 6};
+    grb::IndexArrayType j = {1, 3, 4, 6, 5, 0, 2, 5, 2, 2, 3, 4};
+    std::vector<unsigned int> v(i.size(), 1);
+    grb::Matrix<unsigned int> G_gilbert(NUM_NODES, NUM_NODES);
+    G_gilbert.build(i, j, v);
+
+    auto G_gilbert_answer(get_gilbert_answer<unsigned int>());
+
+    // tile sizes that do and do not divide N
+    for (grb::IndexType tile_size : {1, 2, 3, 7, 64})
+    {
+        auto distances = apsp_floyd_warshall(G_gilbert, tile_size);
+        BOOST_CHECK_EQUAL(distances, G_gilbert_answer);
+    }
+
+    auto distances = apsp_johnson(G_gilbert);
+    BOOST_CHECK_EQUAL(distances, G_gilbert_answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(apsp_floyd_warshall_and_johnson_negative_weights)
+{
+    // Random graph with negative edges only from lower to higher numbered
+    // vertices; backward edges outweigh any forward path so there are no
+    // negative cycles.
+    grb::IndexType const NUM_NODES(40);
+    std::default_random_engine generator(42);
+    std::uniform_int_distribution<grb::IndexType> vertex(0, NUM_NODES - 1);
+    std::uniform_int_distribution<int> weight(1, 20);
+
+    grb::IndexArrayType i, j;
+    std::vector<int>    v;
+    for (grb::IndexType e = 0; e < 4*NUM_NODES; ++e)
+    {
+        grb::IndexType src(vertex(generator)), dst(vertex(generator));
+        if (src == dst) continue;
+        int w(weight(generator));
+        i.push_back(src);
+        j.push_back(dst);
+        v.push_back((src < dst) ? w - 10 : w + 400);
+    }
+    grb::Matrix<int> G(NUM_NODES, NUM_NODES);
+    G.build(i, j, v, grb::Min<int>());
+
+    auto fw_answer = apsp_floyd_warshall(G, 8);
+    BOOST_CHECK_EQUAL(apsp_floyd_warshall(G, 5), fw_answer);
+    BOOST_CHECK_EQUAL(apsp_floyd_warshall(G), fw_answer);
+    BOOST_CHECK_EQUAL(apsp_johnson(G), fw_answer);
+    BOOST_CHECK_EQUAL(apsp(G), fw_answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(apsp_floyd_warshall_uint_no_overflow)
+{
+    // 0->1->2 is longer than the largest representable distance and must
+    // not wrap around to beat the direct edge 0->2.
+    unsigned int const BIG(std::numeric_limits<unsigned int>::max()/2 + 3);
+    grb::IndexArrayType i = {0, 1, 0, 2};
+    grb::IndexArrayType j = {1, 2, 2, 3};
+    std::vector<unsigned int> v = {BIG, BIG, 5, 1};
+    grb::Matrix<unsigned int> G(4, 4);
+    G.build(i, j, v);
+
+    for (grb::IndexType tile_size : {1, 2, 64})
+    {
+        auto distances = apsp_floyd_warshall(G, tile_size);
+        BOOST_CHECK_EQUAL(distances.extractElement(0, 1), BIG);
+        BOOST_CHECK_EQUAL(distances.extractElement(1, 2), BIG);
+        BOOST_CHECK_EQUAL(distances.extractElement(0, 2), 5U);
+        BOOST_CHECK_EQUAL(distances.extractElement(0, 3), 6U);
+        BOOST_CHECK_EQUAL(distances.extractElement(1, 3), BIG + 1);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(apsp_johnson_negative_cycle_detection)
+{
+    grb::IndexArrayType i = {0, 1, 2, 2};
+    grb::IndexArrayType j = {1, 2, 0, 3};
+    std::vector<int>    v = {1, 1, -3, 1};
+    grb::Matrix<int> G(4, 4);
+    G.build(i, j, v);
+
+    BOOST_CHECK_THROW(apsp_johnson(G), grb::PanicException);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -2073,4 +2073,28 @@ BOOST_AUTO_TEST_CASE(assign_mat_constant_test_allrowscols_accum)
 
 /// @todo add tests with masks
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(assign_vec_and_mat_range)
+{
+    std::vector<double> u_vec = {1, 0, 3};
+    Vector<double> u(u_vec, 0);
+
+    Vector<double> result(9), answer(9);
+    IndexArrayType indices = {2, 5, 8};
+    assign(result, NoMask(), NoAccumulate(), u, Range(2, 9, 3));
+    assign(answer, NoMask(), NoAccumulate(), u, indices);
+    BOOST_CHECK_EQUAL(result, answer);
+    BOOST_CHECK_EQUAL(result.nvals(), 2);
+
+    std::vector<std::vector<double>> a_mat = {{1, 0},
+                                              {0, 2}};
+    Matrix<double> mA(a_mat, 0);
+    Matrix<double> mC(4, 6), mAnswer(4, 6);
+    IndexArrayType row_arr = {1, 3}, col_arr = {0, 4};
+    assign(mC, NoMask(), NoAccumulate(), mA, Range(1, 4, 2), Range(0, 6, 4));
+    assign(mAnswer, NoMask(), NoAccumulate(), mA, row_arr, col_arr);
+    BOOST_CHECK_EQUAL(mC, mAnswer);
+    BOOST_CHECK_EQUAL(mC.extractElement(3, 4), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -33,6 +33,7 @@
  */
 
 #include <iostream>
+#include <numeric>
 
 #define GRAPHBLAS_LOGGING_LEVEL 0
 #define GRAPHBLAS_BC_DEBUG 0
@@ -464,5 +465,77 @@ BOOST_AUTO_TEST_CASE(bc_test_batch_alt_trans_v2)
         BOOST_CHECK_CLOSE(result_all[ix], answer_all[ix], 0.0001);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(bc_test_vertex_betweenness_centrality_levels)
+{
+    Matrix<double, DirectedMatrixTag> betweenness(8,8);
+    betweenness.build(br.begin(), bc.begin(), bv.begin(), bv.size());
+
+    IndexArrayType seed_set={0};
+    std::vector<float> answer = {0.0, 4.0/3, 4.0/3, 4.0/3, 3.0, 0.5, 0.5, 0.0};
+    std::vector<float> result =
+        vertex_betweenness_centrality_levels(betweenness, seed_set);
+
+    BOOST_CHECK_EQUAL(result.size(), answer.size());
+    for (unsigned int ix = 0; ix < result.size(); ++ix)
+        BOOST_CHECK_CLOSE(result[ix], answer[ix], 0.0001);
+
+    IndexArrayType seed_set_all={0,1,2,3,4,5,6,7};
+    std::vector<double> answer_all = {0.0, 4.0/3, 4.0/3, 4.0/3, 12.0, 2.5, 2.5, 0.0};
+    std::vector<float> result_all =
+        vertex_betweenness_centrality_levels(betweenness, seed_set_all);
+
+    BOOST_CHECK_EQUAL(result_all.size(), answer_all.size());
+    for (unsigned int ix = 0; ix < result_all.size(); ++ix)
+        BOOST_CHECK_CLOSE(result_all[ix], answer_all[ix], 0.0001);
+
+    // one source per batch
+    std::vector<float> result_budget =
+        vertex_betweenness_centrality_budgeted(betweenness, seed_set_all, 1);
+    for (unsigned int ix = 0; ix < result_budget.size(); ++ix)
+        BOOST_CHECK_CLOSE(result_budget[ix], answer_all[ix], 0.0001);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(bc_test_vertex_betweenness_centrality_levels_long_path)
+{
+    // Undirected path 0-1-...-(N-1): far deeper than 10 levels.  Every
+    // ordered pair (s,t) on either side of v passes through v, so
+    // BC(v) = 2*v*(N-1-v).
+    IndexType const N(25);
+    IndexArrayType rows, cols;
+    for (IndexType v = 0; v + 1 < N; ++v)
+    {
+        rows.push_back(v);   cols.push_back(v+1);
+        rows.push_back(v+1); cols.push_back(v);
+    }
+    Matrix<double, DirectedMatrixTag> path(N, N);
+    path.build(rows, cols, std::vector<double>(rows.size(), 1.0));
+
+    IndexArrayType all_sources(N);
+    std::iota(all_sources.begin(), all_sources.end(), 0);
+
+    std::vector<float> result =
+        vertex_betweenness_centrality_levels(path, all_sources);
+    std::vector<float> result_sampled =
+        vertex_betweenness_centrality_sampled(path, N, 3*N*128);
+
+    BOOST_CHECK_EQUAL(result.size(), N);
+    for (IndexType v = 0; v < N; ++v)
+    {
+        float answer = 2.0f*v*(N - 1 - v);
+        BOOST_CHECK_CLOSE(result[v] + 1.0f, answer + 1.0f, 0.0001);
+        BOOST_CHECK_CLOSE(result_sampled[v] + 1.0f, answer + 1.0f, 0.0001);
+    }
+
+    // From one end of the path, v lies on the paths to every vertex beyond it
+    std::vector<float> result_end =
+        vertex_betweenness_centrality_levels(path, IndexArrayType{0});
+    for (IndexType v = 0; v < N; ++v)
+    {
+        float answer = (v == 0) ? 0.0f : static_cast<float>(N - 1 - v);
+        BOOST_CHECK_CLOSE(result_end[v] + 1.0f, answer + 1.0f, 0.0001);
+    }
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -33,6 +33,7 @@
  */
 
 #include <iostream>
+#include <random>
 
 #include <graphblas/graphblas.hpp>
 #include <algorithms/bfs.hpp>
@@ -752,4 +753,79 @@ BOOST_AUTO_TEST_CASE(bfs_level_masked_v2_test_one_root_integer)
     }
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(batch_bfs_level_bitwise_test_matches_masked)
+{
+    using GrBMatrix = grb::Matrix<unsigned int, grb::DirectedMatrixTag>;
+
+    // Random directed graph, dense enough to switch to pull for some levels
+    grb::IndexType const NUM_NODES(100);
+    grb::IndexType const NUM_ROOTS(70);   // more than one word of traversals
+    std::default_random_engine generator(42);
+    std::uniform_int_distribution<grb::IndexType> vertex(0, NUM_NODES - 1);
+
+    grb::IndexArrayType i, j;
+    for (grb::IndexType ix = 0; ix < 4*NUM_NODES; ++ix)
+    {
+        i.push_back(vertex(generator));
+        j.push_back(vertex(generator));
+    }
+    std::vector<unsigned int> v(i.size(), 1);
+    GrBMatrix G(NUM_NODES, NUM_NODES);
+    G.build(i, j, v);
+
+    GrBMatrix roots(NUM_ROOTS, NUM_NODES);
+    for (grb::IndexType r = 0; r < NUM_ROOTS; ++r)
+    {
+        roots.setElement(r, (7*r) % NUM_NODES, 1);
+    }
+
+    GrBMatrix answer(NUM_ROOTS, NUM_NODES);
+    algorithms::batch_bfs_level_masked(G, roots, answer);
+
+    GrBMatrix levels(NUM_ROOTS, NUM_NODES);
+    algorithms::batch_bfs_level_bitwise(G, roots, levels);
+
+    BOOST_CHECK_EQUAL(levels, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(batch_bfs_level_bitwise_test_one_root)
+{
+    using T = unsigned int;
+    using GrBMatrix = grb::Matrix<T, grb::DirectedMatrixTag>;
+
+    grb::IndexType const NUM_NODES(9);
+    grb::IndexType const START_INDEX(5);
+
+    grb::IndexArrayType i = {0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                   4, 4, 4, 5, 6, 6, 6, 8, 8};
+    grb::IndexArrayType j = {3, 3, 6, 4, 5, 6, 8, 0, 1, 4, 6,
+                                   2, 3, 8, 2, 1, 2, 3, 2, 4};
+    std::vector<T> v(i.size(), 1);
+
+    GrBMatrix G_tn(NUM_NODES, NUM_NODES);
+    G_tn.build(i, j, v);
+
+    GrBMatrix root(1, NUM_NODES);
+    root.setElement(0, START_INDEX, 1);
+
+    GrBMatrix levels(1, NUM_NODES);
+    algorithms::batch_bfs_level_bitwise(G_tn, root, levels);
+
+    std::vector<T> answer = {5, 4, 2, 4, 3, 1, 3, 0, 3};
+    for (grb::IndexType ix = 0; ix < NUM_NODES; ++ix)
+    {
+        if (levels.hasElement(0, ix))
+        {
+            BOOST_CHECK_EQUAL(levels.extractElement(0, ix),
+                              answer[ix]);
+        }
+        else
+        {
+            BOOST_CHECK_EQUAL(0, answer[ix]);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -33,6 +33,7 @@
  */
 
 #include <iostream>
+#include <set>
 
 #include <graphblas/graphblas.hpp>
 #include <algorithms/cluster_louvain.hpp>
@@ -145,4 +146,53 @@ BOOST_AUTO_TEST_CASE(cluster_test_louvain_masked)
                 cluster_assignments.extractElement(1));
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(cluster_test_louvain_ring_of_cliques)
+{
+    // 8 cliques of 5 vertices joined in a ring by single edges
+    IndexType const NUM_CLIQUES(8), CLIQUE_SIZE(5);
+    IndexType const NUM_NODES(NUM_CLIQUES*CLIQUE_SIZE);
+    grb::IndexArrayType i, j;
+    for (IndexType c = 0; c < NUM_CLIQUES; ++c)
+    {
+        for (IndexType a = 0; a < CLIQUE_SIZE; ++a)
+        {
+            for (IndexType b = 0; b < CLIQUE_SIZE; ++b)
+            {
+                if (a != b)
+                {
+                    i.push_back(c*CLIQUE_SIZE + a);
+                    j.push_back(c*CLIQUE_SIZE + b);
+                }
+            }
+        }
+        IndexType next((c + 1) % NUM_CLIQUES);
+        i.push_back(c*CLIQUE_SIZE);     j.push_back(next*CLIQUE_SIZE + 1);
+        i.push_back(next*CLIQUE_SIZE + 1); j.push_back(c*CLIQUE_SIZE);
+    }
+    std::vector<double> v(i.size(), 1.0);
+    Matrix<double> m1(NUM_NODES, NUM_NODES);
+    m1.build(i, j, v);
+
+    for (auto const &ans : {algorithms::louvain_cluster(m1),
+                            algorithms::louvain_cluster_masked(m1)})
+    {
+        auto cluster_assignments = get_louvain_cluster_assignments(ans);
+        BOOST_CHECK_EQUAL(cluster_assignments.nvals(), NUM_NODES);
+
+        std::set<IndexType> clusters;
+        for (IndexType c = 0; c < NUM_CLIQUES; ++c)
+        {
+            IndexType id(cluster_assignments.extractElement(c*CLIQUE_SIZE));
+            clusters.insert(id);
+            for (IndexType a = 1; a < CLIQUE_SIZE; ++a)
+            {
+                BOOST_CHECK_EQUAL(
+                    cluster_assignments.extractElement(c*CLIQUE_SIZE + a), id);
+            }
+        }
+        BOOST_CHECK(clusters.size() > 1);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,157 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party Software
+ * subject to its own license:
+ *
+ * 1. Boost Unit Test Framework
+ * (https://www.boost.org/doc/libs/1_45_0/libs/test/doc/html/utf.html)
+ * Copyright 2001 Boost software license, Gennadiy Rozental.
+ *
+ * DM20-0442
+ */
+
+
+#include <iostream>
+#include <random>
+
+#include <graphblas/graphblas.hpp>
+#include <algorithms/connected_components.hpp>
+
+using namespace grb;
+using namespace algorithms;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE connected_components_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    // Symmetric graph: {0,3,5}, {1,2,6,7}, {4}, {8,9}
+    Matrix<unsigned int> make_test_graph()
+    {
+        IndexArrayType i = {0, 3, 3, 5, 1, 2, 2, 6, 6, 7, 8, 9, 7, 1};
+        IndexArrayType j = {3, 0, 5, 3, 2, 1, 6, 2, 7, 6, 9, 8, 1, 7};
+        std::vector<unsigned int> v(i.size(), 1);
+        Matrix<unsigned int> graph(10, 10);
+        graph.build(i, j, v);
+        return graph;
+    }
+
+    // Two labelings describe the same partition
+    bool same_partition(Vector<IndexType> const &a, Vector<IndexType> const &b)
+    {
+        if ((a.size() != b.size()) || (a.nvals() != a.size()) ||
+            (b.nvals() != b.size()))
+        {
+            return false;
+        }
+        for (IndexType u = 0; u < a.size(); ++u)
+        {
+            for (IndexType v = u + 1; v < a.size(); ++v)
+            {
+                if ((a.extractElement(u) == a.extractElement(v)) !=
+                    (b.extractElement(u) == b.extractElement(v)))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(connected_components_fastsv)
+{
+    auto graph(make_test_graph());
+    Vector<IndexType> labels(10);
+    algorithms::connected_components(graph, labels);
+
+    std::vector<IndexType> answer = {0, 1, 1, 0, 4, 0, 1, 1, 8, 8};
+    Vector<IndexType> ans(answer);
+    BOOST_CHECK_EQUAL(labels, ans);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(connected_components_afforest_small)
+{
+    auto graph(make_test_graph());
+    Vector<IndexType> labels(10);
+    algorithms::connected_components_afforest(graph, labels, 1);
+
+    std::vector<IndexType> answer = {0, 1, 1, 0, 4, 0, 1, 1, 8, 8};
+    Vector<IndexType> ans(answer);
+    BOOST_CHECK(same_partition(labels, ans));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(connected_components_random)
+{
+    // sparse random graph with a giant component and many small ones
+    IndexType const NUM_NODES(300);
+    std::default_random_engine generator(7);
+    std::uniform_int_distribution<IndexType> vertex(0, NUM_NODES - 1);
+
+    IndexArrayType i, j;
+    for (IndexType ix = 0; ix < 200; ++ix)
+    {
+        IndexType u(vertex(generator)), v(vertex(generator));
+        i.push_back(u); j.push_back(v);
+        i.push_back(v); j.push_back(u);
+    }
+    std::vector<bool> v(i.size(), true);
+    Matrix<bool> graph(NUM_NODES, NUM_NODES);
+    graph.build(i, j, v, grb::LogicalOr<bool>());
+
+    // reference labels from repeated relaxation to the min neighbor label
+    std::vector<IndexType> ref(NUM_NODES);
+    for (IndexType ix = 0; ix < NUM_NODES; ++ix) ref[ix] = ix;
+    for (bool changed = true; changed; )
+    {
+        changed = false;
+        for (IndexType ix = 0; ix < i.size(); ++ix)
+        {
+            if (ref[j[ix]] < ref[i[ix]])
+            {
+                ref[i[ix]] = ref[j[ix]];
+                changed = true;
+            }
+        }
+    }
+    Vector<IndexType> answer(ref);
+
+    Vector<IndexType> labels(NUM_NODES);
+    algorithms::connected_components(graph, labels);
+    BOOST_CHECK_EQUAL(labels, answer);
+
+    Vector<IndexType> afforest_labels(NUM_NODES);
+    algorithms::connected_components_afforest(graph, afforest_labels);
+    BOOST_CHECK(same_partition(afforest_labels, answer));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1865,4 +1865,77 @@ BOOST_AUTO_TEST_CASE(extract_stdmat_test_scmp_accum_trans)
     }
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(extract_stdmat_range)
+{
+    std::vector<std::vector<double>> mat = {{8, 1, 6, 0, 2},
+                                            {3, 0, 7, 4, 0},
+                                            {0, 9, 2, 0, 5},
+                                            {1, 0, 0, 6, 3}};
+    Matrix<double> mA(mat, 0);
+
+    Range rows(1, 4), cols(0, 5, 2);
+    IndexArrayType row_arr = {1, 2, 3}, col_arr = {0, 2, 4};
+
+    Matrix<double> result(3, 3), answer(3, 3);
+    extract(result, NoMask(), NoAccumulate(), mA, rows, cols);
+    extract(answer, NoMask(), NoAccumulate(), mA, row_arr, col_arr);
+    BOOST_CHECK_EQUAL(result, answer);
+
+    // transposed: rows of A' are the columns of A
+    Matrix<double> resultT(3, 3), answerT(3, 3);
+    extract(resultT, NoMask(), NoAccumulate(), transpose(mA), cols, rows);
+    extract(answerT, NoMask(), NoAccumulate(), transpose(mA),
+            col_arr, row_arr);
+    BOOST_CHECK_EQUAL(resultT, answerT);
+
+    std::vector<std::vector<double>> ans = {{3, 7, 0},
+                                            {0, 2, 5},
+                                            {1, 0, 3}};
+    BOOST_CHECK_EQUAL(result, Matrix<double>(ans, 0));
+
+    // unsorted and duplicated columns
+    IndexArrayType perm_cols = {4, 0, 0, 2};
+    std::vector<std::vector<double>> perm_ans = {{0, 3, 3, 7},
+                                                 {5, 0, 0, 2},
+                                                 {3, 1, 1, 0}};
+    Matrix<double> perm_result(3, 4);
+    extract(perm_result, NoMask(), NoAccumulate(), mA, rows, perm_cols);
+    BOOST_CHECK_EQUAL(perm_result, Matrix<double>(perm_ans, 0));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(extract_stdmat_whole_rows)
+{
+    std::vector<std::vector<double>> mat = {{8, 1, 6, 0, 2},
+                                            {3, 0, 7, 4, 0},
+                                            {0, 9, 2, 0, 5},
+                                            {1, 0, 0, 6, 3}};
+    Matrix<double> mA(mat, 0);
+
+    // all columns of selected rows are copied as a block
+    IndexArrayType rows = {3, 0, 3};
+    std::vector<std::vector<double>> ans = {{1, 0, 0, 6, 3},
+                                            {8, 1, 6, 0, 2},
+                                            {1, 0, 0, 6, 3}};
+    Matrix<double> result(3, 5);
+    extract(result, NoMask(), NoAccumulate(), mA, rows, AllIndices());
+    BOOST_CHECK_EQUAL(result, Matrix<double>(ans, 0));
+    BOOST_CHECK_EQUAL(result.nvals(), 10);
+
+    // a leading block of columns, with a conversion to int
+    std::vector<std::vector<int>> ans_prefix = {{3, 0, 7},
+                                                {0, 9, 2}};
+    Matrix<int> result_prefix(2, 3);
+    extract(result_prefix, NoMask(), NoAccumulate(), mA,
+            Range(1, 3), Range(0, 3));
+    BOOST_CHECK_EQUAL(result_prefix, Matrix<int>(ans_prefix, 0));
+
+    // a row of A' (column extract of the transpose)
+    std::vector<double> row_ans = {0, 9, 2, 0, 5};
+    Vector<double> row(5);
+    extract(row, NoMask(), NoAccumulate(), transpose(mA), AllIndices(), 2);
+    BOOST_CHECK_EQUAL(row, Vector<double>(row_ans, 0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1023,4 +1023,62 @@ BOOST_AUTO_TEST_CASE(extract_stdvec_test_scmp_accum)
 }
 
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(extract_stdvec_range)
+{
+    std::vector<double> vec = {1, 0, 3, 4, 0, 6, 7, 0, 9, 10};
+    Vector<double> vU(vec, 0);
+
+    // Range and the equivalent index array must agree
+    std::vector<std::pair<Range, IndexArrayType>> cases = {
+        {Range(2, 8),     {2, 3, 4, 5, 6, 7}},
+        {Range(1, 10, 3), {1, 4, 7}},
+        {Range(0, 10, 2), {0, 2, 4, 6, 8}}};
+
+    for (auto const &[range, indices] : cases)
+    {
+        BOOST_CHECK_EQUAL(range.size(), indices.size());
+
+        Vector<double> result(range.size());
+        Vector<double> answer(indices.size());
+        extract(result, NoMask(), NoAccumulate(), vU, range);
+        extract(answer, NoMask(), NoAccumulate(), vU, indices);
+        BOOST_CHECK_EQUAL(result, answer);
+    }
+    BOOST_CHECK(Range(5, 5).empty());
+    BOOST_CHECK_THROW(Range(0, 10, 0), InvalidValueException);
+
+    // unsorted, duplicated indices go through a single sort and merge
+    {
+        IndexArrayType indices = {9, 0, 5, 5, 1, 2};
+        std::vector<double> ans = {10, 1, 6, 6, 0, 3};
+        Vector<double> answer(ans, 0);
+
+        Vector<double> result(indices.size());
+        extract(result, NoMask(), NoAccumulate(), vU, indices);
+        BOOST_CHECK_EQUAL(result, answer);
+    }
+
+    Vector<double> result(4);
+    BOOST_CHECK_THROW(
+        (extract(result, NoMask(), NoAccumulate(), vU, Range(4, 12, 2))),
+        IndexOutOfBoundsException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(extract_stdvec_all_and_prefix)
+{
+    std::vector<double> vec = {1, 0, 3, 4, 0, 6, 7, 0, 9, 10};
+    Vector<double> vU(vec, 0);
+
+    Vector<double> result(10);
+    extract(result, NoMask(), NoAccumulate(), vU, AllIndices());
+    BOOST_CHECK_EQUAL(result, vU);
+
+    std::vector<double> ans = {1, 0, 3, 4};
+    Vector<double> prefix(4);
+    extract(prefix, NoMask(), NoAccumulate(), vU, AllIndices());
+    BOOST_CHECK_EQUAL(prefix, Vector<double>(ans, 0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -380,4 +380,100 @@ BOOST_AUTO_TEST_CASE(k_truss2_test_peer_pressure2)
     BOOST_CHECK_EQUAL(0, Aout4.nvals());
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(k_truss_incremental_test2)
+{
+    grb::IndexArrayType i = {
+        0, 0, 0, 0,
+        1,    1, 1,
+        2,    2, 2,
+        3,    3, 3, 3,
+        4, 4,    4, 4,
+        5,    5,
+        6, 6,    6,
+        7, 7,    7, 7,
+        8, 8,    8, 8,
+        9, 9, 9,
+        10,10,10,   10,
+        11,11   };
+
+    grb::IndexArrayType j = {
+        1, 5, 6, 9,
+        0,    2, 4,
+        1,    3, 4,
+        2,    7, 8, 10,
+        1, 2,    6, 7,
+        0,    9,
+        0, 4,    9,
+        3, 4,    8, 10,
+        3, 7,    10, 11,
+        0, 5, 6,
+        3, 7, 8,     11,
+        8, 10    };
+
+    IndexType num_edges = i.size();
+    IndexType num_nodes = 12;
+    std::vector<int> val(num_edges, 1);
+    Matrix<int> A(num_nodes, num_nodes);
+    A.build(i.begin(), j.begin(), val.begin(), num_edges);
+
+    auto A3out = algorithms::k_truss_incremental(A, 3);
+    BOOST_CHECK_EQUAL(A3out.nvals(), 32);
+    BOOST_CHECK_EQUAL(A3out, algorithms::k_truss2(A, 3));
+
+    auto A4out = algorithms::k_truss_incremental(A, 4);
+    BOOST_CHECK_EQUAL(A4out.nvals(), 12);
+    BOOST_CHECK_EQUAL(A4out, algorithms::k_truss2(A, 4));
+
+    auto A5out = algorithms::k_truss_incremental(A, 5);
+    BOOST_CHECK_EQUAL(A5out.nvals(), 0);
+
+    // truss numbers of all edges in one run
+    auto Truss = algorithms::truss_decomposition(A);
+    BOOST_CHECK_EQUAL(Truss.nvals(), num_edges);
+
+    IndexArrayType rows(num_edges), cols(num_edges);
+    std::vector<IndexType> truss(num_edges);
+    Truss.extractTuples(rows, cols, truss);
+    IndexType num3(0), num4(0);
+    for (IndexType ix = 0; ix < num_edges; ++ix)
+    {
+        BOOST_CHECK(truss[ix] >= 2 && truss[ix] <= 4);
+        BOOST_CHECK_EQUAL(truss[ix] >= 3, A3out.hasElement(rows[ix], cols[ix]));
+        BOOST_CHECK_EQUAL(truss[ix] >= 4, A4out.hasElement(rows[ix], cols[ix]));
+        num3 += (truss[ix] >= 3);
+        num4 += (truss[ix] >= 4);
+    }
+    BOOST_CHECK_EQUAL(num3, 32);
+    BOOST_CHECK_EQUAL(num4, 12);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(truss_decomposition_test_clique_with_tail)
+{
+    // 5-clique on 0..4 with a triangle 4,5,6 and a pendant edge 6-7
+    IndexArrayType i, j;
+    auto add_edge = [&](IndexType u, IndexType v)
+        { i.push_back(u); j.push_back(v); i.push_back(v); j.push_back(u); };
+    for (IndexType u = 0; u < 5; ++u)
+        for (IndexType v = u + 1; v < 5; ++v)
+            add_edge(u, v);
+    add_edge(4, 5); add_edge(4, 6); add_edge(5, 6); add_edge(6, 7);
+
+    Matrix<bool> A(8, 8);
+    A.build(i, j, std::vector<bool>(i.size(), true));
+
+    auto Truss = algorithms::truss_decomposition(A);
+    BOOST_CHECK_EQUAL(Truss.nvals(), i.size());
+    BOOST_CHECK_EQUAL(Truss.extractElement(0, 1), 5);
+    BOOST_CHECK_EQUAL(Truss.extractElement(3, 4), 5);
+    BOOST_CHECK_EQUAL(Truss.extractElement(4, 5), 3);
+    BOOST_CHECK_EQUAL(Truss.extractElement(6, 5), 3);
+    BOOST_CHECK_EQUAL(Truss.extractElement(6, 7), 2);
+    BOOST_CHECK_EQUAL(Truss.extractElement(7, 6), 2);
+
+    BOOST_CHECK_EQUAL(algorithms::k_truss_incremental(A, 5).nvals(), 20);
+    BOOST_CHECK_EQUAL(algorithms::k_truss_incremental(A, 3).nvals(), 26);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,148 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party Software
+ * subject to its own license:
+ *
+ * 1. Boost Unit Test Framework
+ * (https://www.boost.org/doc/libs/1_45_0/libs/test/doc/html/utf.html)
+ * Copyright 2001 Boost software license, Gennadiy Rozental.
+ *
+ * DM20-0442
+ */
+
+#include <iostream>
+#include <random>
+
+#include <graphblas/graphblas.hpp>
+#include <algorithms/kcore.hpp>
+
+using namespace grb;
+using namespace algorithms;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE kcore_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    // Reference: repeatedly remove a vertex of minimum degree
+    std::vector<IndexType> reference_core_numbers(
+        IndexType n, std::vector<std::vector<IndexType>> const &adj)
+    {
+        std::vector<IndexType> deg(n), core(n, 0);
+        std::vector<bool> removed(n, false);
+        for (IndexType v = 0; v < n; ++v) deg[v] = adj[v].size();
+
+        IndexType k(0);
+        for (IndexType iter = 0; iter < n; ++iter)
+        {
+            IndexType best(n);
+            for (IndexType v = 0; v < n; ++v)
+                if (!removed[v] && ((best == n) || (deg[v] < deg[best])))
+                    best = v;
+            k = std::max(k, deg[best]);
+            core[best] = k;
+            removed[best] = true;
+            for (auto u : adj[best])
+                if (!removed[u]) --deg[u];
+        }
+        return core;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(kcore_test_small)
+{
+    // 4-clique {0,1,2,3}; 4 attached to 0, 1 and 5; path 5-6;
+    // 7 is isolated except for a self loop.
+    IndexArrayType i, j;
+    auto add_edge = [&](IndexType u, IndexType v)
+        { i.push_back(u); j.push_back(v); i.push_back(v); j.push_back(u); };
+    add_edge(0, 1); add_edge(0, 2); add_edge(0, 3);
+    add_edge(1, 2); add_edge(1, 3); add_edge(2, 3);
+    add_edge(4, 0); add_edge(4, 1); add_edge(4, 5); add_edge(5, 6);
+    i.push_back(7); j.push_back(7);
+
+    Matrix<double> graph(8, 8);
+    graph.build(i, j, std::vector<double>(i.size(), 0.5));
+
+    std::vector<IndexType> ans = {3, 3, 3, 3, 2, 1, 1, 0};
+    Vector<IndexType> answer(ans);
+
+    Vector<IndexType> core(8);
+    kcore(graph, core);
+    BOOST_CHECK_EQUAL(core, answer);
+
+    Vector<IndexType> core_batched(8);
+    kcore_batched(graph, core_batched);
+    BOOST_CHECK_EQUAL(core_batched, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(kcore_test_random)
+{
+    IndexType const N(200);
+    std::default_random_engine generator(7);
+    std::uniform_int_distribution<IndexType> vertex(0, N - 1);
+
+    std::vector<std::vector<IndexType>> adj(N);
+    IndexArrayType i, j;
+    for (IndexType e = 0; e < 6*N; ++e)
+    {
+        IndexType u(vertex(generator)), v(vertex(generator));
+        if ((u == v) ||
+            (std::find(adj[u].begin(), adj[u].end(), v) != adj[u].end()))
+            continue;
+        adj[u].push_back(v); adj[v].push_back(u);
+        i.push_back(u); j.push_back(v);
+        i.push_back(v); j.push_back(u);
+    }
+    Matrix<bool> graph(N, N);
+    graph.build(i, j, std::vector<bool>(i.size(), true));
+
+    Vector<IndexType> answer(reference_core_numbers(N, adj));
+
+    Vector<IndexType> core(N);
+    kcore(graph, core);
+    BOOST_CHECK_EQUAL(core, answer);
+
+    Vector<IndexType> core_batched(N);
+    kcore_batched(graph, core_batched);
+    BOOST_CHECK_EQUAL(core_batched, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(kcore_test_bad_dimensions)
+{
+    Matrix<bool> graph(4, 4);
+    Vector<IndexType> core(3);
+    BOOST_CHECK_THROW(kcore(graph, core), DimensionException);
+    BOOST_CHECK_THROW(kcore_batched(graph, core), DimensionException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2158,4 +2158,70 @@ BOOST_AUTO_TEST_CASE(test_kronecker_CompMask_Accum_AB_MCdup)
 }
 
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_kronecker_rows_streaming)
+{
+    Matrix<double> A(A_sparse_3x3, 0.);
+    Matrix<double> B(B_sparse_3x4, 0.);
+    Matrix<double> answer(Answer_sparse_9x12, 0.);
+
+    // Rebuild the product from the streamed rows
+    auto stream = [](auto const &AA, auto const &BB, Matrix<double> &C)
+    {
+        IndexArrayType rows, cols;
+        std::vector<double> vals;
+        IndexType last_row(0);
+        bool first(true);
+        kronecker_rows(AA, BB, Times<double>(),
+                       [&](IndexType i, auto const &row)
+                       {
+                           BOOST_CHECK(!row.empty());
+                           BOOST_CHECK(first || (i > last_row));
+                           first = false;
+                           last_row = i;
+                           for (IndexType k = 0; k < row.size(); ++k)
+                           {
+                               if (k > 0)
+                                   BOOST_CHECK(std::get<0>(row[k - 1]) <
+                                               std::get<0>(row[k]));
+                               rows.push_back(i);
+                               cols.push_back(std::get<0>(row[k]));
+                               vals.push_back(std::get<1>(row[k]));
+                           }
+                       });
+        C.build(rows, cols, vals);
+    };
+
+    Matrix<double> C(9, 12);
+    stream(A, B, C);
+    BOOST_CHECK_EQUAL(C, answer);
+
+    // Transposed operands match the materialized kronecker
+    Matrix<double> expected(12, 9), streamed(12, 9);
+    Matrix<double> AT(3, 3), BT(4, 3);
+    transpose(AT, NoMask(), NoAccumulate(), A);
+    transpose(BT, NoMask(), NoAccumulate(), B);
+
+    kronecker(expected, NoMask(), NoAccumulate(), Times<double>(), A, BT);
+    stream(A, transpose(B), streamed);
+    BOOST_CHECK_EQUAL(streamed, expected);
+
+    Matrix<double> expected2(9, 12), streamed2(9, 12);
+    kronecker(expected2, NoMask(), NoAccumulate(), Times<double>(), AT, B);
+    stream(transpose(A), B, streamed2);
+    BOOST_CHECK_EQUAL(streamed2, expected2);
+
+    Matrix<double> expected3(12, 9), streamed3(12, 9);
+    kronecker(expected3, NoMask(), NoAccumulate(), Times<double>(), AT, BT);
+    stream(transpose(A), transpose(B), streamed3);
+    BOOST_CHECK_EQUAL(streamed3, expected3);
+
+    // Nothing is emitted for an empty operand
+    Matrix<double> Empty(3, 4);
+    IndexType num_rows(0);
+    kronecker_rows(A, Empty, Times<double>(),
+                   [&](IndexType, auto const &) { ++num_rows; });
+    BOOST_CHECK_EQUAL(num_rows, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
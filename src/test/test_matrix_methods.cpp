@@ -138,4 +138,103 @@ BOOST_AUTO_TEST_CASE(matrix_removeElement_test)
     BOOST_CHECK(!m1.hasElement(1, 2));
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_applyUpdates_test)
+{
+    IndexArrayType      i = {0, 0, 0, 1, 1, 1, 2, 2};
+    IndexArrayType      j = {1, 2, 3, 0, 2, 3, 0, 1};
+    std::vector<double> v = {1, 2, 3, 4, 6, 7, 8, 9};
+
+    Matrix<double, DirectedMatrixTag> m1(4, 4);
+    m1.build(i, j, v);
+
+    // delete (0,2), (2,0) and a non-existent (3,3); insert into row 0 on
+    // top of an existing value, twice into the empty row 3, and re-insert
+    // the deleted (2,0).
+    IndexArrayType      ins_i = {3, 0, 3, 2, 0};
+    IndexArrayType      ins_j = {1, 1, 1, 0, 0};
+    std::vector<double> ins_v = {5, 10, 6, 20, 30};
+    IndexArrayType      del_i = {2, 0, 3};
+    IndexArrayType      del_j = {0, 2, 3};
+
+    auto changed = m1.applyUpdates(ins_i, ins_j, ins_v, del_i, del_j,
+                                   grb::Plus<double>());
+
+    std::vector<std::vector<double> > ans = {{30, 11,  0,  3},
+                                             { 4,  0,  6,  7},
+                                             {20,  9,  0,  0},
+                                             { 0, 11,  0,  0}};
+    Matrix<double, DirectedMatrixTag> answer(ans, 0.);
+    BOOST_CHECK_EQUAL(m1, answer);
+    BOOST_CHECK_EQUAL(m1.nvals(), 9);
+    IndexArrayType changed_ans = {0, 2, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(changed.begin(), changed.end(),
+                                  changed_ans.begin(), changed_ans.end());
+
+    // deleting something that does not exist changes nothing
+    changed = m1.applyUpdates(IndexArrayType(), IndexArrayType(),
+                              std::vector<double>(),
+                              IndexArrayType({1}), IndexArrayType({1}));
+    BOOST_CHECK(changed.empty());
+    BOOST_CHECK_EQUAL(m1, answer);
+
+    BOOST_CHECK_THROW(m1.applyUpdates(IndexArrayType({0}), IndexArrayType(),
+                                      std::vector<double>({1.}),
+                                      IndexArrayType(), IndexArrayType()),
+                      grb::DimensionException);
+    BOOST_CHECK_THROW(m1.applyUpdates(IndexArrayType({4}), IndexArrayType({0}),
+                                      std::vector<double>({1.}),
+                                      IndexArrayType(), IndexArrayType()),
+                      grb::IndexOutOfBoundsException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_degreeStats_test)
+{
+    std::vector<std::vector<double> > mat = {{8, 1, 0, 0},
+                                             {0, 0, 0, 0},
+                                             {4, 5, 6, 2},
+                                             {0, 0, 7, 0}};
+    Matrix<double, DirectedMatrixTag> m1(mat, 0.);
+
+    {
+        auto const &stats(m1.degreeStats());
+        IndexArrayType rows_ans = {2, 0, 4, 1};
+        IndexArrayType cols_ans = {2, 2, 2, 1};
+        BOOST_CHECK_EQUAL_COLLECTIONS(stats.row_degrees.begin(),
+                                      stats.row_degrees.end(),
+                                      rows_ans.begin(), rows_ans.end());
+        BOOST_CHECK_EQUAL_COLLECTIONS(stats.col_degrees.begin(),
+                                      stats.col_degrees.end(),
+                                      cols_ans.begin(), cols_ans.end());
+        BOOST_CHECK_EQUAL(stats.max_row_degree, 4);
+        BOOST_CHECK_EQUAL(stats.max_col_degree, 2);
+        BOOST_CHECK_CLOSE(stats.mean_row_degree, 1.75, 0.0001);
+        BOOST_CHECK_CLOSE(stats.mean_col_degree, 1.75, 0.0001);
+        // stddev of {2,0,4,1} is sqrt(2.1875)
+        BOOST_CHECK_CLOSE(stats.row_degree_skew, std::sqrt(2.1875)/1.75,
+                          0.0001);
+    }
+
+    // value-only update keeps the counts, structural updates refresh them
+    m1.setElement(0, 0, 9);
+    BOOST_CHECK_EQUAL(m1.degreeStats().row_degrees[0], 2);
+    m1.setElement(1, 3, 3);
+    BOOST_CHECK_EQUAL(m1.degreeStats().row_degrees[1], 1);
+    BOOST_CHECK_EQUAL(m1.degreeStats().col_degrees[3], 2);
+    m1.removeElement(2, 0);
+    BOOST_CHECK_EQUAL(m1.degreeStats().row_degrees[2], 3);
+    BOOST_CHECK_EQUAL(m1.degreeStats().col_degrees[0], 1);
+    m1.applyUpdates(IndexArrayType({3}), IndexArrayType({0}),
+                    std::vector<double>({1.}),
+                    IndexArrayType(), IndexArrayType());
+    BOOST_CHECK_EQUAL(m1.degreeStats().col_degrees[0], 2);
+    m1.resize(2, 4);
+    BOOST_CHECK_EQUAL(m1.degreeStats().row_degrees.size(), 2);
+    BOOST_CHECK_EQUAL(m1.degreeStats().max_col_degree, 1);
+    m1.clear();
+    BOOST_CHECK_EQUAL(m1.degreeStats().max_row_degree, 0);
+    BOOST_CHECK_EQUAL(m1.degreeStats().row_degree_skew, 0.);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -33,6 +33,7 @@
  */
 
 #include <iostream>
+#include <random>
 
 #include <algorithms/maxflow.hpp>
 #include <graphblas/graphblas.hpp>
@@ -84,6 +85,60 @@ BOOST_AUTO_TEST_CASE(maxflow_push_relabel_test2)
     BOOST_CHECK_EQUAL(result, 28);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(maxflow_push_relabel_unreachable_sink)
+{
+    IndexArrayType i = {0, 0, 1, 2, 4};
+    IndexArrayType j = {1, 2, 3, 3, 5};
+    std::vector<double> v = {3, 4, 5, 1, 7};
+    Matrix<double, DirectedMatrixTag> m1(6, 6);
+    m1.build(i, j, v);
+
+    BOOST_CHECK_EQUAL(algorithms::maxflow_push_relabel(m1, 0, 5), 0);
+    BOOST_CHECK_EQUAL(algorithms::maxflow_push_relabel(m1, 0, 3), 4);
+    BOOST_CHECK_EQUAL(algorithms::maxflow_push_relabel(m1, 0, 0), 0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(maxflow_push_relabel_random_vs_ford_fulk)
+{
+    std::default_random_engine generator(17);
+    std::uniform_int_distribution<int> cap_dist(1, 20);
+    std::uniform_real_distribution<double> edge_dist(0.0, 1.0);
+
+    for (IndexType trial = 0; trial < 5; ++trial)
+    {
+        IndexType const N = 30;
+        IndexArrayType i, j;
+        std::vector<double> v;
+        for (IndexType u = 0; u < N; ++u)
+        {
+            for (IndexType w = 0; w < N; ++w)
+            {
+                if ((u != w) && (edge_dist(generator) < 0.12))
+                {
+                    i.push_back(u);
+                    j.push_back(w);
+                    v.push_back(cap_dist(generator));
+                }
+            }
+        }
+        Matrix<double, DirectedMatrixTag> m1(N, N);
+        m1.build(i, j, v);
+
+        BOOST_CHECK_EQUAL(algorithms::maxflow_push_relabel(m1, 0, N - 1),
+                          algorithms::maxflow_ford_fulk(m1, 0, N - 1));
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(maxflow_push_relabel_bad_dimensions)
+{
+    Matrix<double, DirectedMatrixTag> m1(4, 5);
+    BOOST_CHECK_THROW(algorithms::maxflow_push_relabel(m1, 0, 3),
+                      DimensionException);
+}
+
 //****************************************************************************
 BOOST_AUTO_TEST_CASE(maxflow_ford_fulk_test)
 {
@@ -33,6 +33,7 @@
  */
 
 #include <iostream>
+#include <random>
 
 #include <algorithms/mst.hpp>
 #include <graphblas/graphblas.hpp>
@@ -140,4 +141,93 @@ BOOST_AUTO_TEST_CASE(mst_test_with_weights)
     grb::print_vector(std::cout, parents, "MST parent list");
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(msf_test_with_weights)
+{
+    IndexType const NUM_NODES = 9;
+    IndexArrayType i_m1 = {0, 0, 1, 1, 1, 2, 2, 2, 2,
+                           3, 3, 3, 4, 4, 5, 5, 5, 5,
+                           6, 6, 6, 7, 7, 7, 7, 8, 8, 8};
+    IndexArrayType j_m1 = {1, 7, 0, 2, 7, 1, 3, 5, 8,
+                           2, 4, 5, 3, 5, 2, 3, 4, 6,
+                           5, 7, 8, 0, 1, 6, 8, 2, 6, 7};
+    std::vector<double> v_m1 = {4, 8, 4, 8,11, 8, 7, 4, 2,
+                                7, 9,14, 9,10, 4,14,10, 2,
+                                2, 1, 6, 8,11, 1, 7, 2, 6, 7};
+    Matrix<double> m1(NUM_NODES, NUM_NODES);
+    m1.build(i_m1, j_m1, v_m1);
+
+    Matrix<double> forest(NUM_NODES, NUM_NODES);
+    auto result = msf(m1, forest);
+
+    BOOST_CHECK_EQUAL(result, 37);
+    BOOST_CHECK_EQUAL(forest.nvals(), 2*(NUM_NODES - 1));
+
+    double forest_weight(0);
+    reduce(forest_weight, NoAccumulate(), PlusMonoid<double>(), forest);
+    BOOST_CHECK_EQUAL(forest_weight, 2*37);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(msf_test_disconnected_equal_weights)
+{
+    // Two 4-cycles of unit weight plus an isolated vertex
+    IndexType const NUM_NODES = 9;
+    IndexArrayType i_m1 = {0, 1, 2, 3, 4, 5, 6, 7};
+    IndexArrayType j_m1 = {1, 2, 3, 0, 5, 6, 7, 4};
+    std::vector<double> v_m1(i_m1.size(), 1);
+    Matrix<double> m1(NUM_NODES, NUM_NODES);
+    m1.build(i_m1, j_m1, v_m1);
+
+    Matrix<double> forest(NUM_NODES, NUM_NODES);
+    auto result = msf(m1, forest);
+
+    BOOST_CHECK_EQUAL(result, 6);
+    BOOST_CHECK_EQUAL(forest.nvals(), 12);
+    for (IndexType v = 0; v < NUM_NODES; ++v)
+    {
+        BOOST_CHECK(!forest.hasElement(v, 8));
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(msf_test_random_vs_prim)
+{
+    std::default_random_engine generator(11);
+    std::uniform_int_distribution<int> weight_dist(1, 9);
+    std::uniform_real_distribution<double> edge_dist(0.0, 1.0);
+
+    IndexType const NUM_NODES = 60;
+    IndexArrayType i_m1, j_m1;
+    std::vector<double> v_m1;
+    for (IndexType u = 0; u < NUM_NODES; ++u)
+    {
+        for (IndexType v = u + 1; v < NUM_NODES; ++v)
+        {
+            // a path keeps the graph connected for Prim's algorithm
+            if ((v == u + 1) || (edge_dist(generator) < 0.1))
+            {
+                double w = weight_dist(generator);
+                i_m1.push_back(u);  j_m1.push_back(v);  v_m1.push_back(w);
+                i_m1.push_back(v);  j_m1.push_back(u);  v_m1.push_back(w);
+            }
+        }
+    }
+    Matrix<double> m1(NUM_NODES, NUM_NODES);
+    m1.build(i_m1, j_m1, v_m1);
+
+    grb::Vector<IndexType> parents(NUM_NODES);
+    Matrix<double> forest(NUM_NODES, NUM_NODES);
+    BOOST_CHECK_EQUAL(msf(m1, forest), mst(m1, parents));
+    BOOST_CHECK_EQUAL(forest.nvals(), 2*(NUM_NODES - 1));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(msf_test_bad_dimensions)
+{
+    Matrix<double> m1(4, 4);
+    Matrix<double> forest(4, 5);
+    BOOST_CHECK_THROW(msf(m1, forest), DimensionException);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -34,6 +34,8 @@
 
 //#define GRAPHBLAS_LOGGING_LEVEL 2
 
+#include <random>
+
 #include <graphblas/graphblas.hpp>
 
 #define BOOST_TEST_MAIN
@@ -2263,4 +2265,61 @@ BOOST_AUTO_TEST_CASE(test_mxm_CompMask_Accum_ATBT_Merge)
     BOOST_CHECK_EQUAL(result, answer);
 }
 
+//****************************************************************************
+// C += op(A)*op(B) with NoMask must match T = op(A)*op(B); C = C (accum) T
+// for every transpose combination (the accumulate-in-place kernels).
+namespace
+{
+    Matrix<double> random_matrix(IndexType m, IndexType n, double density,
+                                 std::default_random_engine &gen)
+    {
+        std::uniform_real_distribution<double> coin(0., 1.);
+        std::uniform_int_distribution<int>     val(1, 9);
+        IndexArrayType i, j;
+        std::vector<double> v;
+        for (IndexType r = 0; r < m; ++r)
+            for (IndexType c = 0; c < n; ++c)
+                if (coin(gen) < density)
+                {
+                    i.push_back(r); j.push_back(c); v.push_back(val(gen));
+                }
+        Matrix<double> M(m, n);
+        M.build(i, j, v);
+        return M;
+    }
+
+    template <typename AT, typename BT>
+    void check_accum_in_place(Matrix<double> const &C0,
+                              AT const &A, BT const &B)
+    {
+        Matrix<double> expected(C0.nrows(), C0.ncols());
+        Matrix<double> T(C0.nrows(), C0.ncols());
+        mxm(T, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, B);
+        eWiseAdd(expected, NoMask(), NoAccumulate(), Minus<double>(), C0, T);
+
+        Matrix<double> C(C0);
+        mxm(C, NoMask(), Minus<double>(), ArithmeticSemiring<double>(), A, B);
+        BOOST_CHECK_EQUAL(C, expected);
+        BOOST_CHECK_EQUAL(C.nvals(), expected.nvals());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_mxm_NoMask_Accum_in_place_random)
+{
+    std::default_random_engine gen(46);
+    for (int trial = 0; trial < 5; ++trial)
+    {
+        auto A(random_matrix(7, 5, 0.3, gen));
+        auto B(random_matrix(5, 6, 0.3, gen));
+        auto AT(random_matrix(5, 7, 0.3, gen));
+        auto BT(random_matrix(6, 5, 0.3, gen));
+        auto C0(random_matrix(7, 6, 0.3, gen));
+
+        check_accum_in_place(C0, A, B);
+        check_accum_in_place(C0, transpose(AT), B);
+        check_accum_in_place(C0, A, transpose(BT));
+        check_accum_in_place(C0, transpose(AT), transpose(BT));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -779,4 +779,149 @@ BOOST_AUTO_TEST_CASE(mxv_reg)
 }
 
 
+//****************************************************************************
+// The hand-tuned plus-times and min-plus kernels must produce exactly what
+// the generic kernel does for an equivalent user-defined semiring.
+namespace
+{
+    template <typename D, typename AddT, typename MultT>
+    struct UserSemiring
+    {
+        using first_argument_type = D;
+        using second_argument_type = D;
+        using result_type = D;
+
+        D add(D a, D b) const { return AddT()(a, b); }
+        D mult(D a, D b) const { return MultT()(a, b); }
+        D zero() const { return AddT().identity(); }
+    };
+
+    template <typename T, typename SemiringT, typename UserSemiringT>
+    void check_kernels_match_generic(grb::Matrix<T> const &A,
+                                     grb::Vector<T> const &u)
+    {
+        grb::IndexType n(A.nrows());
+        grb::Vector<T> fast(n), generic(n);
+
+        grb::mxv(fast, grb::NoMask(), grb::NoAccumulate(), SemiringT(), A, u);
+        grb::mxv(generic, grb::NoMask(), grb::NoAccumulate(),
+                 UserSemiringT(), A, u);
+        BOOST_CHECK_EQUAL(fast, generic);
+
+        grb::mxv(fast, grb::NoMask(), grb::NoAccumulate(), SemiringT(),
+                 grb::transpose(A), u);
+        grb::mxv(generic, grb::NoMask(), grb::NoAccumulate(),
+                 UserSemiringT(), grb::transpose(A), u);
+        BOOST_CHECK_EQUAL(fast, generic);
+
+        grb::vxm(fast, grb::NoMask(), grb::NoAccumulate(), SemiringT(), u, A);
+        grb::vxm(generic, grb::NoMask(), grb::NoAccumulate(),
+                 UserSemiringT(), u, A);
+        BOOST_CHECK_EQUAL(fast, generic);
+
+        grb::vxm(fast, grb::NoMask(), grb::NoAccumulate(), SemiringT(),
+                 u, grb::transpose(A));
+        grb::vxm(generic, grb::NoMask(), grb::NoAccumulate(),
+                 UserSemiringT(), u, grb::transpose(A));
+        BOOST_CHECK_EQUAL(fast, generic);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mxv_semiring_kernels_match_generic)
+{
+    static_assert(grb::backend::semiring_kernel_v<
+                  grb::ArithmeticSemiring<double>> ==
+                  grb::backend::SemiringKernel::PLUS_TIMES);
+    static_assert(grb::backend::semiring_kernel_v<
+                  grb::MinPlusSemiring<int>> ==
+                  grb::backend::SemiringKernel::MIN_PLUS);
+    static_assert(grb::backend::semiring_kernel_v<
+                  grb::MinPlusSemiring<double>> ==
+                  grb::backend::SemiringKernel::GENERIC);
+    static_assert(grb::backend::semiring_kernel_v<
+                  UserSemiring<double, grb::PlusMonoid<double>,
+                               grb::Times<double>>> ==
+                  grb::backend::SemiringKernel::GENERIC);
+
+    // Rows of every length mod 4, dense and sparse u
+    std::vector<std::vector<int> > a_dense = {{1, 2, 0, 3, 4, 5, 6},
+                                              {0, 0, 0, 0, 0, 0, 0},
+                                              {7, 0, 0, 0, 0, 0, 0},
+                                              {1, 1, 0, 1, 0, 0, 0},
+                                              {2, 3, 4, 5, 6, 7, 8},
+                                              {0, 9, 9, 0, 0, 0, 0},
+                                              {5, 0, 0, 4, 0, 3, 2}};
+    std::vector<int> u_full = {3, 1, 4, 1, 5, 9, 2};
+    std::vector<int> u_sparse = {3, 0, 4, 0, 0, 9, 0};
+
+    grb::Matrix<int> Ai(a_dense, 0);
+    grb::Matrix<double> Ad(Ai.nrows(), Ai.ncols());
+    grb::apply(Ad, grb::NoMask(), grb::NoAccumulate(),
+               grb::Identity<int, double>(), Ai);
+    for (auto const &u_dense : {u_full, u_sparse})
+    {
+        grb::Vector<int> ui(u_dense, 0);
+        grb::Vector<double> ud(std::vector<double>(u_dense.begin(),
+                                                   u_dense.end()), 0.);
+
+        check_kernels_match_generic<
+            double, grb::ArithmeticSemiring<double>,
+            UserSemiring<double, grb::PlusMonoid<double>, grb::Times<double>>>(
+                Ad, ud);
+        check_kernels_match_generic<
+            int, grb::ArithmeticSemiring<int>,
+            UserSemiring<int, grb::PlusMonoid<int>, grb::Times<int>>>(Ai, ui);
+        check_kernels_match_generic<
+            int, grb::MinPlusSemiring<int>,
+            UserSemiring<int, grb::MinMonoid<int>, grb::Plus<int>>>(Ai, ui);
+    }
+}
+
+//****************************************************************************
+// A sparse frontier over a wide matrix stays on the sorted-merge axpy
+// (dense_axpy_pays_off is false); a wider one switches to dense_axpy.
+// Both must agree with the generic kernel.
+BOOST_AUTO_TEST_CASE(mxv_semiring_kernels_sparse_frontier)
+{
+    grb::IndexType const N(256);
+    grb::IndexArrayType i, j;
+    std::vector<int>    v;
+    for (grb::IndexType r = 0; r < N; ++r)
+    {
+        for (grb::IndexType d : {1, 5, 17})
+        {
+            i.push_back(r);
+            j.push_back((r*7 + d) % N);
+            v.push_back(static_cast<int>(1 + (r + d) % 9));
+        }
+    }
+    grb::Matrix<int> A(N, N);
+    A.build(i, j, v);
+
+    grb::Vector<int> u_narrow(N), u_wide(N);
+    u_narrow.setElement(3, 2);
+    u_narrow.setElement(200, 5);
+    for (grb::IndexType r = 0; r < N; r += 4)
+    {
+        u_wide.setElement(r, static_cast<int>(r % 11));
+    }
+
+    BOOST_CHECK(!grb::backend::dense_axpy_pays_off(
+                    get_internal_vector(u_narrow),
+                    get_internal_matrix(A)));
+    BOOST_CHECK(grb::backend::dense_axpy_pays_off(
+                    get_internal_vector(u_wide),
+                    get_internal_matrix(A)));
+
+    for (auto const &u : {u_narrow, u_wide})
+    {
+        check_kernels_match_generic<
+            int, grb::ArithmeticSemiring<int>,
+            UserSemiring<int, grb::PlusMonoid<int>, grb::Times<int>>>(A, u);
+        check_kernels_match_generic<
+            int, grb::MinPlusSemiring<int>,
+            UserSemiring<int, grb::MinMonoid<int>, grb::Plus<int>>>(A, u);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,217 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party Software
+ * subject to its own license:
+ *
+ * 1. Boost Unit Test Framework
+ * (https://www.boost.org/doc/libs/1_45_0/libs/test/doc/html/utf.html)
+ * Copyright 2001 Boost software license, Gennadiy Rozental.
+ *
+ * DM20-0442
+ */
+
+#include <iostream>
+#include <random>
+
+#include <graphblas/graphblas.hpp>
+#include <algorithms/ordering.hpp>
+
+using namespace grb;
+using namespace algorithms;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE ordering_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    // Undirected graph with both directions of every edge stored
+    Matrix<double> undirected(IndexType n,
+                              IndexArrayType const &i,
+                              IndexArrayType const &j)
+    {
+        IndexArrayType rows(i), cols(j);
+        rows.insert(rows.end(), j.begin(), j.end());
+        cols.insert(cols.end(), i.begin(), i.end());
+        Matrix<double> G(n, n);
+        G.build(rows, cols, std::vector<double>(rows.size(), 1.0));
+        return G;
+    }
+
+    IndexType bandwidth(Matrix<double> const &A)
+    {
+        IndexArrayType rows(A.nvals()), cols(A.nvals());
+        std::vector<double> vals(A.nvals());
+        A.extractTuples(rows, cols, vals);
+        IndexType bw(0);
+        for (IndexType ix = 0; ix < rows.size(); ++ix)
+        {
+            bw = std::max(bw, (rows[ix] > cols[ix]) ?
+                          rows[ix] - cols[ix] : cols[ix] - rows[ix]);
+        }
+        return bw;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(permute_matrix_test)
+{
+    std::vector<std::vector<double>> A_dense = {{1, 2, 0, 0},
+                                                {0, 3, 4, 0},
+                                                {5, 0, 0, 6}};
+    Matrix<double> A(A_dense, 0.);
+
+    IndexArrayType row_perm = {2, 0, 1};
+    IndexArrayType col_perm = {3, 1, 0, 2};
+    Matrix<double> C(3, 4);
+    C.setElement(1, 1, 99.);    // replaced
+    permute(C, A, row_perm, col_perm);
+
+    std::vector<std::vector<double>> ans = {{6, 0, 5, 0},
+                                            {0, 2, 1, 0},
+                                            {0, 3, 0, 4}};
+    BOOST_CHECK_EQUAL(C, Matrix<double>(ans, 0.));
+
+    // undo with the inverse permutations
+    Matrix<double> B(3, 4);
+    permute(B, C, invert_permutation(row_perm), invert_permutation(col_perm));
+    BOOST_CHECK_EQUAL(B, A);
+
+    BOOST_CHECK_THROW(permute(C, A, IndexArrayType({0, 1, 1}), col_perm),
+                      InvalidValueException);
+    BOOST_CHECK_THROW(permute(C, A, IndexArrayType({0, 1, 3}), col_perm),
+                      InvalidValueException);
+    BOOST_CHECK_THROW(permute(C, A, col_perm, row_perm),
+                      DimensionException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(permute_vector_test)
+{
+    std::vector<double> u_dense = {1, 0, 3, 4, 0};
+    Vector<double> u(u_dense, 0.);
+    IndexArrayType perm = {4, 3, 2, 0, 1};
+
+    Vector<double> w(5);
+    permute(w, u, perm);
+    std::vector<double> ans = {0, 4, 3, 1, 0};
+    BOOST_CHECK_EQUAL(w, Vector<double>(ans, 0.));
+
+    Vector<double> v(5);
+    permute(v, w, invert_permutation(perm));
+    BOOST_CHECK_EQUAL(v, u);
+
+    Vector<double> bad(4);
+    BOOST_CHECK_THROW(permute(bad, u, perm), DimensionException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(degree_ordering_test)
+{
+    // star on 0 plus the edge 3-4
+    auto G(undirected(5, {0, 0, 0, 3}, {1, 2, 3, 4}));
+
+    IndexArrayType ascending = {1, 2, 4, 3, 0};
+    IndexArrayType descending = {0, 3, 1, 2, 4};
+    auto p(degree_ordering(G));
+    auto q(degree_ordering(G, true));
+    BOOST_CHECK_EQUAL_COLLECTIONS(p.begin(), p.end(),
+                                  ascending.begin(), ascending.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(q.begin(), q.end(),
+                                  descending.begin(), descending.end());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(rcm_ordering_path_test)
+{
+    // the path 3-0-5-1-4-2 with scrambled labels
+    auto G(undirected(6, {3, 0, 5, 1, 4}, {0, 5, 1, 4, 2}));
+    BOOST_CHECK_EQUAL(bandwidth(G), 5);
+
+    auto perm(rcm_ordering(G));
+    IndexArrayType ans = {3, 0, 5, 1, 4, 2};
+    BOOST_CHECK_EQUAL_COLLECTIONS(perm.begin(), perm.end(),
+                                  ans.begin(), ans.end());
+
+    Matrix<double> C(6, 6);
+    permute(C, G, perm, perm);
+    BOOST_CHECK_EQUAL(bandwidth(C), 1);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(rcm_ordering_random_test)
+{
+    // random 2D grid relabeling: RCM recovers a narrow band
+    IndexType const W(8), H(8), N(W*H);
+    IndexArrayType label(N);
+    std::iota(label.begin(), label.end(), 0UL);
+    std::shuffle(label.begin(), label.end(), std::default_random_engine(7));
+
+    IndexArrayType i, j;
+    for (IndexType r = 0; r < H; ++r)
+    {
+        for (IndexType c = 0; c < W; ++c)
+        {
+            if (c + 1 < W) { i.push_back(label[r*W + c]);
+                             j.push_back(label[r*W + c + 1]); }
+            if (r + 1 < H) { i.push_back(label[r*W + c]);
+                             j.push_back(label[(r + 1)*W + c]); }
+        }
+    }
+    auto G(undirected(N, i, j));
+
+    auto perm(rcm_ordering(G));
+    BOOST_CHECK_EQUAL(perm.size(), N);
+    BOOST_CHECK_NO_THROW(invert_permutation(perm));
+
+    Matrix<double> C(N, N);
+    permute(C, G, perm, perm);
+    BOOST_CHECK_EQUAL(C.nvals(), G.nvals());
+    BOOST_CHECK(bandwidth(C) <= 2*W);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(bfs_ordering_test)
+{
+    // tree 0-1, 0-2, 1-3, 2-4 plus the isolated vertex 5
+    auto G(undirected(6, {0, 0, 1, 2}, {1, 2, 3, 4}));
+
+    auto p(bfs_ordering(G));
+    IndexArrayType ans0 = {0, 1, 2, 3, 4, 5};
+    BOOST_CHECK_EQUAL_COLLECTIONS(p.begin(), p.end(),
+                                  ans0.begin(), ans0.end());
+
+    auto q(bfs_ordering(G, 2));
+    IndexArrayType ans2 = {2, 0, 4, 1, 3, 5};
+    BOOST_CHECK_EQUAL_COLLECTIONS(q.begin(), q.end(),
+                                  ans2.begin(), ans2.end());
+
+    BOOST_CHECK_THROW(bfs_ordering(G, 6), IndexOutOfBoundsException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -269,4 +269,47 @@ BOOST_AUTO_TEST_CASE(page_rank_test_karate)
     }
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(page_rank_test_incremental)
+{
+    IndexType const NUM_NODES(9);
+    IndexArrayType i = {0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                        4, 4, 4, 5, 6, 6, 6, 8, 8};
+
+    IndexArrayType j = {3, 3, 6, 4, 5, 6, 8, 0, 1, 4, 6,
+                        2, 3, 8, 2, 1, 2, 3, 2, 4};
+    std::vector<double> v(i.size(), 1.0);
+    Matrix<double> graph(NUM_NODES, NUM_NODES);
+    graph.build(i, j, v);
+
+    Vector<double> rank(NUM_NODES);
+    algorithms::page_rank(graph, rank, 0.85, 1.e-20);
+    Matrix<double> m(NUM_NODES, NUM_NODES);
+    algorithms::page_rank_matrix(graph, m, 0.85);
+
+    // connect the isolated node, drop a couple of edges, empty row 5
+    IndexArrayType      ins_i = {7, 7, 0, 0};
+    IndexArrayType      ins_j = {0, 4, 8, 7};
+    std::vector<double> ins_v(ins_i.size(), 1.0);
+    IndexArrayType      del_i = {2, 5, 6};
+    IndexArrayType      del_j = {8, 2, 1};
+    auto changed = graph.applyUpdates(ins_i, ins_j, ins_v, del_i, del_j);
+
+    algorithms::page_rank_incremental(graph, m, rank, changed,
+                                      0.85, 1.e-12);
+
+    Vector<double> answer(NUM_NODES);
+    algorithms::page_rank(graph, answer, 0.85, 1.e-20);
+    Matrix<double> m_answer(NUM_NODES, NUM_NODES);
+    algorithms::page_rank_matrix(graph, m_answer, 0.85);
+
+    BOOST_CHECK_EQUAL(m, m_answer);
+    BOOST_CHECK_EQUAL(rank.nvals(), NUM_NODES);
+    for (IndexType ix = 0; ix < NUM_NODES; ++ix)
+    {
+        BOOST_CHECK_CLOSE(rank.extractElement(ix),
+                          answer.extractElement(ix), 0.001);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,198 @@
+/*
+ * GraphBLAS Template Library (GBTL), Version 3.0
+ *
+ * Copyright 2020 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS.
+ *
+ * Released under a BSD-style license, please see LICENSE file or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release
+ * and unlimited distribution.  Please see Copyright notice for non-US
+ * Government use and distribution.
+ *
+ * This Software includes and/or makes use of the following Third-Party Software
+ * subject to its own license:
+ *
+ * 1. Boost Unit Test Framework
+ * (https://www.boost.org/doc/libs/1_45_0/libs/test/doc/html/utf.html)
+ * Copyright 2001 Boost software license, Gennadiy Rozental.
+ *
+ * DM20-0442
+ */
+
+#define GRAPHBLAS_LOGGING_LEVEL 0
+
+#include <iostream>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace grb;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE select_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    // | 1 2 - 4 |
+    // | 5 6 7 - |
+    // | - 9 1 2 |
+    // | 3 - 5 6 |
+    std::vector<std::vector<double>> A_dense = {{1, 2, 0, 4},
+                                                {5, 6, 7, 0},
+                                                {0, 9, 1, 2},
+                                                {3, 0, 5, 6}};
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_stdmat_test_bad_dimension)
+{
+    Matrix<double> A(A_dense, 0.);
+    Matrix<double> C(3, 4);
+    BOOST_CHECK_THROW(
+        (select(C, NoMask(), NoAccumulate(), TriL<double>(), A, 0)),
+        DimensionException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_stdmat_test_positional)
+{
+    Matrix<double> A(A_dense, 0.);
+
+    {
+        std::vector<std::vector<double>> ans = {{1, 0, 0, 0},
+                                                {5, 6, 0, 0},
+                                                {0, 9, 1, 0},
+                                                {3, 0, 5, 6}};
+        Matrix<double> C(4, 4);
+        select(C, NoMask(), NoAccumulate(), TriL<double>(), A, 0);
+        BOOST_CHECK_EQUAL(C, Matrix<double>(ans, 0.));
+    }
+    {
+        // strictly lower triangle
+        std::vector<std::vector<double>> ans = {{0, 0, 0, 0},
+                                                {5, 0, 0, 0},
+                                                {0, 9, 0, 0},
+                                                {3, 0, 5, 0}};
+        Matrix<double> C(4, 4);
+        select(C, NoMask(), NoAccumulate(), TriL<double>(), A, -1);
+        BOOST_CHECK_EQUAL(C, Matrix<double>(ans, 0.));
+    }
+    {
+        std::vector<std::vector<double>> ans = {{0, 2, 0, 4},
+                                                {0, 0, 7, 0},
+                                                {0, 0, 0, 2},
+                                                {0, 0, 0, 0}};
+        Matrix<double> C(4, 4);
+        select(C, NoMask(), NoAccumulate(), TriU<double>(), A, 1);
+        BOOST_CHECK_EQUAL(C, Matrix<double>(ans, 0.));
+    }
+    {
+        Matrix<double> D(4, 4), O(4, 4);
+        select(D, NoMask(), NoAccumulate(), Diag<double>(), A, 0);
+        select(O, NoMask(), NoAccumulate(), OffDiag<double>(), A, 0);
+        BOOST_CHECK_EQUAL(D.nvals(), 4);
+        BOOST_CHECK_EQUAL(O.nvals(), A.nvals() - 4);
+        BOOST_CHECK_EQUAL(D.extractElement(2, 2), 1);
+        BOOST_CHECK(!O.hasElement(3, 3));
+    }
+    {
+        Matrix<double> R(4, 4), K(4, 4);
+        select(R, NoMask(), NoAccumulate(), RowGT<double>(), A, 2);
+        select(K, NoMask(), NoAccumulate(), ColLE<double>(), A, 0);
+        BOOST_CHECK_EQUAL(R.nvals(), 3);
+        BOOST_CHECK_EQUAL(K.nvals(), 3);
+        BOOST_CHECK_EQUAL(K.extractElement(3, 0), 3);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_stdmat_test_value_mask_accum)
+{
+    Matrix<double> A(A_dense, 0.);
+
+    {
+        std::vector<std::vector<double>> ans = {{0, 0, 0, 0},
+                                                {5, 6, 7, 0},
+                                                {0, 9, 0, 0},
+                                                {0, 0, 5, 6}};
+        Matrix<double> C(4, 4);
+        select(C, NoMask(), NoAccumulate(), ValueGT<double>(), A, 4.);
+        BOOST_CHECK_EQUAL(C, Matrix<double>(ans, 0.));
+    }
+    {
+        // C<M> += A(A <= 2), with M the upper triangle (replace)
+        std::vector<std::vector<bool>> m_dense = {{1, 1, 1, 1},
+                                                  {0, 1, 1, 1},
+                                                  {0, 0, 1, 1},
+                                                  {0, 0, 0, 1}};
+        Matrix<bool> M(m_dense, false);
+        std::vector<std::vector<double>> c_dense = {{10, 0, 0, 0},
+                                                    {10, 0, 0, 0},
+                                                    {0,  0, 0, 10},
+                                                    {0,  0, 0, 0}};
+        Matrix<double> C(c_dense, 0.);
+        std::vector<std::vector<double>> ans = {{11, 2, 0, 0},
+                                                {0,  0, 0, 0},
+                                                {0,  0, 1, 12},
+                                                {0,  0, 0, 0}};
+        select(C, M, Plus<double>(), ValueLE<double>(), A, 2., REPLACE);
+        BOOST_CHECK_EQUAL(C, Matrix<double>(ans, 0.));
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_stdmat_test_transpose)
+{
+    Matrix<double> A(A_dense, 0.);
+
+    Matrix<double> C(4, 4), AT(4, 4), answer(4, 4);
+    select(C, NoMask(), NoAccumulate(), TriL<double>(), transpose(A), 0);
+
+    transpose(AT, NoMask(), NoAccumulate(), A);
+    select(answer, NoMask(), NoAccumulate(), TriL<double>(), AT, 0);
+    BOOST_CHECK_EQUAL(C, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_stdvec_test)
+{
+    std::vector<double> u_dense = {3, 0, 1, 8, 0, 2};
+    Vector<double> u(u_dense, 0.);
+
+    {
+        std::vector<double> ans = {3, 0, 0, 8, 0, 0};
+        Vector<double> w(6);
+        select(w, NoMask(), NoAccumulate(), ValueGE<double>(), u, 3.);
+        BOOST_CHECK_EQUAL(w, Vector<double>(ans, 0.));
+    }
+    {
+        std::vector<double> ans = {3, 0, 1, 0, 0, 0};
+        Vector<double> w(6);
+        select(w, NoMask(), NoAccumulate(), RowLE<double>(), u, 2);
+        BOOST_CHECK_EQUAL(w, Vector<double>(ans, 0.));
+    }
+
+    Vector<double> w(5);
+    BOOST_CHECK_THROW(
+        (select(w, NoMask(), NoAccumulate(), ValueNE<double>(), u, 0.)),
+        DimensionException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
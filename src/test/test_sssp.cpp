@@ -517,4 +517,63 @@ BOOST_AUTO_TEST_CASE(test_sssp_delta_step_marcin_uint)
     BOOST_CHECK_EQUAL(result10, answer);
 }
 
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_sssp_delta_step_batch_gilbert_double)
+{
+    grb::IndexType const NUM_NODES(7);
+    grb::IndexArrayType i = {0, 0, 1, 1, 2, 3, 3, 4, 5, 6, 6, 6};
+    grb::IndexArrayType j = {1, 3, 4, 6, 5, 0, 2, 5, 2, 2, 3, 4};
+    std::vector<double>       v(i.size(), 1);
+    grb::Matrix<double> G_gilbert(NUM_NODES, NUM_NODES);
+    G_gilbert.build(i, j, v);
+
+    auto G_gilbert_answer(get_gilbert_answer<double>());
+
+    grb::IndexArrayType sources = {0, 1, 2, 3, 4, 5, 6};
+    grb::Matrix<double> paths(NUM_NODES, NUM_NODES);
+
+    // reuse the same split for queries with different source batches
+    DeltaSteppingGraph<grb::Matrix<double>> dsg(G_gilbert, 1.5);
+    sssp_delta_step_batch(dsg, sources, paths);
+    BOOST_CHECK_EQUAL(paths, G_gilbert_answer);
+
+    grb::Vector<double> row_answer(NUM_NODES), result(NUM_NODES);
+    for (grb::IndexType src = 0; src < NUM_NODES; ++src)
+    {
+        grb::extract(row_answer, grb::NoMask(), grb::NoAccumulate(),
+                     grb::transpose(G_gilbert_answer), grb::AllIndices(), src);
+        sssp_delta_step(dsg, src, result);
+        BOOST_CHECK_EQUAL(result, row_answer);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_sssp_delta_step_batch_marcin_uint)
+{
+    grb::IndexType const NUM_NODES(8);
+    grb::IndexArrayType i = {0,0,1,1,1,2,2,3,3,4,4,5,5,5,6,6,7,7};
+    grb::IndexArrayType j = {1,2,0,5,6,0,3,2,4,3,5,1,4,7,1,7,5,6};
+    std::vector<unsigned int> v = {7,1,7,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1};
+    grb::Matrix<unsigned int> G(NUM_NODES, NUM_NODES);
+    G.build(i.begin(), j.begin(), v.begin(), i.size());
+
+    auto answer =
+        grb::scaled_identity<grb::Matrix<unsigned int> >(NUM_NODES, 0);
+    BOOST_CHECK_EQUAL(true, batch_sssp(G, answer));
+
+    grb::IndexArrayType sources = {7, 0, 3};
+    grb::Matrix<unsigned int> expected(sources.size(), NUM_NODES);
+    grb::extract(expected, grb::NoMask(), grb::NoAccumulate(),
+                 answer, sources, grb::AllIndices());
+
+    for (unsigned int delta : {1U, 2U, 7U, 10U})
+    {
+        DeltaSteppingGraph<grb::Matrix<unsigned int>> dsg(G, delta);
+        grb::Matrix<unsigned int> paths(sources.size(), NUM_NODES);
+        sssp_delta_step_batch(dsg, sources, paths);
+        BOOST_CHECK_EQUAL(paths, expected);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
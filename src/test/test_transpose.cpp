@@ -329,4 +329,37 @@ BOOST_AUTO_TEST_CASE(test_transpose_nonsquare_trans)
     }
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_transpose_in_place_and_after_update)
+{
+    std::vector<std::vector<double>> Atmp = {{1, 1, 0, 0},
+                                             {1, 2, 2, 0},
+                                             {0, 2, 3, 3},
+                                             {4, 0, 0, 0}};
+    Matrix<double, DirectedMatrixTag> A(Atmp, 0.0);
+
+    std::vector<std::vector<double>> ans = {{1, 1, 0, 4},
+                                            {1, 2, 2, 0},
+                                            {0, 2, 3, 0},
+                                            {0, 0, 3, 0}};
+    Matrix<double, DirectedMatrixTag> answer(ans, 0.);
+
+    // C aliases A
+    Matrix<double, DirectedMatrixTag> C(A);
+    transpose(C, NoMask(), NoAccumulate(), C);
+    BOOST_CHECK_EQUAL(C, answer);
+
+    // The column counts used to size the result must follow changes to A
+    BOOST_CHECK_EQUAL(A.degreeStats().col_degrees[3], 1);
+    A.setElement(0, 3, 5.);
+    A.removeElement(3, 0);
+    answer.setElement(3, 0, 5.);
+    answer.removeElement(0, 3);
+
+    Matrix<double, DirectedMatrixTag> D(4, 4);
+    transpose(D, NoMask(), NoAccumulate(), A);
+    BOOST_CHECK_EQUAL(D, answer);
+    BOOST_CHECK_EQUAL(D.nvals(), A.nvals());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
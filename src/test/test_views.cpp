@@ -430,4 +430,72 @@ BOOST_AUTO_TEST_CASE(test_mxv_complemented_structure_mask)
     BOOST_CHECK_EQUAL(result, answer);
 }
 
+//****************************************************************************
+// Masks wide enough that some rows are held as packed bitsets and others as
+// column lists: every mask kind, merge and replace, against a reference.
+BOOST_AUTO_TEST_CASE(test_apply_packed_mask_rows)
+{
+    IndexType const NROWS(6), NCOLS(130);
+
+    // row 0 dense, row 1 sparse with a stored false, row 2 empty, row 3
+    // full, row 4 full with stored falses, row 5 dense with stored falses
+    Matrix<bool> mask(NROWS, NCOLS);
+    for (IndexType j = 0; j < NCOLS; j += 3) mask.setElement(0, j, true);
+    mask.setElement(1, 7, true);
+    mask.setElement(1, 64, false);
+    mask.setElement(1, 129, true);
+    for (IndexType j = 0; j < NCOLS; ++j)
+    {
+        mask.setElement(3, j, true);
+        mask.setElement(4, j, (j % 5) != 0);
+        if (j % 2) mask.setElement(5, j, (j % 7) != 0);
+    }
+
+    Matrix<int> A(NROWS, NCOLS), C0(NROWS, NCOLS);
+    for (IndexType i = 0; i < NROWS; ++i)
+    {
+        for (IndexType j = 0; j < NCOLS; ++j)
+        {
+            if ((i + j) % 4 != 0) A.setElement(i, j, static_cast<int>(i*j + 1));
+            if ((i + 2*j) % 3 == 0) C0.setElement(i, j, -1);
+        }
+    }
+
+    auto check = [&](auto const &M, bool structure_flag, bool complement_flag,
+                     OutputControlEnum outp)
+    {
+        Matrix<int> C(C0);
+        apply(C, M, NoAccumulate(), Identity<int>(), A, outp);
+
+        Matrix<int> answer(NROWS, NCOLS);
+        for (IndexType i = 0; i < NROWS; ++i)
+        {
+            for (IndexType j = 0; j < NCOLS; ++j)
+            {
+                bool stored(mask.hasElement(i, j));
+                bool in_mask(stored &&
+                             (structure_flag || mask.extractElement(i, j)));
+                if (in_mask != complement_flag)
+                {
+                    if (A.hasElement(i, j))
+                        answer.setElement(i, j, A.extractElement(i, j));
+                }
+                else if ((outp == MERGE) && C0.hasElement(i, j))
+                {
+                    answer.setElement(i, j, C0.extractElement(i, j));
+                }
+            }
+        }
+        BOOST_CHECK_EQUAL(C, answer);
+    };
+
+    for (OutputControlEnum outp : {MERGE, REPLACE})
+    {
+        check(mask, false, false, outp);
+        check(grb::complement(mask), false, true, outp);
+        check(grb::structure(mask), true, false, outp);
+        check(grb::complement(grb::structure(mask)), true, true, outp);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()